@@ -0,0 +1,204 @@
+/*! \file
+ * \brief Checks that synapses.c follows the rows which spike processing
+ * fetches through the population table lookups it wraps, when a spike has
+ * more than one row.
+ *
+ * \details usage: fetched_rows_check
+ *
+ * synapses.c is built as the static builds with row costs build it,
+ * against the stand-ins for sPyNNaker in stubs/, and included here so that
+ * its DTCM copy of the row costs can be read.  This plays the part of
+ * sPyNNaker's spike_processing.c, which the builds link against the wrapped
+ * lookups: for each spike it looks up the first row of the source, then
+ * the rest with population_table_get_next_address, and starts the DMA of
+ * each row before processing the row fetched before it.  The population
+ * table stand-in gives the sources different numbers of rows, as the master
+ * population table does sources on several entries.
+ *
+ * Every row processed must be credited to the key of its spike in the row
+ * costs, and no fetched row may be left queued.
+ */
+
+#include "../src/neuron/synapses.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N_SOURCES 12
+#define MAX_ROWS_PER_SOURCE 3
+#define N_SPIKES 100
+
+// The hardware and the SDRAM regions the included code touches
+volatile uint32_t tc[16];
+static synapse_row_costs_t row_costs_copy;
+
+// The rows of each source, each a row of fixed synapses only, of a length
+// which depends on the source and the row
+#define ROW_WORDS (3 + MAX_ROWS_PER_SOURCE + N_SOURCES)
+static uint32_t rows[N_SOURCES][MAX_ROWS_PER_SOURCE][ROW_WORDS];
+
+// The population table's state between the lookups of a spike
+static uint32_t looked_up_source;
+static uint32_t next_row;
+
+static inline uint32_t _n_rows(uint32_t source) {
+    return 1 + (source % MAX_ROWS_PER_SOURCE);
+}
+
+bool __real_population_table_get_first_address(
+        spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer) {
+    if (spike >= N_SOURCES) {
+        return false;
+    }
+    looked_up_source = spike;
+    next_row = 1;
+    *row_address = rows[spike][0];
+    *n_bytes_to_transfer = ROW_WORDS * sizeof(uint32_t);
+    return true;
+}
+
+bool __real_population_table_get_next_address(
+        address_t* row_address, size_t* n_bytes_to_transfer) {
+    if (next_row >= _n_rows(looked_up_source)) {
+        return false;
+    }
+    *row_address = rows[looked_up_source][next_row++];
+    *n_bytes_to_transfer = ROW_WORDS * sizeof(uint32_t);
+    return true;
+}
+
+// The rest of the spin1 API and sPyNNaker which the included code links
+// against; the interrupts are only disabled around the ring buffer drain,
+// which the check doesn't reach, nor does it reach the rest
+uint spin1_irq_disable(void) {
+    return 0;
+}
+
+void spin1_mode_restore(uint sr) {
+    use(sr);
+}
+
+void *spin1_malloc(uint bytes) {
+    return malloc(bytes);
+}
+
+address_t data_specification_get_data_address() {
+    return NULL;
+}
+
+address_t data_specification_get_region(
+        uint32_t region, address_t data_address) {
+    use(region);
+    use(data_address);
+    return NULL;
+}
+
+void spike_processing_finish_write(uint32_t process_id) {
+    use(process_id);
+}
+
+bool synapse_dynamics_initialise(
+        address_t address, uint32_t n_neurons,
+        uint32_t *ring_buffer_to_input_buffer_left_shifts) {
+    use(address);
+    use(n_neurons);
+    use(ring_buffer_to_input_buffer_left_shifts);
+    return true;
+}
+
+bool synapse_dynamics_process_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        weight_t *ring_buffers, uint32_t time) {
+    use(plastic_region_address);
+    use(fixed_region_address);
+    use(ring_buffers);
+    use(time);
+    return true;
+}
+
+void synapse_dynamics_process_post_synaptic_event(
+        uint32_t time, index_t neuron_index) {
+    use(time);
+    use(neuron_index);
+}
+
+void synapse_dynamics_process_target_synaptic_event(
+        uint32_t time, index_t neuron_index) {
+    use(time);
+    use(neuron_index);
+}
+
+//! \brief fetches the rows of the spikes as spike processing does, and
+//! processes each once the DMA of the next has started
+//! \param[out] n_rows_fetched the number of rows fetched for each source
+static void _process_spikes(uint32_t *n_rows_fetched) {
+    address_t fetched = NULL;
+    address_t row_address;
+    size_t n_bytes;
+    uint32_t spike_index = 0;
+    while (true) {
+        address_t next = NULL;
+        if (fetched != NULL && __wrap_population_table_get_next_address(
+                &row_address, &n_bytes)) {
+            next = row_address;
+        }
+        while (next == NULL && spike_index < N_SPIKES) {
+            spike_t spike = (spike_index * 7) % (N_SOURCES + 1);
+            spike_index++;
+            if (__wrap_population_table_get_first_address(
+                    spike, &row_address, &n_bytes)) {
+                next = row_address;
+            }
+        }
+        if (fetched != NULL) {
+            synapses_process_synaptic_row(0, fetched, false, 0);
+        }
+        if (next == NULL) {
+            return;
+        }
+        n_rows_fetched[looked_up_source]++;
+        fetched = next;
+    }
+}
+
+int main(void) {
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        for (uint32_t r = 0; r < _n_rows(s); r++) {
+            uint32_t *row = rows[s][r];
+            uint32_t n_synapses = 1 + s + r;
+            row[0] = 0;
+            row[1] = n_synapses;
+            row[2] = 0;
+            for (uint32_t i = 0; i < n_synapses; i++) {
+                row[3 + i] = (1 << (32 - SYNAPSE_WEIGHT_BITS)) | i;
+            }
+        }
+    }
+    row_costs_region = &row_costs_copy;
+
+    uint32_t n_rows_fetched[N_SOURCES] = {0};
+    _process_spikes(n_rows_fetched);
+
+    if (fetched_rows_input != fetched_rows_output) {
+        fprintf(stderr, "fetched rows were left queued\n");
+        return EXIT_FAILURE;
+    }
+    uint32_t n_rows = 0;
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        uint32_t n_rows_credited = 0;
+        for (uint32_t i = 0; i < row_costs.n_hot_rows; i++) {
+            if (row_costs.hot_rows[i].key == s) {
+                n_rows_credited = row_costs.hot_rows[i].n_rows;
+            }
+        }
+        if (n_rows_credited != n_rows_fetched[s]) {
+            fprintf(stderr, "source %u: %u rows fetched, %u credited\n", s,
+                    n_rows_fetched[s], n_rows_credited);
+            return EXIT_FAILURE;
+        }
+        n_rows += n_rows_fetched[s];
+    }
+    printf("%u rows of %u spikes credited to their sources\n", n_rows,
+           N_SPIKES);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*! \file
+ * \brief Host benchmark of the inner loop of fixed synapse processing, as
+ * synapses.c had it (decoding the delay, type and index of each word, and
+ * checking the type name of each synapse for target synapses) and as it has
+ * it now (adding the word to the ring buffer entries of the timestep).
+ *
+ * \details usage: fixed_rows_benchmark [n_rows] [row_length] [n_repeats]
+ *
+ * The rows are random words of the static builds' layout, with 4 delay
+ * bits, 1 type bit and 8 index bits; both loops must leave the same ring
+ * buffers, which is checked.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SYNAPSE_DELAY_BITS 4
+#define SYNAPSE_TYPE_BITS 1
+#define SYNAPSE_INDEX_BITS 8
+#define SYNAPSE_TYPE_COUNT 2
+
+#define SYNAPSE_TYPE_INDEX_BITS (SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS)
+#define SYNAPSE_DELAY_MASK ((1 << SYNAPSE_DELAY_BITS) - 1)
+#define SYNAPSE_TYPE_MASK ((1 << SYNAPSE_TYPE_BITS) - 1)
+#define SYNAPSE_TYPE_INDEX_MASK ((1 << SYNAPSE_TYPE_INDEX_BITS) - 1)
+#define RING_BUFFER_SIZE (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+#define RING_BUFFER_MASK (RING_BUFFER_SIZE - 1)
+
+static uint16_t ring_buffers[RING_BUFFER_SIZE];
+static uint32_t saturation_count;
+static uint32_t target_synapse_types;
+
+// Keeps the type names from being folded away, as they are in a different
+// header from the loop in the applications
+static const char *volatile type_chars[SYNAPSE_TYPE_COUNT] = {"E", "I"};
+
+static inline const char *_type_char(uint32_t type) {
+    return type_chars[type];
+}
+
+static void _decoded(const uint32_t *words, uint32_t n_words, uint32_t time) {
+    for (; n_words > 0; n_words--) {
+        uint32_t synaptic_word = *words++;
+        if (strcmp(_type_char((synaptic_word >> SYNAPSE_INDEX_BITS)
+                              & SYNAPSE_TYPE_MASK), "T") == 0) {
+            continue;
+        }
+        uint32_t delay =
+            (synaptic_word >> SYNAPSE_TYPE_INDEX_BITS) & SYNAPSE_DELAY_MASK;
+        uint32_t combined = synaptic_word & SYNAPSE_TYPE_INDEX_MASK;
+        uint32_t weight = synaptic_word >> 16;
+        uint32_t index = (((delay + time) & SYNAPSE_DELAY_MASK)
+                          << SYNAPSE_TYPE_INDEX_BITS) | combined;
+        uint32_t accumulation = ring_buffers[index] + weight;
+        uint32_t sat_test = accumulation & 0x10000;
+        if (sat_test) {
+            accumulation = sat_test - 1;
+            saturation_count += 1;
+        }
+        ring_buffers[index] = accumulation;
+    }
+}
+
+static void _resolved(const uint32_t *words, uint32_t n_words, uint32_t time,
+                      uint32_t n_spikes) {
+    uint32_t base = time << SYNAPSE_TYPE_INDEX_BITS;
+    for (; n_words > 0; n_words--) {
+        uint32_t synaptic_word = *words++;
+        if (target_synapse_types & (1 << ((synaptic_word >> SYNAPSE_INDEX_BITS)
+                                          & SYNAPSE_TYPE_MASK))) {
+            continue;
+        }
+        uint32_t index = (base + synaptic_word) & RING_BUFFER_MASK;
+        uint32_t accumulation =
+            ring_buffers[index] + ((synaptic_word >> 16) * n_spikes);
+        if (accumulation >> 16) {
+            accumulation = 0x10000 - 1;
+            saturation_count += 1;
+        }
+        ring_buffers[index] = accumulation;
+    }
+}
+
+static double _seconds(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec)
+        + ((end.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t n_rows = (argc > 1)? strtoul(argv[1], NULL, 0) : 1024;
+    uint32_t row_length = (argc > 2)? strtoul(argv[2], NULL, 0) : 100;
+    uint32_t n_repeats = (argc > 3)? strtoul(argv[3], NULL, 0) : 200;
+
+    uint32_t n_words = n_rows * row_length;
+    uint32_t *words = malloc(n_words * sizeof(uint32_t));
+    if (words == NULL) {
+        fprintf(stderr, "can't allocate %u words\n", n_words);
+        return EXIT_FAILURE;
+    }
+    srand(1);
+    for (uint32_t i = 0; i < n_words; i++) {
+        words[i] = ((rand() & 0x3FF) << 16)
+            | (rand() & ((1 << (SYNAPSE_DELAY_BITS
+                                + SYNAPSE_TYPE_INDEX_BITS)) - 1));
+    }
+    for (uint32_t t = 0; t < SYNAPSE_TYPE_COUNT; t++) {
+        if (strcmp(_type_char(t), "T") == 0) {
+            target_synapse_types |= 1 << t;
+        }
+    }
+
+    // Each timestep processes every row, then clears the entries it drains
+    static uint16_t decoded_ring_buffers[RING_BUFFER_SIZE];
+    struct timespec start;
+    double seconds[2];
+    for (uint32_t loop = 0; loop < 2; loop++) {
+        memset(ring_buffers, 0, sizeof(ring_buffers));
+        saturation_count = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint32_t time = 0; time < n_repeats; time++) {
+            for (uint32_t r = 0; r < n_rows; r++) {
+                if (loop == 0) {
+                    _decoded(&words[r * row_length], row_length, time);
+                } else {
+                    _resolved(&words[r * row_length], row_length, time, 1);
+                }
+            }
+            memset(&ring_buffers[(time & SYNAPSE_DELAY_MASK)
+                                 << SYNAPSE_TYPE_INDEX_BITS],
+                   0, sizeof(uint16_t) << SYNAPSE_TYPE_INDEX_BITS);
+        }
+        seconds[loop] = _seconds(&start);
+        if (loop == 0) {
+            memcpy(decoded_ring_buffers, ring_buffers, sizeof(ring_buffers));
+        }
+    }
+
+    if (memcmp(decoded_ring_buffers, ring_buffers, sizeof(ring_buffers))
+            != 0) {
+        fprintf(stderr, "the loops disagree\n");
+        return EXIT_FAILURE;
+    }
+    double n_synapses = (double) n_words * n_repeats;
+    printf("decoded:  %.2f ns per synapse\n", 1e9 * seconds[0] / n_synapses);
+    printf("resolved: %.2f ns per synapse (%.2fx)\n",
+           1e9 * seconds[1] / n_synapses, seconds[0] / seconds[1]);
+    free(words);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,246 @@
+/*! \file
+ * \brief Runs a network on the host, each core as a process running the
+ * host build of its application, for checking and debugging the models
+ * without a SpiNNaker machine.
+ *
+ * \details usage: host_reference [--cpus n] <configuration>
+ *
+ * The configuration, written by
+ * spynnaker_extra_pynn_models/neuron/host_reference.py, has a line for each
+ * core:
+ *
+ *     core <x> <y> <p> <host binary> <memory image>
+ *
+ * followed by a line for each route of spikes between cores, by their
+ * indices in the order they were listed:
+ *
+ *     route <source core> <destination core>
+ *
+ * The cores run on as many CPUs as the host has, or on the first n with
+ * --cpus; the cores keep to the same timesteps and deliver the spikes of
+ * each timestep in the same order however many CPUs they have, so a run
+ * with --cpus 1 is the single-threaded baseline of the same run.
+ */
+
+#define _GNU_SOURCE
+
+#include "host_reference.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CORES 4096
+#define MAX_LINE 4096
+
+typedef struct core_t {
+    char x[16];
+    char y[16];
+    char p[16];
+    char *binary;
+    char *image;
+    pid_t pid;
+} core_t;
+
+static core_t cores[MAX_CORES];
+static uint32_t n_cores;
+
+static bool _read_configuration(const char *filename, host_shared_t *shared) {
+    FILE *f = fopen(filename, "r");
+    if (f == NULL) {
+        fprintf(stderr, "can't open %s: %s\n", filename, strerror(errno));
+        return false;
+    }
+    char line[MAX_LINE];
+    char binary[MAX_LINE];
+    char image[MAX_LINE];
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f) != NULL) {
+        core_t core;
+        uint32_t source, destination;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        } else if (shared == NULL && sscanf(
+                line, "core %15s %15s %15s %4095s %4095s", core.x, core.y,
+                core.p, binary, image) == 5) {
+            if (n_cores == MAX_CORES) {
+                fprintf(stderr, "more than %u cores\n", MAX_CORES);
+                ok = false;
+                continue;
+            }
+            core.binary = strdup(binary);
+            core.image = strdup(image);
+            cores[n_cores++] = core;
+        } else if (sscanf(line, "route %u %u", &source, &destination) == 2) {
+            if (shared == NULL) {
+                continue;
+            }
+            if (source >= n_cores || destination >= n_cores) {
+                fprintf(stderr, "route to or from a missing core: %s", line);
+                ok = false;
+                continue;
+            }
+            host_core_t *routes = &shared->cores[source];
+            if (routes->n_destinations == HOST_MAX_DESTINATIONS) {
+                fprintf(stderr, "core %u has more than %u destinations\n",
+                        source, HOST_MAX_DESTINATIONS);
+                ok = false;
+                continue;
+            }
+            routes->destinations[routes->n_destinations++] = destination;
+        } else if (shared == NULL) {
+            fprintf(stderr, "can't read %s: %s", filename, line);
+            ok = false;
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+static host_shared_t *_create_shared(const char *name) {
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        fprintf(stderr, "can't create %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+    uint32_t size = host_shared_size(n_cores);
+    if (ftruncate(fd, size) < 0) {
+        fprintf(stderr, "can't size %s: %s\n", name, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    host_shared_t *shared = mmap(
+        NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        fprintf(stderr, "can't map %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+    shared->n_cores = n_cores;
+    return shared;
+}
+
+static bool _restrict_cpus(uint32_t n_cpus) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (uint32_t c = 0; c < n_cpus; c++) {
+        CPU_SET(c, &cpus);
+    }
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) < 0) {
+        fprintf(stderr, "can't run on %u CPUs: %s\n", n_cpus,
+                strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+static bool _start_cores(const char *shared_name) {
+    for (uint32_t c = 0; c < n_cores; c++) {
+        core_t *core = &cores[c];
+        char index[16];
+        snprintf(index, sizeof(index), "%u", c);
+        core->pid = fork();
+        if (core->pid < 0) {
+            fprintf(stderr, "can't start core %u: %s\n", c, strerror(errno));
+            return false;
+        }
+        if (core->pid == 0) {
+            execl(core->binary, core->binary, shared_name, index, core->x,
+                  core->y, core->p, core->image, (char *) NULL);
+            fprintf(stderr, "can't run %s: %s\n", core->binary,
+                    strerror(errno));
+            _exit(EXIT_FAILURE);
+        }
+    }
+    return true;
+}
+
+//! \brief waits for every core; if one fails the others can't finish, so
+//! they are stopped
+static bool _wait_for_cores() {
+    bool ok = true;
+    for (uint32_t n_finished = 0; n_finished < n_cores; n_finished++) {
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) {
+            break;
+        }
+        if (ok && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+            for (uint32_t c = 0; c < n_cores; c++) {
+                if (cores[c].pid == pid) {
+                    fprintf(stderr, "core %s,%s,%s (%s) failed\n",
+                            cores[c].x, cores[c].y, cores[c].p,
+                            cores[c].binary);
+                } else {
+                    kill(cores[c].pid, SIGKILL);
+                }
+            }
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t n_cpus = 0;
+    int arg = 1;
+    if (argc == 4 && strcmp(argv[1], "--cpus") == 0) {
+        n_cpus = strtoul(argv[2], NULL, 0);
+        arg = 3;
+    }
+    if (arg != argc - 1) {
+        fprintf(stderr, "usage: %s [--cpus n] configuration\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The routes are read once the shared memory exists
+    if (!_read_configuration(argv[arg], NULL)) {
+        return EXIT_FAILURE;
+    }
+    char shared_name[64];
+    snprintf(shared_name, sizeof(shared_name), "/host_reference.%d",
+             (int) getpid());
+    host_shared_t *shared = _create_shared(shared_name);
+    if (shared == NULL) {
+        return EXIT_FAILURE;
+    }
+    bool ok = _read_configuration(argv[arg], shared);
+    if (ok && n_cpus > 0) {
+        ok = _restrict_cpus(n_cpus);
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (ok) {
+        ok = _start_cores(shared_name) && _wait_for_cores();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    shm_unlink(shared_name);
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    double seconds = (end.tv_sec - start.tv_sec)
+        + ((end.tv_nsec - start.tv_nsec) / 1e9);
+    uint32_t n_dropped = 0;
+    for (uint32_t c = 0; c < n_cores; c++) {
+        n_dropped += shared->cores[c].queue.n_dropped;
+    }
+    printf("%u cores ran %u timesteps in %.3fs (%.1f timesteps/s)",
+           n_cores, shared->n_timesteps, seconds,
+           shared->n_timesteps / seconds);
+    if (n_dropped > 0) {
+        printf("; %u spikes were dropped", n_dropped);
+    }
+    printf("\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/*! \file
+ * \brief Memory shared between the host reference driver and the cores it
+ * runs.
+ *
+ * \details Each core is a process running the same application code as on
+ * SpiNNaker, built for the host against the runtime in host_spin1.c.  The
+ * cores step through timesteps together; in the first phase of each every
+ * core runs its timer callback, appending the spikes it sends to the queue
+ * of each core they are routed to, and in the second every core processes
+ * the spikes in its own queue.  A queue has many writers in the first phase
+ * and its one reader in the second, so it needs no locks, only an atomic
+ * increment to reserve each entry.
+ */
+
+#ifndef _HOST_REFERENCE_H_
+#define _HOST_REFERENCE_H_
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+//! Spikes a core can receive in one timestep; the router would drop more
+#define HOST_QUEUE_KEYS 65536
+
+//! Cores the spikes of one core can be routed to
+#define HOST_MAX_DESTINATIONS 1024
+
+typedef struct host_queue_t {
+    uint32_t n_keys;
+    uint32_t n_dropped;
+    uint32_t keys[HOST_QUEUE_KEYS];
+} host_queue_t;
+
+typedef struct host_core_t {
+    uint32_t n_destinations;
+    uint32_t destinations[HOST_MAX_DESTINATIONS];
+    host_queue_t queue;
+} host_core_t;
+
+typedef struct host_shared_t {
+    uint32_t n_cores;
+
+    // Sense reversing barrier between the phases of each timestep
+    uint32_t barrier_count;
+    uint32_t barrier_sense;
+
+    // Cores which have called spin1_exit, and the timesteps run by the
+    // first of them
+    uint32_t n_exited;
+    uint32_t n_timesteps;
+
+    host_core_t cores[];
+} host_shared_t;
+
+//! \brief gets the size of the shared memory for a number of cores
+static inline uint32_t host_shared_size(uint32_t n_cores) {
+    return sizeof(host_shared_t) + (n_cores * sizeof(host_core_t));
+}
+
+//! \brief waits until every core has reached the barrier
+//! \param[in,out] sense: the core's sense of the barrier, which starts at 0
+static inline void host_barrier(host_shared_t *shared, uint32_t *sense) {
+    uint32_t new_sense = !*sense;
+    *sense = new_sense;
+    if (__atomic_add_fetch(&shared->barrier_count, 1, __ATOMIC_ACQ_REL)
+            == shared->n_cores) {
+        __atomic_store_n(&shared->barrier_count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&shared->barrier_sense, new_sense, __ATOMIC_RELEASE);
+        return;
+    }
+    while (__atomic_load_n(&shared->barrier_sense, __ATOMIC_ACQUIRE)
+            != new_sense) {
+        sched_yield();
+    }
+}
+
+//! \brief sends a spike to the queue of each core its source is routed to
+static inline void host_send(host_shared_t *shared, uint32_t core_index,
+                             uint32_t key) {
+    host_core_t *core = &shared->cores[core_index];
+    for (uint32_t d = 0; d < core->n_destinations; d++) {
+        host_queue_t *queue = &shared->cores[core->destinations[d]].queue;
+        uint32_t index = __atomic_fetch_add(
+            &queue->n_keys, 1, __ATOMIC_RELAXED);
+        if (index < HOST_QUEUE_KEYS) {
+            queue->keys[index] = key;
+        } else {
+            __atomic_fetch_add(&queue->n_dropped, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int _host_compare_keys(const void *a, const void *b) {
+    uint32_t key_a = *(const uint32_t *) a;
+    uint32_t key_b = *(const uint32_t *) b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+//! \brief sorts the spikes sent to a core in the timestep by key, so that
+//! they don't depend on the order in which the cores happened to send them
+//! \return the number of spikes in the queue; the caller empties it once
+//! they are delivered
+static inline uint32_t host_sort_queue(host_queue_t *queue) {
+    uint32_t n_keys = queue->n_keys;
+    if (n_keys > HOST_QUEUE_KEYS) {
+        n_keys = HOST_QUEUE_KEYS;
+    }
+    qsort(queue->keys, n_keys, sizeof(uint32_t), _host_compare_keys);
+    return n_keys;
+}
+
+#endif  // _HOST_REFERENCE_H_
@@ -0,0 +1,425 @@
+/*! \file
+ * \brief Checks that a network run on the host reference engine gives the
+ * same results on one CPU as on many, and times the two.
+ *
+ * \details usage: host_reference_check [n_cores] [n_timesteps] [row_length]
+ *
+ * Each core is a process, exchanging spikes with the others through the
+ * queues and barrier of host_reference.h as the cores of host_reference
+ * do.  The plastic synapses are updated by the target rule's kernel, built
+ * from synapse_dynamics_stdp_target_impl.c and timing_target_pair_impl.c;
+ * every neuron of the network has a row of random synapses on every core,
+ * processed in the timestep the neuron spikes, and each neuron receives
+ * targets, in pairs at the end of each pattern, so that the rule's
+ * accumulators and weights move.  The neurons are integer leaky integrators
+ * driven by noise from a generator seeded per core, standing in for the LIF
+ * model, whose accum arithmetic the host compilers don't support.
+ *
+ * The network is run with every core on the first CPU, the single-threaded
+ * baseline, and then with the cores on every CPU; the spikes, membrane
+ * potentials and synaptic rows of the two runs must be identical.
+ *
+ * Then the rows of a core are given several spikes in a timestep, as spike
+ * coalescing gives them: processing a row once for all of its spikes must
+ * leave the rows and ring buffers as processing it once for each spike.
+ */
+
+#include "host_reference.h"
+#include "host_target_rule.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define NEURONS_PER_CORE (1 << SYNAPSE_INDEX_BITS)
+#define MAX_DELAY 8
+#define RING_BUFFER_SIZE (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+
+// The neurons: the shift of the leak, the threshold and the mask of the
+// noise added each timestep
+#define LEAK_SHIFT 4
+#define THRESHOLD 2200
+#define NOISE_MASK 0xFF
+
+// Each neuron gets a target every TARGET_PERIOD timesteps, and one in the
+// timestep after every PATTERN_PERIOD, which ends the pattern
+#define TARGET_PERIOD 20
+#define PATTERN_PERIOD 100
+
+typedef struct core_results_t {
+    int32_t v[NEURONS_PER_CORE];
+    uint32_t spike_counts[NEURONS_PER_CORE];
+    uint32_t spike_hash;
+} core_results_t;
+
+//! The memory shared by the cores of a run: the engine's, then the results
+//! of each core, then the rows of each core
+typedef struct run_t {
+    host_shared_t *shared;
+    core_results_t *results;
+    uint32_t *rows;
+    size_t bytes;
+} run_t;
+
+static uint32_t n_cores;
+static uint32_t n_timesteps;
+static uint32_t row_words;
+
+static inline uint32_t *_core_rows(run_t *run, uint32_t core) {
+    return &run->rows[core * n_cores * NEURONS_PER_CORE * row_words];
+}
+
+static inline uint32_t _xorshift(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline uint32_t _ring_buffer_index(
+        uint32_t time, uint32_t type, uint32_t neuron) {
+    return synapses_get_ring_buffer_index_combined(
+        time, (type << SYNAPSE_INDEX_BITS) | neuron);
+}
+
+//! \brief updates the neurons of a core at the start of a timestep, sending
+//! their spikes
+static void _update_neurons(
+        run_t *run, uint32_t core, uint32_t time, weight_t *ring_buffers,
+        uint32_t *random) {
+    core_results_t *results = &run->results[core];
+    for (uint32_t n = 0; n < NEURONS_PER_CORE; n++) {
+        uint32_t excitatory = _ring_buffer_index(time, 0, n);
+        uint32_t inhibitory = _ring_buffer_index(time, 1, n);
+        int32_t *v = &results->v[n];
+        *v += (int32_t) ring_buffers[excitatory]
+            - (int32_t) ring_buffers[inhibitory] - (*v >> LEAK_SHIFT)
+            + (int32_t) (_xorshift(random) & NOISE_MASK);
+        ring_buffers[excitatory] = 0;
+        ring_buffers[inhibitory] = 0;
+        if (*v < 0) {
+            *v = 0;
+        }
+        if (*v >= THRESHOLD) {
+            *v = 0;
+            uint32_t key = (core * NEURONS_PER_CORE) + n;
+            host_send(run->shared, core, key);
+            results->spike_counts[n]++;
+            results->spike_hash = (results->spike_hash * 31) ^ key ^ time;
+            synapse_dynamics_process_post_synaptic_event(time, n);
+        }
+        uint32_t phase = time + n;
+        if (phase % TARGET_PERIOD == 0
+                || (phase > 0 && (phase - 1) % PATTERN_PERIOD == 0)) {
+            synapse_dynamics_process_target_synaptic_event(time, n);
+        }
+    }
+}
+
+//! \brief runs a core of the network; the process exits when it is done
+static void _run_core(run_t *run, uint32_t core) {
+    if (!host_target_rule_initialise(NEURONS_PER_CORE)) {
+        _exit(EXIT_FAILURE);
+    }
+    weight_t *ring_buffers = calloc(RING_BUFFER_SIZE, sizeof(weight_t));
+    if (ring_buffers == NULL) {
+        _exit(EXIT_FAILURE);
+    }
+    uint32_t *rows = _core_rows(run, core);
+    host_queue_t *queue = &run->shared->cores[core].queue;
+    uint32_t random = 0x9E3779B9 * (core + 1);
+    uint32_t barrier_sense = 0;
+    for (uint32_t time = 0; time < n_timesteps; time++) {
+        _update_neurons(run, core, time, ring_buffers, &random);
+        host_barrier(run->shared, &barrier_sense);
+
+        uint32_t n_keys = host_sort_queue(queue);
+        for (uint32_t i = 0; i < n_keys; i++) {
+            uint32_t *row = &rows[queue->keys[i] * row_words];
+            synapse_dynamics_process_plastic_synapses(
+                synapse_row_plastic_region(row),
+                synapse_row_fixed_region(row), ring_buffers, time);
+        }
+        queue->n_keys = 0;
+        host_barrier(run->shared, &barrier_sense);
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+static bool _create_run(run_t *run, const uint32_t *rows) {
+    size_t shared_bytes = host_shared_size(n_cores);
+    size_t results_bytes = n_cores * sizeof(core_results_t);
+    size_t rows_bytes = (size_t) n_cores * n_cores * NEURONS_PER_CORE
+        * row_words * sizeof(uint32_t);
+    run->bytes = shared_bytes + results_bytes + rows_bytes;
+    uint8_t *memory = mmap(NULL, run->bytes, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "can't map %zu bytes: %s\n", run->bytes,
+                strerror(errno));
+        return false;
+    }
+    run->shared = (host_shared_t *) memory;
+    run->results = (core_results_t *) &memory[shared_bytes];
+    run->rows = (uint32_t *) &memory[shared_bytes + results_bytes];
+    memcpy(run->rows, rows, rows_bytes);
+
+    // Every core's spikes go to every core
+    run->shared->n_cores = n_cores;
+    for (uint32_t c = 0; c < n_cores; c++) {
+        host_core_t *core = &run->shared->cores[c];
+        core->n_destinations = n_cores;
+        for (uint32_t d = 0; d < n_cores; d++) {
+            core->destinations[d] = d;
+        }
+    }
+    return true;
+}
+
+static bool _set_cpus(cpu_set_t *cpus) {
+    if (sched_setaffinity(0, sizeof(*cpus), cpus) < 0) {
+        fprintf(stderr, "can't set the CPUs: %s\n", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+//! \brief runs the network on a set of CPUs
+//! \return the seconds taken, or a negative number if a core failed
+static double _run(run_t *run, cpu_set_t *cpus) {
+    if (!_set_cpus(cpus)) {
+        return -1.0;
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t c = 0; c < n_cores; c++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "can't start core %u: %s\n", c, strerror(errno));
+            return -1.0;
+        }
+        if (pid == 0) {
+            _run_core(run, c);
+        }
+    }
+    bool ok = true;
+    for (uint32_t c = 0; c < n_cores; c++) {
+        int status;
+        if (wait(&status) < 0 || !WIFEXITED(status)
+                || WEXITSTATUS(status) != 0) {
+            ok = false;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (!ok) {
+        fprintf(stderr, "a core failed\n");
+        return -1.0;
+    }
+    return (end.tv_sec - start.tv_sec)
+        + ((end.tv_nsec - start.tv_nsec) / 1e9);
+}
+
+//! \brief counts the plastic synapses whose weight a run changed
+static uint32_t _count_changed_weights(run_t *run, const uint32_t *rows) {
+    uint32_t n_changed = 0;
+    uint32_t n_rows = n_cores * n_cores * NEURONS_PER_CORE;
+    for (uint32_t r = 0; r < n_rows; r++) {
+        const uint32_t *before = &rows[r * row_words];
+        uint32_t *after = &run->rows[r * row_words];
+        const plastic_synapse_t *before_synapses =
+            (const plastic_synapse_t *) &before[
+                1 + HOST_PRE_EVENT_HISTORY_WORDS];
+        const plastic_synapse_t *after_synapses =
+            (const plastic_synapse_t *) &after[
+                1 + HOST_PRE_EVENT_HISTORY_WORDS];
+        size_t n_synapses = synapse_row_num_plastic_controls(
+            synapse_row_fixed_region(after));
+        for (size_t s = 0; s < n_synapses; s++) {
+            if (before_synapses[s].weight != after_synapses[s].weight) {
+                n_changed++;
+            }
+        }
+    }
+    return n_changed;
+}
+
+//! \brief processes the rows of a core for several spikes at a time, with
+//! targets in between
+//! \param[in,out] rows: the rows of the core
+//! \param[in,out] ring_buffers: the ring buffers of the core
+//! \param[in] all: whether to process a row once for all of its spikes,
+//! rather than once for each
+//! \return the number of spikes processed
+static uint32_t _process_repeated_spikes(
+        uint32_t *rows, weight_t *ring_buffers, bool all) {
+    uint32_t n_spikes_processed = 0;
+    for (uint32_t time = 1; time < n_timesteps; time++) {
+        for (uint32_t n = 0; n < NEURONS_PER_CORE; n++) {
+            if ((time + n) % 7 == 0) {
+                synapse_dynamics_process_target_synaptic_event(time, n);
+            }
+        }
+        for (uint32_t r = 0; r < NEURONS_PER_CORE; r++) {
+            if ((r + time) % 5 != 0) {
+                continue;
+            }
+            uint32_t n_spikes = 1 + ((r + time) % 3);
+            uint32_t *row = &rows[r * row_words];
+            if (all) {
+                synapse_dynamics_process_repeated_plastic_synapses(
+                    synapse_row_plastic_region(row),
+                    synapse_row_fixed_region(row), ring_buffers, time,
+                    n_spikes);
+            } else {
+                for (uint32_t s = 0; s < n_spikes; s++) {
+                    synapse_dynamics_process_plastic_synapses(
+                        synapse_row_plastic_region(row),
+                        synapse_row_fixed_region(row), ring_buffers, time);
+                }
+            }
+            n_spikes_processed += n_spikes;
+        }
+    }
+    return n_spikes_processed;
+}
+
+//! \brief processes the rows of a core for several spikes at a time once
+//! for each spike, and in a core of its own, as the rule keeps state of its
+//! own, once for all of them
+//! \return whether the two agree
+static bool _check_repeated_spikes(const uint32_t *rows) {
+    size_t rows_bytes = NEURONS_PER_CORE * row_words * sizeof(uint32_t);
+    size_t ring_buffers_bytes = RING_BUFFER_SIZE * sizeof(weight_t);
+    uint8_t *memory = mmap(NULL, 2 * (rows_bytes + ring_buffers_bytes),
+                           PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                           -1, 0);
+    if (memory == MAP_FAILED) {
+        fprintf(stderr, "can't map the rows: %s\n", strerror(errno));
+        return false;
+    }
+    uint32_t *each = (uint32_t *) memory;
+    uint32_t *all = (uint32_t *) &memory[rows_bytes];
+    weight_t *each_ring_buffers = (weight_t *) &memory[2 * rows_bytes];
+    weight_t *all_ring_buffers =
+        (weight_t *) &memory[(2 * rows_bytes) + ring_buffers_bytes];
+    memcpy(each, rows, rows_bytes);
+    memcpy(all, rows, rows_bytes);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        fprintf(stderr, "can't start a core: %s\n", strerror(errno));
+        return false;
+    }
+    bool all_spikes = (pid == 0);
+    if (!host_target_rule_initialise(NEURONS_PER_CORE)) {
+        if (all_spikes) {
+            _exit(EXIT_FAILURE);
+        }
+        return false;
+    }
+    uint32_t n_spikes = _process_repeated_spikes(
+        all_spikes? all : each,
+        all_spikes? all_ring_buffers : each_ring_buffers, all_spikes);
+    if (all_spikes) {
+        _exit(EXIT_SUCCESS);
+    }
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)
+            || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "a core failed\n");
+        return false;
+    }
+
+    if (memcmp(each, all, rows_bytes) != 0
+            || memcmp(each_ring_buffers, all_ring_buffers,
+                      ring_buffers_bytes) != 0) {
+        fprintf(stderr, "processing a row once for all of its spikes"
+                " differs from once for each\n");
+        return false;
+    }
+    printf("%u spikes processed once for each and once for all of a row's"
+           " spikes; the rows agree\n", n_spikes);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    n_cores = (argc > 1)? strtoul(argv[1], NULL, 0) : 4;
+    n_timesteps = (argc > 2)? strtoul(argv[2], NULL, 0) : 1000;
+    uint32_t row_length = (argc > 3)? strtoul(argv[3], NULL, 0) : 32;
+    if (n_cores == 0 || n_cores > HOST_MAX_DESTINATIONS) {
+        fprintf(stderr, "between 1 and %u cores\n", HOST_MAX_DESTINATIONS);
+        return EXIT_FAILURE;
+    }
+
+    // The rows of every neuron on every core, the same for both runs
+    row_words = host_separate_row_words(row_length);
+    uint32_t n_rows = n_cores * n_cores * NEURONS_PER_CORE;
+    uint32_t *rows = calloc((size_t) n_rows * row_words, sizeof(uint32_t));
+    if (rows == NULL) {
+        fprintf(stderr, "can't allocate %u rows\n", n_rows);
+        return EXIT_FAILURE;
+    }
+    srand(1);
+    for (uint32_t r = 0; r < n_rows; r++) {
+        host_random_separate_row(&rows[r * row_words], row_length, MAX_DELAY);
+    }
+
+    cpu_set_t all_cpus, first_cpu;
+    if (sched_getaffinity(0, sizeof(all_cpus), &all_cpus) < 0) {
+        fprintf(stderr, "can't get the CPUs: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    CPU_ZERO(&first_cpu);
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &all_cpus)) {
+            CPU_SET(c, &first_cpu);
+            break;
+        }
+    }
+
+    run_t baseline, parallel;
+    if (!_create_run(&baseline, rows) || !_create_run(&parallel, rows)) {
+        return EXIT_FAILURE;
+    }
+    double seconds[2];
+    seconds[0] = _run(&baseline, &first_cpu);
+    seconds[1] = _run(&parallel, &all_cpus);
+    if (seconds[0] < 0.0 || seconds[1] < 0.0) {
+        return EXIT_FAILURE;
+    }
+
+    // The results and rows follow the engine's memory, which differs in
+    // nothing but the queues the runs left behind
+    size_t shared_bytes = host_shared_size(n_cores);
+    if (memcmp(baseline.results, parallel.results,
+               baseline.bytes - shared_bytes) != 0) {
+        fprintf(stderr, "the runs on 1 and %d CPUs disagree\n",
+                CPU_COUNT(&all_cpus));
+        return EXIT_FAILURE;
+    }
+    uint32_t n_spikes = 0;
+    uint32_t n_dropped = 0;
+    for (uint32_t c = 0; c < n_cores; c++) {
+        for (uint32_t n = 0; n < NEURONS_PER_CORE; n++) {
+            n_spikes += parallel.results[c].spike_counts[n];
+        }
+        n_dropped += parallel.shared->cores[c].queue.n_dropped;
+    }
+    printf("%u cores of %u neurons, %u timesteps: %u spikes, %u dropped,"
+           " %u of %u weights changed; the runs agree\n",
+           n_cores, NEURONS_PER_CORE, n_timesteps, n_spikes, n_dropped,
+           _count_changed_weights(&parallel, rows), n_rows * row_length);
+    printf("1 CPU:        %.3fs (%.1f timesteps/s)\n", seconds[0],
+           n_timesteps / seconds[0]);
+    printf("all %d CPUs: %.3fs (%.1f timesteps/s, %.2fx)\n",
+           CPU_COUNT(&all_cpus), seconds[1], n_timesteps / seconds[1],
+           seconds[0] / seconds[1]);
+    return _check_repeated_spikes(rows)? EXIT_SUCCESS : EXIT_FAILURE;
+}
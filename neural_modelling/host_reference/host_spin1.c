@@ -0,0 +1,487 @@
+/*! \file
+ * \brief Runs the code of one core of a neuron application on the host, as
+ * a process started by the host reference driver.
+ *
+ * \details The application is linked unchanged against this in place of
+ * SARK and the spin1 API.  Its SDRAM is the memory image left by executing
+ * its data specification, mapped so that what the core writes, such as
+ * recordings and plastic weights, is left in the image for the host to
+ * read.  Events are run to completion in the order of their priority:
+ *
+ *  - DMA transfers are copied when they are started, and their completion
+ *    is queued;
+ *  - the user event and DMA completions run before scheduled callbacks,
+ *    as they would preempt them on SpiNNaker;
+ *  - each spike received is processed before the next is delivered, and
+ *    the spikes of a timestep are delivered sorted by key, so that a run
+ *    doesn't depend on the order in which the cores happened to send them.
+ *
+ * The timer runs as fast as the cores can go rather than at the timer
+ * period.
+ */
+
+#include "host_reference.h"
+
+#include <spin1_api.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Layout of the memory image of a data specification; the region table
+// follows the magic number and version
+#define DSG_HEADER_WORDS 2
+#define DSG_MAX_REGIONS 16
+#define DSG_MAGIC_NUMBER 0xAD130AD6
+
+#define MAX_SCHEDULED_CALLBACKS 64
+#define MAX_PENDING_DMAS 16
+#define MAX_TAGS 256
+
+typedef struct scheduled_callback_t {
+    callback_t callback;
+    uint arg0;
+    uint arg1;
+    uint priority;
+} scheduled_callback_t;
+
+typedef struct pending_dma_t {
+    uint id;
+    uint tag;
+} pending_dma_t;
+
+// The hardware which the application touches directly
+volatile uint32_t tc[16];
+volatile uint32_t dma[64];
+
+static vcpu_t virtual_processor_info[18];
+vcpu_t *sark_virtual_processor_info = virtual_processor_info;
+
+static sv_t system_variables;
+sv_t *sv = &system_variables;
+
+// The core, and the memory shared with the other cores
+static host_shared_t *shared;
+static uint32_t core_index;
+static uint32_t chip_x;
+static uint32_t chip_y;
+static uint32_t core_id;
+
+// The memory image, and where it was when the region table was written
+static uint32_t *image;
+static size_t image_bytes;
+static uint32_t image_region_table[DSG_MAX_REGIONS];
+
+static callback_t callbacks[NUM_EVENTS];
+static int callback_priorities[NUM_EVENTS];
+
+static scheduled_callback_t scheduled[MAX_SCHEDULED_CALLBACKS];
+static uint32_t n_scheduled;
+
+static pending_dma_t pending_dmas[MAX_PENDING_DMAS];
+static uint32_t pending_dma_output;
+static uint32_t n_pending_dmas;
+static uint next_dma_id = 1;
+
+static bool user_event_pending;
+static uint user_event_args[2];
+
+static void *tagged_blocks[MAX_TAGS];
+
+static uint32_t barrier_sense;
+static bool exited;
+static uint exit_code;
+
+//! \brief writes a message from the host side of the core
+static void _error(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "core %u,%u,%u: ", chip_x, chip_y, core_id);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+//! \brief runs events until none are left
+static void _run_pending() {
+    while (true) {
+        if (user_event_pending) {
+            user_event_pending = false;
+            if (callbacks[USER_EVENT] != NULL) {
+                callbacks[USER_EVENT](user_event_args[0], user_event_args[1]);
+            }
+        } else if (n_pending_dmas > 0) {
+            pending_dma_t done = pending_dmas[pending_dma_output];
+            pending_dma_output = (pending_dma_output + 1) % MAX_PENDING_DMAS;
+            n_pending_dmas--;
+            if (callbacks[DMA_TRANSFER_DONE] != NULL) {
+                callbacks[DMA_TRANSFER_DONE](done.id, done.tag);
+            }
+        } else if (n_scheduled > 0) {
+
+            // The first of the highest priority, i.e. the lowest number
+            uint32_t next = 0;
+            for (uint32_t i = 1; i < n_scheduled; i++) {
+                if (scheduled[i].priority < scheduled[next].priority) {
+                    next = i;
+                }
+            }
+            scheduled_callback_t callback = scheduled[next];
+            memmove(&scheduled[next], &scheduled[next + 1],
+                    (n_scheduled - next - 1) * sizeof(scheduled_callback_t));
+            n_scheduled--;
+            callback.callback(callback.arg0, callback.arg1);
+        } else {
+            return;
+        }
+    }
+}
+
+//! \brief delivers the spikes sent to this core in the timestep
+static void _receive_spikes() {
+    host_queue_t *queue = &shared->cores[core_index].queue;
+    uint32_t n_keys = host_sort_queue(queue);
+    for (uint32_t i = 0; i < n_keys; i++) {
+        if (callbacks[MC_PACKET_RECEIVED] != NULL) {
+            callbacks[MC_PACKET_RECEIVED](queue->keys[i], 0);
+            _run_pending();
+        }
+    }
+    queue->n_keys = 0;
+}
+
+//! \brief moves the region table of the image between where the host wrote
+//! it and where the image is mapped
+//! \param[in] to_host true to put back the addresses the host wrote
+static void _relocate_region_table(bool to_host) {
+    uint32_t *region_table = &image[DSG_HEADER_WORDS];
+    if (to_host) {
+        memcpy(region_table, image_region_table, sizeof(image_region_table));
+        return;
+    }
+
+    // The regions follow the header and table
+    uint32_t host_base = 0xFFFFFFFF;
+    for (uint32_t r = 0; r < DSG_MAX_REGIONS; r++) {
+        if (region_table[r] != 0 && region_table[r] < host_base) {
+            host_base = region_table[r];
+        }
+    }
+    host_base -= (DSG_HEADER_WORDS + DSG_MAX_REGIONS) * sizeof(uint32_t);
+
+    memcpy(image_region_table, region_table, sizeof(image_region_table));
+    for (uint32_t r = 0; r < DSG_MAX_REGIONS; r++) {
+        if (region_table[r] != 0) {
+            region_table[r] =
+                (region_table[r] - host_base) + (uint32_t) image;
+        }
+    }
+}
+
+static bool _map_image(const char *filename) {
+    int fd = open(filename, O_RDWR);
+    if (fd < 0) {
+        _error("can't open %s: %s", filename, strerror(errno));
+        return false;
+    }
+    struct stat stat_buffer;
+    if (fstat(fd, &stat_buffer) < 0) {
+        _error("can't stat %s: %s", filename, strerror(errno));
+        close(fd);
+        return false;
+    }
+    image_bytes = stat_buffer.st_size;
+    image = mmap(NULL, image_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        _error("can't map %s: %s", filename, strerror(errno));
+        return false;
+    }
+    if (image_bytes < (DSG_HEADER_WORDS + DSG_MAX_REGIONS) * sizeof(uint32_t)
+            || image[0] != DSG_MAGIC_NUMBER) {
+        _error("%s is not a data specification image", filename);
+        return false;
+    }
+    _relocate_region_table(false);
+    virtual_processor_info[core_id].user0 = (uint32_t) image;
+    return true;
+}
+
+static bool _attach_shared(const char *name) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        _error("can't open %s: %s", name, strerror(errno));
+        return false;
+    }
+    uint32_t n_cores;
+    if (pread(fd, &n_cores, sizeof(n_cores), 0) != sizeof(n_cores)) {
+        _error("can't read %s", name);
+        close(fd);
+        return false;
+    }
+    shared = mmap(NULL, host_shared_size(n_cores), PROT_READ | PROT_WRITE,
+                  MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        _error("can't map %s: %s", name, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void c_main(void);
+
+//! \brief runs the core
+//!
+//! usage: <application>.host <shared memory> <core index> <x> <y> <p>
+//!     <memory image>
+int main(int argc, char *argv[]) {
+    if (argc != 7) {
+        fprintf(stderr, "usage: %s shared_memory core_index x y p image\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    core_index = strtoul(argv[2], NULL, 0);
+    chip_x = strtoul(argv[3], NULL, 0);
+    chip_y = strtoul(argv[4], NULL, 0);
+    core_id = strtoul(argv[5], NULL, 0);
+    if (core_id >= 18) {
+        _error("no such core");
+        return EXIT_FAILURE;
+    }
+    if (!_attach_shared(argv[1]) || !_map_image(argv[6])) {
+        return EXIT_FAILURE;
+    }
+
+    c_main();
+
+    _relocate_region_table(true);
+    msync(image, image_bytes, MS_SYNC);
+    return (exit_code == 0)? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// spin1 API
+
+void spin1_callback_on(uint event_id, callback_t cback, int priority) {
+    callbacks[event_id] = cback;
+    callback_priorities[event_id] = priority;
+}
+
+void spin1_callback_off(uint event_id) {
+    callbacks[event_id] = NULL;
+}
+
+uint spin1_schedule_callback(callback_t cback, uint arg0, uint arg1,
+                             uint priority) {
+    if (n_scheduled == MAX_SCHEDULED_CALLBACKS) {
+        return FAILURE;
+    }
+    scheduled_callback_t *callback = &scheduled[n_scheduled++];
+    callback->callback = cback;
+    callback->arg0 = arg0;
+    callback->arg1 = arg1;
+    callback->priority = priority;
+    return SUCCESS;
+}
+
+uint spin1_trigger_user_event(uint arg0, uint arg1) {
+    if (user_event_pending) {
+        return FAILURE;
+    }
+    user_event_pending = true;
+    user_event_args[0] = arg0;
+    user_event_args[1] = arg1;
+    return SUCCESS;
+}
+
+uint spin1_dma_transfer(uint tag, void *system_address, void *tcm_address,
+                        uint direction, uint length) {
+    if (n_pending_dmas == MAX_PENDING_DMAS) {
+        return FAILURE;
+    }
+    if (direction == DMA_READ) {
+        memcpy(tcm_address, system_address, length);
+    } else {
+        memcpy(system_address, tcm_address, length);
+    }
+    uint id = next_dma_id++;
+    if (next_dma_id == 0) {
+        next_dma_id = 1;
+    }
+    pending_dma_t *done = &pending_dmas[
+        (pending_dma_output + n_pending_dmas) % MAX_PENDING_DMAS];
+    done->id = id;
+    done->tag = tag;
+    n_pending_dmas++;
+    return id;
+}
+
+void spin1_memcpy(void *dst, void const *src, uint len) {
+    memcpy(dst, src, len);
+}
+
+uint spin1_send_mc_packet(uint key, uint data, uint load) {
+    (void) data;
+    (void) load;
+    host_send(shared, core_index, key);
+    return SUCCESS;
+}
+
+void spin1_set_timer_tick(uint time) {
+    (void) time;
+}
+
+//! \brief runs timesteps in step with the other cores until every core has
+//! exited
+uint spin1_start(sync_bool sync) {
+    (void) sync;
+    bool exit_counted = false;
+    uint timer_count = 0;
+    while (true) {
+
+        // Each core runs its timestep, sending spikes
+        if (!exited && callbacks[TIMER_TICK] != NULL) {
+            spin1_schedule_callback(callbacks[TIMER_TICK], timer_count++, 0,
+                                    callback_priorities[TIMER_TICK]);
+            _run_pending();
+        }
+        host_barrier(shared, &barrier_sense);
+
+        // Each core processes the spikes sent to it
+        if (!exited) {
+            _receive_spikes();
+        } else {
+            shared->cores[core_index].queue.n_keys = 0;
+        }
+        if (exited && !exit_counted) {
+            exit_counted = true;
+            if (__atomic_add_fetch(&shared->n_exited, 1, __ATOMIC_ACQ_REL)
+                    == 1) {
+                shared->n_timesteps = timer_count;
+            }
+        }
+        host_barrier(shared, &barrier_sense);
+
+        if (__atomic_load_n(&shared->n_exited, __ATOMIC_ACQUIRE)
+                == shared->n_cores) {
+            return exit_code;
+        }
+    }
+}
+
+void spin1_exit(uint error) {
+    exited = true;
+    exit_code = error;
+}
+
+uint spin1_irq_disable(void) {
+    return 0;
+}
+
+uint spin1_fiq_disable(void) {
+    return 0;
+}
+
+uint spin1_int_disable(void) {
+    return 0;
+}
+
+void spin1_mode_restore(uint sr) {
+    (void) sr;
+}
+
+void *spin1_malloc(uint bytes) {
+    return malloc(bytes);
+}
+
+void spin1_delay_us(uint n) {
+    (void) n;
+}
+
+uint spin1_get_id(void) {
+    return (spin1_get_chip_id() << 5) | core_id;
+}
+
+uint spin1_get_core_id(void) {
+    return core_id;
+}
+
+uint spin1_get_chip_id(void) {
+    return (chip_x << 8) | chip_y;
+}
+
+void spin1_led_control(uint p) {
+    (void) p;
+}
+
+// SARK
+
+void io_printf(char *stream, char *format, ...) {
+    if (stream == IO_NULL) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    printf("%u,%u,%u: ", chip_x, chip_y, core_id);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void rt_error(uint code, ...) {
+    _error("rt_error %u", code);
+    _relocate_region_table(true);
+    exit(EXIT_FAILURE);
+}
+
+uint sark_app_id(void) {
+    return 16;
+}
+
+uint sark_core_id(void) {
+    return core_id;
+}
+
+uint sark_chip_id(void) {
+    return spin1_get_chip_id();
+}
+
+void sark_cpu_state(uint state) {
+    (void) state;
+}
+
+void *sark_alloc(uint count, uint size) {
+    return malloc(count * size);
+}
+
+void sark_free(void *ptr) {
+    free(ptr);
+}
+
+//! \brief allocates from a heap; tagged blocks only live as long as the
+//! process, so a core never finds a block of an earlier run
+void *sark_xalloc(void *heap, uint size, uint tag, uint flag) {
+    (void) heap;
+    void *block = malloc(size);
+    if (block != NULL && (flag & ALLOC_ID) && tag < MAX_TAGS) {
+        tagged_blocks[tag] = block;
+    }
+    return block;
+}
+
+void sark_xfree(void *heap, void *ptr, uint flag) {
+    (void) heap;
+    (void) flag;
+    free(ptr);
+}
+
+void *sark_tag_ptr(uint tag, uint app_id) {
+    (void) app_id;
+    return (tag < MAX_TAGS)? tagged_blocks[tag] : NULL;
+}
@@ -0,0 +1,100 @@
+/*! \file
+ * \brief Sets up the target rule's plastic kernel for the host checks, as
+ * the parameters written by TargetPairRule and the additive weight
+ * dependence would.
+ *
+ * \details The checks build the kernel, synapse_dynamics_stdp_target_impl.c
+ * and timing_target_pair_impl.c, against the stand-ins for sPyNNaker in
+ * stubs/ with the target builds' row layout, and include this with the same
+ * forced headers; see the Makefile.
+ */
+
+#ifndef _HOST_TARGET_RULE_H_
+#define _HOST_TARGET_RULE_H_
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <neuron/synapses.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include "../src/neuron/plasticity/stdp/synapse_dynamics_repeated_spikes.h"
+
+// Time constants, in timesteps, of the rule's LUTs, which are not shifted
+#define HOST_TAU_PLUS 20.0
+#define HOST_TAU_MINUS 5.0
+#define HOST_LUT_SIZE 256
+
+// Weight bounds and A2+ and A2-, in the weight format, of every type
+#define HOST_MAX_WEIGHT 1023
+#define HOST_A2 64
+
+//! The words of the pre-event history at the start of a plastic region
+#define HOST_PRE_EVENT_HISTORY_WORDS 2
+
+//! The words of the parameters: the consolidation budget, the LUT shifts,
+//! the LUTs and the weight dependence of each type
+#define HOST_PARAMETER_WORDS \
+    (3 + HOST_LUT_SIZE + (4 * SYNAPSE_TYPE_COUNT))
+
+static inline void _host_exp_lut(int16_t *lut, double tau) {
+    for (uint32_t i = 0; i < HOST_LUT_SIZE; i++) {
+        lut[i] = (int16_t) floor(
+            (exp(-(double) i / tau) * STDP_FIXED_POINT_ONE) + 0.5);
+    }
+}
+
+//! \brief initialises the kernel for a core
+//! \return false if the kernel couldn't be initialised
+static inline bool host_target_rule_initialise(uint32_t n_neurons) {
+    static uint32_t parameters[HOST_PARAMETER_WORDS];
+    parameters[0] = 0;
+    parameters[1] = 0;
+    parameters[2] = 0;
+    _host_exp_lut((int16_t *) &parameters[3], HOST_TAU_PLUS);
+    _host_exp_lut((int16_t *) &parameters[3 + (HOST_LUT_SIZE / 2)],
+                  HOST_TAU_MINUS);
+    int32_t *weight_parameters = (int32_t *) &parameters[3 + HOST_LUT_SIZE];
+    for (uint32_t s = 0; s < SYNAPSE_TYPE_COUNT; s++) {
+        *weight_parameters++ = 0;
+        *weight_parameters++ = HOST_MAX_WEIGHT;
+        *weight_parameters++ = HOST_A2;
+        *weight_parameters++ = HOST_A2;
+    }
+    uint32_t shifts[SYNAPSE_TYPE_COUNT] = {0};
+    return synapse_dynamics_initialise(parameters, n_neurons, shifts);
+}
+
+//! \brief gets the words of a row of the default layout, with its control
+//! words in the fixed region
+static inline uint32_t host_separate_row_words(uint32_t n_synapses) {
+    return 1 + HOST_PRE_EVENT_HISTORY_WORDS
+        + (((n_synapses * sizeof(plastic_synapse_t)) + 3) / sizeof(uint32_t))
+        + 2 + (((n_synapses * sizeof(control_t)) + 3) / sizeof(uint32_t));
+}
+
+//! \brief writes a row of the default layout, with random control words of
+//! the excitatory and inhibitory types and random weights
+//! \param[in] max_delay: the longest delay, of at least 1 timestep
+static inline void host_random_separate_row(
+        uint32_t *row, uint32_t n_synapses, uint32_t max_delay) {
+    uint32_t plastic_words = HOST_PRE_EVENT_HISTORY_WORDS
+        + (((n_synapses * sizeof(plastic_synapse_t)) + 3)
+           / sizeof(uint32_t));
+    row[0] = plastic_words;
+    address_t fixed_region = synapse_row_fixed_region(row);
+    fixed_region[0] = 0;
+    fixed_region[1] = n_synapses;
+    plastic_synapse_t *synapses = (plastic_synapse_t *)
+        &synapse_row_plastic_region(row)[HOST_PRE_EVENT_HISTORY_WORDS];
+    control_t *controls = synapse_row_plastic_controls(fixed_region);
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        uint32_t delay = 1 + (rand() % max_delay);
+        controls[i] = (delay << SYNAPSE_TYPE_INDEX_BITS)
+            | ((rand() & 1) << SYNAPSE_INDEX_BITS)
+            | (rand() & SYNAPSE_INDEX_MASK);
+        synapses[i] = (plastic_synapse_t) {
+            .weight = rand() & 0x1F, .accumulator = 0, .accumLast = 0};
+    }
+}
+
+#endif  // _HOST_TARGET_RULE_H_
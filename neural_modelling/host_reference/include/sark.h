@@ -0,0 +1,68 @@
+/*! \file
+ * \brief Host stand-in for the parts of SARK used by the neuron
+ * applications; see host_spin1.c.
+ */
+
+#ifndef _SARK_H_
+#define _SARK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "spinnaker.h"
+
+typedef unsigned int uint;
+typedef unsigned short ushort;
+typedef unsigned char uchar;
+
+// Streams of io_printf
+#define IO_STD ((char *) 0)
+#define IO_DBG ((char *) 1)
+#define IO_BUF ((char *) 2)
+#define IO_NULL ((char *) 3)
+
+// Flags of sark_xalloc
+#define ALLOC_LOCK 1
+#define ALLOC_ID 2
+
+// Error codes of rt_error
+#define RTE_NONE 0
+#define RTE_SWERR 16
+#define RTE_MALLOC 18
+
+// States of sark_cpu_state
+#define CPU_STATE_RUN 5
+#define CPU_STATE_EXIT 11
+
+//! The virtual processor information of a core; user0 holds the address of
+//! its data specification
+typedef struct vcpu_t {
+    uint32_t user0;
+    uint32_t user1;
+    uint32_t user2;
+    uint32_t user3;
+} vcpu_t;
+
+typedef struct sv_t {
+    void *sdram_heap;
+    void *sysram_heap;
+} sv_t;
+
+extern vcpu_t *sark_virtual_processor_info;
+extern sv_t *sv;
+
+void io_printf(char *stream, char *format, ...);
+void rt_error(uint code, ...);
+
+uint sark_app_id(void);
+uint sark_core_id(void);
+uint sark_chip_id(void);
+void sark_cpu_state(uint state);
+void *sark_alloc(uint count, uint size);
+void sark_free(void *ptr);
+void *sark_xalloc(void *heap, uint size, uint tag, uint flag);
+void sark_xfree(void *heap, void *ptr, uint flag);
+void *sark_tag_ptr(uint tag, uint app_id);
+
+#endif  // _SARK_H_
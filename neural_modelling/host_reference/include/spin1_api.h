@@ -0,0 +1,70 @@
+/*! \file
+ * \brief Host stand-in for the spin1 API used by the neuron applications;
+ * see host_spin1.c for how the events are run.
+ */
+
+#ifndef _SPIN1_API_H_
+#define _SPIN1_API_H_
+
+#include "sark.h"
+
+// Events
+#define MC_PACKET_RECEIVED 0
+#define DMA_TRANSFER_DONE 1
+#define TIMER_TICK 2
+#define SDP_PACKET_RX 3
+#define USER_EVENT 4
+#define MCPL_PACKET_RECEIVED 5
+#define NUM_EVENTS 6
+
+// Results
+#define FAILURE 0
+#define SUCCESS 1
+
+#define FALSE 0
+#define TRUE 1
+
+// Multicast payloads
+#define NO_PAYLOAD 0
+#define WITH_PAYLOAD 1
+
+// DMA directions
+#define DMA_READ 0
+#define DMA_WRITE 1
+
+// Start synchronisation
+#define SYNC_NOWAIT 0
+#define SYNC_WAIT 1
+
+typedef uint sync_bool;
+typedef void (*callback_t)(uint, uint);
+
+void spin1_callback_on(uint event_id, callback_t cback, int priority);
+void spin1_callback_off(uint event_id);
+uint spin1_schedule_callback(callback_t cback, uint arg0, uint arg1,
+                             uint priority);
+uint spin1_trigger_user_event(uint arg0, uint arg1);
+
+uint spin1_dma_transfer(uint tag, void *system_address, void *tcm_address,
+                        uint direction, uint length);
+void spin1_memcpy(void *dst, void const *src, uint len);
+
+uint spin1_send_mc_packet(uint key, uint data, uint load);
+
+void spin1_set_timer_tick(uint time);
+uint spin1_start(sync_bool sync);
+void spin1_exit(uint error);
+
+uint spin1_irq_disable(void);
+uint spin1_fiq_disable(void);
+uint spin1_int_disable(void);
+void spin1_mode_restore(uint sr);
+
+void *spin1_malloc(uint bytes);
+void spin1_delay_us(uint n);
+uint spin1_get_id(void);
+uint spin1_get_core_id(void);
+uint spin1_get_chip_id(void);
+void spin1_led_control(uint p);
+
+#endif  // _SPIN1_API_H_
@@ -0,0 +1,34 @@
+/*! \file
+ * \brief Host stand-in for the SpiNNaker hardware definitions used by the
+ * neuron applications.
+ *
+ * \details The timer and DMA controller registers are plain memory; the
+ * timer never counts, so the cycle counts in provenance and row costs are
+ * zero, and the DMA controller is never busy, as host_spin1.c finishes each
+ * transfer as it is started.
+ */
+
+#ifndef _SPINNAKER_H_
+#define _SPINNAKER_H_
+
+#include <stdint.h>
+
+// Timer registers, as word offsets
+#define T1_LOAD 0
+#define T1_COUNT 1
+#define T1_CONTROL 2
+#define T2_LOAD 8
+#define T2_COUNT 9
+#define T2_CONTROL 10
+
+// DMA controller registers, as word offsets
+#define DMA_ADRS 0
+#define DMA_ADRT 1
+#define DMA_DESC 2
+#define DMA_CTRL 3
+#define DMA_STAT 4
+
+extern volatile uint32_t tc[16];
+extern volatile uint32_t dma[64];
+
+#endif  // _SPINNAKER_H_
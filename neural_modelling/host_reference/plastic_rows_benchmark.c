@@ -0,0 +1,119 @@
+/*! \file
+ * \brief Host benchmark of the plastic synapse loop of the target rule,
+ * synapse_dynamics_process_plastic_synapses, with the rows laid out as the
+ * target builds read them: the control words at the end of the fixed region
+ * and the plastic synapses after the pre-event history.
+ *
+ * \details usage: plastic_rows_benchmark [n_rows] [row_length] [n_repeats]
+ *
+ * The kernel is built from synapse_dynamics_stdp_target_impl.c and
+ * timing_target_pair_impl.c as the target builds configure them, against
+ * the stand-ins for sPyNNaker in stubs/; see host_target_rule.h.  The rows
+ * hold random synapses.  Each timestep every row is processed, then the
+ * ring buffer entries of the timestep are drained, and the neurons get
+ * post-synaptic and target events so that the windows the rule walks are
+ * not empty.
+ */
+
+#include "host_target_rule.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define N_NEURONS (1 << SYNAPSE_INDEX_BITS)
+#define MAX_DELAY 8
+#define RING_BUFFER_SIZE (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+#define RING_BUFFER_SLOT (1 << SYNAPSE_TYPE_INDEX_BITS)
+
+// Each neuron spikes every POST_PERIOD timesteps and gets a target every
+// TARGET_PERIOD
+#define POST_PERIOD 7
+#define TARGET_PERIOD 20
+
+static uint32_t n_rows;
+static uint32_t n_repeats;
+
+static double _seconds(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec)
+        + ((end.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+//! \brief runs the rows
+//! \return the time the loop took, or a negative number if the kernel
+//! couldn't be initialised
+static double _run(uint32_t *rows, uint32_t row_words) {
+    static weight_t ring_buffers[RING_BUFFER_SIZE];
+    if (!host_target_rule_initialise(N_NEURONS)) {
+        return -1.0;
+    }
+    double seconds = 0.0;
+    struct timespec start;
+    for (uint32_t time = 0; time < n_repeats; time++) {
+        for (uint32_t n = 0; n < N_NEURONS; n++) {
+            if ((time + n) % POST_PERIOD == 0) {
+                synapse_dynamics_process_post_synaptic_event(time, n);
+            }
+            if ((time + n) % TARGET_PERIOD == 0) {
+                synapse_dynamics_process_target_synaptic_event(time, n);
+            }
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint32_t r = 0; r < n_rows; r++) {
+            uint32_t *row = &rows[r * row_words];
+            synapse_dynamics_process_plastic_synapses(
+                synapse_row_plastic_region(row),
+                synapse_row_fixed_region(row), ring_buffers, time);
+        }
+        seconds += _seconds(&start);
+
+        memset(&ring_buffers[synapses_get_ring_buffer_index_combined(time, 0)],
+               0, RING_BUFFER_SLOT * sizeof(weight_t));
+    }
+    return seconds;
+}
+
+int main(int argc, char *argv[]) {
+    n_rows = (argc > 1)? strtoul(argv[1], NULL, 0) : 1024;
+    uint32_t row_length = (argc > 2)? strtoul(argv[2], NULL, 0) : 100;
+    n_repeats = (argc > 3)? strtoul(argv[3], NULL, 0) : 200;
+
+    uint32_t row_words = host_separate_row_words(row_length);
+    uint32_t *rows = calloc((size_t) n_rows * row_words, sizeof(uint32_t));
+    if (rows == NULL) {
+        fprintf(stderr, "can't allocate %u words\n", n_rows * row_words);
+        return EXIT_FAILURE;
+    }
+    srand(1);
+    for (uint32_t r = 0; r < n_rows; r++) {
+        host_random_separate_row(&rows[r * row_words], row_length, MAX_DELAY);
+    }
+
+    double seconds = _run(rows, row_words);
+    if (seconds < 0.0) {
+        fprintf(stderr, "the kernel failed\n");
+        return EXIT_FAILURE;
+    }
+
+    uint32_t n_changed = 0;
+    for (uint32_t r = 0; r < n_rows; r++) {
+        const plastic_synapse_t *plastic = (const plastic_synapse_t *)
+            &rows[(r * row_words) + 1 + HOST_PRE_EVENT_HISTORY_WORDS];
+        for (uint32_t i = 0; i < row_length; i++) {
+            if (plastic[i].accumulator != 0 || plastic[i].accumLast != 0) {
+                n_changed++;
+            }
+        }
+    }
+
+    double n_synapses = (double) n_rows * row_length * n_repeats;
+    printf("%u of %u synapses updated by the rule\n", n_changed,
+           n_rows * row_length);
+    printf("%.2f ns per synapse (%u words per row)\n",
+           1e9 * seconds / n_synapses, row_words);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,18 @@
+/*! \file
+ * \brief Host stand-in for spinn_common's common-typedefs.h, for the
+ * kernels built by the host reference checks.
+ */
+
+#ifndef _COMMON_TYPEDEFS_H_
+#define _COMMON_TYPEDEFS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t *address_t;
+
+//! Marks a value as used, where an implementation doesn't need it
+#define use(x) do {} while ((x) != (x))
+
+#endif  // _COMMON_TYPEDEFS_H_
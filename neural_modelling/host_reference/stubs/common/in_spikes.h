@@ -0,0 +1,15 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's common/in_spikes.h, the queue of
+ * spikes received and waiting for their rows to be fetched.
+ */
+
+#ifndef _IN_SPIKES_H_
+#define _IN_SPIKES_H_
+
+#include "neuron-typedefs.h"
+
+uint32_t in_spikes_size();
+
+bool in_spikes_get_next_spike(spike_t *spike);
+
+#endif  // _IN_SPIKES_H_
@@ -0,0 +1,17 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's common/neuron-typedefs.h.
+ *
+ * \details The host compilers have no ISO fixed point types, so input_t is
+ * a plain word; the plastic kernels only ever return it as zero.
+ */
+
+#ifndef _NEURON_TYPEDEFS_H_
+#define _NEURON_TYPEDEFS_H_
+
+#include <common-typedefs.h>
+
+typedef uint32_t index_t;
+typedef uint32_t spike_t;
+typedef int32_t input_t;
+
+#endif  // _NEURON_TYPEDEFS_H_
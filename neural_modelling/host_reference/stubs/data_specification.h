@@ -0,0 +1,15 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's data_specification.h.
+ */
+
+#ifndef _DATA_SPECIFICATION_H_
+#define _DATA_SPECIFICATION_H_
+
+#include <common-typedefs.h>
+
+address_t data_specification_get_data_address();
+
+address_t data_specification_get_region(
+    uint32_t region, address_t data_address);
+
+#endif  // _DATA_SPECIFICATION_H_
@@ -0,0 +1,38 @@
+/*! \file
+ * \brief Host stand-in for spinn_common's debug.h; messages go to stderr.
+ *
+ * \details Messages below LOG_LEVEL are compiled out, but their arguments
+ * are still checked against their formats.
+ */
+
+#ifndef _DEBUG_H_
+#define _DEBUG_H_
+
+#include <stdio.h>
+
+#define LOG_ERROR 10
+#define LOG_WARNING 20
+#define LOG_INFO 30
+#define LOG_DEBUG 40
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_INFO
+#endif
+
+#define _log(level, message, ...) \
+    do { \
+        if (LOG_LEVEL >= (level)) { \
+            fprintf(stderr, message "\n", ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define log_error(message, ...) \
+    _log(LOG_ERROR, "[ERROR] " message, ##__VA_ARGS__)
+#define log_warning(message, ...) \
+    _log(LOG_WARNING, "[WARNING] " message, ##__VA_ARGS__)
+#define log_info(message, ...) \
+    _log(LOG_INFO, "[INFO] " message, ##__VA_ARGS__)
+#define log_debug(message, ...) \
+    _log(LOG_DEBUG, "[DEBUG] " message, ##__VA_ARGS__)
+
+#endif  // _DEBUG_H_
@@ -0,0 +1,39 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's plasticity/common/maths.h.
+ */
+
+#ifndef _MATHS_H_
+#define _MATHS_H_
+
+#include <string.h>
+
+#include <common-typedefs.h>
+
+#define MIN(X, Y) (((X) < (Y))? (X) : (Y))
+#define MAX(X, Y) (((X) > (Y))? (X) : (Y))
+
+//! \brief multiplies the bottom 16 bits of two words, as the ARM's smulbb
+static inline int32_t __smulbb(int32_t a, int32_t b) {
+    return (int32_t) (int16_t) a * (int32_t) (int16_t) b;
+}
+
+static inline int32_t maths_lut_exponential_decay(
+        uint32_t time, const uint32_t time_shift, const uint32_t lut_size,
+        const int16_t *lut) {
+    uint32_t lut_index = time >> time_shift;
+    return (lut_index < lut_size)? lut[lut_index] : 0;
+}
+
+static inline address_t maths_copy_int16_lut(
+        address_t start_address, uint32_t num_entries, int16_t *lut) {
+    const uint32_t num_words = num_entries / 2;
+    memcpy(lut, start_address, sizeof(int16_t) * num_entries);
+    return start_address + num_words;
+}
+
+static inline int32_t maths_fixed_mul16(
+        int32_t a, int32_t b, const int32_t fixed_point_position) {
+    return __smulbb(a, b) >> fixed_point_position;
+}
+
+#endif  // _MATHS_H_
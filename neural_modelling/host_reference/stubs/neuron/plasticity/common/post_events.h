@@ -0,0 +1,114 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's plasticity/common/post_events.h: the
+ * recent post-synaptic events of each neuron.
+ *
+ * \details The first entry of a history is an event at time 0 with the
+ * rule's initial trace, and the oldest event is dropped to make way for a
+ * new one; dtcm_budget.py reserves room for MAX_POST_SYNAPTIC_EVENTS.
+ */
+
+#ifndef _POST_EVENTS_H_
+#define _POST_EVENTS_H_
+
+#include <stdlib.h>
+
+#include <debug.h>
+#include "../../../common/neuron-typedefs.h"
+
+#define MAX_POST_SYNAPTIC_EVENTS 4
+
+typedef struct {
+    uint32_t count_minus_one;
+    uint32_t times[MAX_POST_SYNAPTIC_EVENTS];
+    post_trace_t traces[MAX_POST_SYNAPTIC_EVENTS];
+} post_event_history_t;
+
+//! The events of a history after the start of a window and up to its end,
+//! and the last event before them
+typedef struct {
+    post_trace_t prev_trace;
+    uint32_t prev_time;
+    const post_trace_t *next_trace;
+    const uint32_t *next_time;
+    uint32_t num_events;
+} post_event_window_t;
+
+static inline post_event_history_t *post_events_init_buffers(
+        uint32_t n_neurons) {
+    post_event_history_t *post_event_history = (post_event_history_t *)
+        malloc(n_neurons * sizeof(post_event_history_t));
+    if (post_event_history == NULL) {
+        log_error("Unable to allocate global STDP structures - Out of DTCM");
+        return NULL;
+    }
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        post_event_history[n].times[0] = 0;
+        post_event_history[n].traces[0] = timing_get_initial_post_trace();
+        post_event_history[n].count_minus_one = 0;
+    }
+    return post_event_history;
+}
+
+//! \brief gets the window of the events after begin_time and up to
+//! end_time
+static inline post_event_window_t post_events_get_window_delayed(
+        const post_event_history_t *events, uint32_t begin_time,
+        uint32_t end_time) {
+
+    // The events after the end of the window, then those in it, are walked
+    // back from the newest
+    const uint32_t *end_event_time =
+        &events->times[events->count_minus_one + 1];
+    const uint32_t *event_time = end_event_time;
+    const post_trace_t *event_trace =
+        &events->traces[events->count_minus_one + 1];
+    post_event_window_t window;
+    do {
+        event_time--;
+        event_trace--;
+        if (*event_time > end_time) {
+            end_event_time = event_time;
+        }
+    } while (*event_time > begin_time && event_time != events->times);
+
+    window.prev_time = *event_time;
+    window.prev_trace = *event_trace;
+    window.next_time = event_time + 1;
+    window.next_trace = event_trace + 1;
+    if (*event_time > begin_time) {
+
+        // Every event is in or after the window
+        window.next_time = event_time;
+        window.next_trace = event_trace;
+    }
+    window.num_events = (end_event_time > window.next_time)?
+        (uint32_t) (end_event_time - window.next_time) : 0;
+    return window;
+}
+
+static inline post_event_window_t post_events_next_delayed(
+        post_event_window_t window, uint32_t delayed_time) {
+    window.prev_time = delayed_time;
+    window.prev_trace = *window.next_trace++;
+    window.next_time++;
+    window.num_events--;
+    return window;
+}
+
+static inline void post_events_add(
+        uint32_t time, post_event_history_t *events, post_trace_t trace) {
+    if (events->count_minus_one < (MAX_POST_SYNAPTIC_EVENTS - 1)) {
+        const uint32_t new_index = ++events->count_minus_one;
+        events->times[new_index] = time;
+        events->traces[new_index] = trace;
+    } else {
+        for (uint32_t i = 1; i < MAX_POST_SYNAPTIC_EVENTS; i++) {
+            events->times[i - 1] = events->times[i];
+            events->traces[i - 1] = events->traces[i];
+        }
+        events->times[MAX_POST_SYNAPTIC_EVENTS - 1] = time;
+        events->traces[MAX_POST_SYNAPTIC_EVENTS - 1] = trace;
+    }
+}
+
+#endif  // _POST_EVENTS_H_
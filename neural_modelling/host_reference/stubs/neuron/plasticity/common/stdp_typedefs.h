@@ -0,0 +1,16 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's plasticity/common/stdp_typedefs.h.
+ */
+
+#ifndef _STDP_TYPEDEFS_H_
+#define _STDP_TYPEDEFS_H_
+
+#include "maths.h"
+
+// The fixed point format of the STDP rules' LUTs and parameters
+#define STDP_FIXED_POINT 11
+#define STDP_FIXED_POINT_ONE (1 << STDP_FIXED_POINT)
+
+#define STDP_FIXED_MUL_16X16(a, b) maths_fixed_mul16(a, b, STDP_FIXED_POINT)
+
+#endif  // _STDP_TYPEDEFS_H_
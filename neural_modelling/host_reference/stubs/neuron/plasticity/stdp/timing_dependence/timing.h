@@ -0,0 +1,13 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's timing_dependence/timing.h; the
+ * rule's own header, forced into the kernel's build, declares the rest.
+ */
+
+#ifndef _TIMING_H_
+#define _TIMING_H_
+
+#include "../../../../common/neuron-typedefs.h"
+
+address_t timing_initialise(address_t address);
+
+#endif  // _TIMING_H_
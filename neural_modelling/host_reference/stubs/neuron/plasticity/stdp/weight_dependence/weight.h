@@ -0,0 +1,14 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's weight_dependence/weight.h.
+ */
+
+#ifndef _WEIGHT_H_
+#define _WEIGHT_H_
+
+#include "../../../../common/neuron-typedefs.h"
+#include "../../../synapse_row.h"
+
+address_t weight_initialise(address_t address,
+                            uint32_t *ring_buffer_to_input_buffer_left_shifts);
+
+#endif  // _WEIGHT_H_
@@ -0,0 +1,30 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's additive one term weight dependence;
+ * see weight_additive_one_term_impl.h.
+ */
+
+#include "weight_additive_one_term_impl.h"
+
+#include <debug.h>
+
+plasticity_weight_region_data_t
+    plasticity_weight_region_data[SYNAPSE_TYPE_COUNT];
+
+address_t weight_initialise(address_t address,
+                            uint32_t *ring_buffer_to_input_buffer_left_shifts) {
+    use(ring_buffer_to_input_buffer_left_shifts);
+
+    int32_t *plasticity_word = (int32_t *) address;
+    for (uint32_t s = 0; s < SYNAPSE_TYPE_COUNT; s++) {
+        plasticity_weight_region_data[s].min_weight = *plasticity_word++;
+        plasticity_weight_region_data[s].max_weight = *plasticity_word++;
+        plasticity_weight_region_data[s].a2_plus = *plasticity_word++;
+        plasticity_weight_region_data[s].a2_minus = *plasticity_word++;
+        log_info("\tSynapse type %u: Min weight:%d, Max weight:%d, A2+:%d,"
+                 " A2-:%d", s, plasticity_weight_region_data[s].min_weight,
+                 plasticity_weight_region_data[s].max_weight,
+                 plasticity_weight_region_data[s].a2_plus,
+                 plasticity_weight_region_data[s].a2_minus);
+    }
+    return (address_t) plasticity_word;
+}
@@ -0,0 +1,18 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's neuron/population_table/
+ * population_table.h, the lookups which spike processing makes for each
+ * spike.
+ */
+
+#ifndef _POPULATION_TABLE_H_
+#define _POPULATION_TABLE_H_
+
+#include "../../common/neuron-typedefs.h"
+
+bool population_table_get_first_address(
+    spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer);
+
+bool population_table_get_next_address(
+    address_t* row_address, size_t* n_bytes_to_transfer);
+
+#endif  // _POPULATION_TABLE_H_
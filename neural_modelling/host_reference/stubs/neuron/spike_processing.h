@@ -0,0 +1,12 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's neuron/spike_processing.h.
+ */
+
+#ifndef _SPIKE_PROCESSING_H_
+#define _SPIKE_PROCESSING_H_
+
+#include "../common/neuron-typedefs.h"
+
+void spike_processing_finish_write(uint32_t process_id);
+
+#endif  // _SPIKE_PROCESSING_H_
@@ -0,0 +1,87 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's neuron/synapse_row.h: the layout of
+ * a synaptic row and of its synaptic words.
+ *
+ * \details A row is the size in words of its plastic region, the plastic
+ * region, then the fixed region: the number of fixed synapses, the number
+ * of plastic control words, the fixed synapses and the control words.
+ */
+
+#ifndef _SYNAPSE_ROW_H_
+#define _SYNAPSE_ROW_H_
+
+#include "../common/neuron-typedefs.h"
+
+#ifndef SYNAPSE_TYPE_BITS
+#define SYNAPSE_TYPE_BITS 1
+#endif
+
+#ifndef SYNAPSE_TYPE_COUNT
+#define SYNAPSE_TYPE_COUNT 2
+#endif
+
+#ifndef SYNAPSE_DELAY_BITS
+#define SYNAPSE_DELAY_BITS 4
+#endif
+
+#define SYNAPSE_INDEX_BITS 8
+#define SYNAPSE_TYPE_INDEX_BITS (SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS)
+#define SYNAPSE_WEIGHT_BITS 16
+
+#define SYNAPSE_DELAY_MASK ((1 << SYNAPSE_DELAY_BITS) - 1)
+#define SYNAPSE_TYPE_MASK ((1 << SYNAPSE_TYPE_BITS) - 1)
+#define SYNAPSE_INDEX_MASK ((1 << SYNAPSE_INDEX_BITS) - 1)
+#define SYNAPSE_TYPE_INDEX_MASK ((1 << SYNAPSE_TYPE_INDEX_BITS) - 1)
+
+typedef uint16_t weight_t;
+typedef uint16_t control_t;
+
+static inline size_t synapse_row_plastic_size(address_t row) {
+    return (size_t) row[0];
+}
+
+static inline address_t synapse_row_plastic_region(address_t row) {
+    return &row[1];
+}
+
+static inline address_t synapse_row_fixed_region(address_t row) {
+    return &row[synapse_row_plastic_size(row) + 1];
+}
+
+static inline size_t synapse_row_num_fixed_synapses(address_t fixed) {
+    return (size_t) fixed[0];
+}
+
+static inline size_t synapse_row_num_plastic_controls(address_t fixed) {
+    return (size_t) fixed[1];
+}
+
+static inline uint32_t *synapse_row_fixed_weight_controls(address_t fixed) {
+    return &fixed[2];
+}
+
+static inline control_t *synapse_row_plastic_controls(address_t fixed) {
+    return (control_t *) &fixed[2 + synapse_row_num_fixed_synapses(fixed)];
+}
+
+static inline index_t synapse_row_sparse_index(uint32_t x) {
+    return x & SYNAPSE_INDEX_MASK;
+}
+
+static inline index_t synapse_row_sparse_type(uint32_t x) {
+    return (x >> SYNAPSE_INDEX_BITS) & SYNAPSE_TYPE_MASK;
+}
+
+static inline index_t synapse_row_sparse_type_index(uint32_t x) {
+    return x & SYNAPSE_TYPE_INDEX_MASK;
+}
+
+static inline index_t synapse_row_sparse_delay(uint32_t x) {
+    return (x >> SYNAPSE_TYPE_INDEX_BITS) & SYNAPSE_DELAY_MASK;
+}
+
+static inline weight_t synapse_row_sparse_weight(uint32_t x) {
+    return x >> (32 - SYNAPSE_WEIGHT_BITS);
+}
+
+#endif  // _SYNAPSE_ROW_H_
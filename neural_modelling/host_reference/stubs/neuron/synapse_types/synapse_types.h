@@ -0,0 +1,62 @@
+/*! \file
+ * \brief Host stand-in for sPyNNaker's neuron/synapse_types/synapse_types.h:
+ * synapse types whose input is the weight arriving in the timestep, as
+ * synapse_types_delta_impl.h's is.
+ */
+
+#ifndef _SYNAPSE_TYPES_H_
+#define _SYNAPSE_TYPES_H_
+
+#include "../synapse_row.h"
+
+typedef struct synapse_param_t {
+    uint32_t unused;
+} synapse_param_t;
+
+static inline index_t synapse_types_get_input_buffer_index(
+        index_t synapse_type_index, index_t neuron_index) {
+    return (synapse_type_index << SYNAPSE_INDEX_BITS) | neuron_index;
+}
+
+static inline void synapse_types_shape_input(
+        input_t *input_buffers, index_t neuron_index,
+        synapse_param_t **parameters) {
+    use(parameters);
+    for (index_t t = 0; t < SYNAPSE_TYPE_COUNT; t++) {
+        input_buffers[synapse_types_get_input_buffer_index(
+            t, neuron_index)] = 0;
+    }
+}
+
+static inline void synapse_types_add_neuron_input(
+        input_t *input_buffers, index_t synapse_type_index,
+        index_t neuron_index, synapse_param_t **parameters, input_t input) {
+    use(parameters);
+    input_buffers[synapse_types_get_input_buffer_index(
+        synapse_type_index, neuron_index)] += input;
+}
+
+static inline input_t synapse_types_get_excitatory_input(
+        input_t *input_buffers, index_t neuron_index) {
+    return input_buffers[synapse_types_get_input_buffer_index(
+        0, neuron_index)];
+}
+
+static inline input_t synapse_types_get_inhibitory_input(
+        input_t *input_buffers, index_t neuron_index) {
+    return input_buffers[synapse_types_get_input_buffer_index(
+        1, neuron_index)];
+}
+
+static inline const char *synapse_types_get_type_char(
+        index_t synapse_type_index) {
+    return (synapse_type_index == 0)? "X" : "I";
+}
+
+static inline void synapse_types_print_input(
+        input_t *input_buffers, index_t neuron_index) {
+    use(input_buffers);
+    use(neuron_index);
+}
+
+#endif  // _SYNAPSE_TYPES_H_
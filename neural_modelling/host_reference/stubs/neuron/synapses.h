@@ -0,0 +1,49 @@
+/*! \file
+ * \brief Host stand-in for the parts of sPyNNaker's neuron/synapses.h used
+ * by the plastic kernels and synapses.c.
+ */
+
+#ifndef _SYNAPSES_H_
+#define _SYNAPSES_H_
+
+#include "../common/neuron-typedefs.h"
+#include "synapse_row.h"
+
+// The host's timer_t, from <sys/types.h>, is a pointer; sPyNNaker's is a
+// word
+#include <sys/types.h>
+#define timer_t uint32_t
+
+typedef address_t synaptic_row_t;
+
+//! \brief gets the ring buffer entry of a synapse type and neuron, given
+//! separately, at a timestep
+static inline index_t synapses_get_ring_buffer_index(
+        uint32_t simulation_timestep, uint32_t synapse_type_index,
+        uint32_t neuron_index) {
+    return ((simulation_timestep & SYNAPSE_DELAY_MASK)
+            << SYNAPSE_TYPE_INDEX_BITS)
+        | (synapse_type_index << SYNAPSE_INDEX_BITS) | neuron_index;
+}
+
+//! \brief gets the ring buffer entry of a synapse type and neuron at a
+//! timestep
+static inline index_t synapses_get_ring_buffer_index_combined(
+        uint32_t simulation_timestep, uint32_t combined_synapse_neuron_index) {
+    return ((simulation_timestep & SYNAPSE_DELAY_MASK)
+            << SYNAPSE_TYPE_INDEX_BITS) | combined_synapse_neuron_index;
+}
+
+//! \brief converts a ring buffer entry to input; input_t is a word here
+static inline input_t synapses_convert_weight_to_input(
+        weight_t weight, uint32_t left_shift) {
+    return (input_t) weight << left_shift;
+}
+
+static inline void synapses_print_weight(
+        weight_t weight, uint32_t left_shift) {
+    use(weight);
+    use(left_shift);
+}
+
+#endif  // _SYNAPSES_H_
@@ -0,0 +1,10 @@
+/*! \file
+ * \brief Host stand-in for spinn_common's static-assert.h.
+ */
+
+#ifndef _STATIC_ASSERT_H_
+#define _STATIC_ASSERT_H_
+
+#define static_assert _Static_assert
+
+#endif  // _STATIC_ASSERT_H_
@@ -39,4 +39,12 @@ static void additional_input_has_spiked(
     additional_input->I_Ca2 += additional_input->I_alpha;
 }
 
+// Once the calcium trace has decayed to zero the neuron can be skipped
+// while it has no other input (see neuron_model_lif_skip_idle_impl.h)
+#define ADDITIONAL_INPUT_HAS_QUIESCENCE
+static inline bool additional_input_is_quiescent(
+        additional_input_pointer_t additional_input) {
+    return bitsk(additional_input->I_Ca2) == 0;
+}
+
 #endif // _ADDITIONAL_INPUT_CA2_ADAPTIVE_H_
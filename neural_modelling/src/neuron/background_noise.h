@@ -0,0 +1,43 @@
+/*! \file
+ * \brief Poisson background input of a core, kept in the
+ * BACKGROUND_NOISE_REGION when built with SYNAPSE_BACKGROUND_NOISE.
+ *
+ * \details Each timestep the core draws the number of background spikes of
+ * each noisy neuron from a Poisson distribution and adds that many times its
+ * weight to the neuron's ring buffer entry of the timestep, just before the
+ * entries are drained, as a noise population connected one to one with no
+ * delay would have done without the packets and row fetches.  The counts
+ * are drawn with Knuth's method, multiplying uniform numbers from a
+ * mars_kiss generator seeded by the host until the product falls to
+ * exp(-rate * timestep), so a neuron with a low rate usually takes one
+ * number.
+ */
+
+#ifndef _BACKGROUND_NOISE_H_
+#define _BACKGROUND_NOISE_H_
+
+#include "mars_kiss.h"
+
+//! A noisy neuron, as written by the host
+typedef struct background_noise_source_t {
+
+    //! exp(-expected spikes per timestep), as an unsigned 0.32 fraction
+    uint32_t exp_minus_lambda;
+
+    //! The synapse type and index of the neuron in their bits of a synaptic
+    //! word, with no delay
+    uint32_t type_index;
+
+    //! The weight of each spike, in the units of the input (S16.15)
+    int32_t weight;
+} background_noise_source_t;
+
+//! Layout of the BACKGROUND_NOISE_REGION; must match
+//! spynnaker_extra_pynn_models/neuron/background_noise.py
+typedef struct background_noise_t {
+    mars_kiss_state_t seed;
+    uint32_t n_sources;
+    background_noise_source_t sources[];
+} background_noise_t;
+
+#endif  // _BACKGROUND_NOISE_H_
@@ -0,0 +1,50 @@
+/*! \file
+ * \brief Bitmap of the parts of the synaptic matrix holding plastic weights
+ * which have changed, kept in the CHANGED_ROWS_REGION when built with
+ * SYNAPSE_CHANGED_ROWS.
+ *
+ * \details Bit c is set when the weight of a plastic synapse in bytes
+ * [c * CHANGED_ROWS_CHUNK_BYTES, (c + 1) * CHANGED_ROWS_CHUNK_BYTES) of the
+ * synaptic matrix region changes, and is cleared by the host once it has
+ * read those bytes, so that reading weights back after each run only reads
+ * what has changed since the last read.  Rows beyond the n_chunks chunks
+ * the host sized the bitmap for set overflow instead.
+ *
+ * The synapse dynamics says whether the weights of a row changed through
+ * changed_rows_set_weights_changed; a row is assumed to have changed if it
+ * doesn't.  Accumulators and other plastic state are not tracked, as only
+ * the weights are read back.
+ */
+
+#ifndef _CHANGED_ROWS_H_
+#define _CHANGED_ROWS_H_
+
+#include <common-typedefs.h>
+
+#define CHANGED_ROWS_CHUNK_BITS 6
+#define CHANGED_ROWS_CHUNK_BYTES (1 << CHANGED_ROWS_CHUNK_BITS)
+
+//! Layout of the CHANGED_ROWS_REGION; must match
+//! spynnaker_extra_pynn_models/neuron/changed_rows.py
+typedef struct changed_rows_t {
+    uint32_t n_chunks;
+    uint32_t overflow;
+    uint32_t bitmap[];
+} changed_rows_t;
+
+#ifdef SYNAPSE_CHANGED_ROWS
+extern bool changed_rows_weights_changed;
+
+//! \brief records whether the row being processed had a weight changed
+//! \param[in] changed true if any weight of the row changed
+static inline void changed_rows_set_weights_changed(bool changed) {
+    changed_rows_weights_changed = changed;
+}
+#else  // SYNAPSE_CHANGED_ROWS
+
+static inline void changed_rows_set_weights_changed(bool changed) {
+    use(changed);
+}
+#endif  // SYNAPSE_CHANGED_ROWS
+
+#endif  // _CHANGED_ROWS_H_
@@ -0,0 +1,47 @@
+/*! \file
+ * \brief Checkpoint of the plastic state of a core, kept in the
+ * CHECKPOINT_REGION when built with TARGET_CHECKPOINT.
+ *
+ * \details At the start of timestep checkpoint_time the core copies the
+ * state of its synapse dynamics (the post-event histories and the rule's own
+ * state) into data, followed by the whole synaptic matrix, which holds the
+ * plastic synapses and each row's pre-event history.  The matrix is copied
+ * in the background over the following timesteps, with spikes still being
+ * processed; a row about to be written back is copied first, so the
+ * checkpoint holds the matrix as it was at checkpoint_time.  The host reads
+ * the checkpoint back, and to resume writes it into the region of a fresh
+ * run of the same network with restore set; the core then copies the matrix
+ * back over the one the host loaded and the dynamics carry on from the
+ * checkpoint's time.
+ *
+ * Neuron state, input still in the ring buffers and spikes in flight are not
+ * part of the checkpoint.
+ */
+
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <common-typedefs.h>
+
+//! The checkpoint_time of cores which don't take a checkpoint
+#define CHECKPOINT_NEVER 0xFFFFFFFF
+
+//! Layout of the CHECKPOINT_REGION; must match
+//! spynnaker_extra_pynn_models/neuron/checkpoint.py
+typedef struct checkpoint_t {
+
+    // Written by the host
+    uint32_t checkpoint_time;
+    uint32_t restore;
+    uint32_t capacity_bytes;
+
+    // Written by the core when it takes the checkpoint, and by the host when
+    // restoring one; time is in the timesteps of the run which started
+    // training, and dynamics_bytes is 0 until a checkpoint is complete
+    uint32_t time;
+    uint32_t dynamics_bytes;
+    uint32_t matrix_bytes;
+    uint32_t data[];
+} checkpoint_t;
+
+#endif  // _CHECKPOINT_H_
@@ -0,0 +1,61 @@
+/*! \file
+ * \brief Data specification regions used by the extra models on top of the
+ * standard population regions.
+ *
+ * \details These must match EXTRA_REGIONS in
+ * spynnaker_extra_pynn_models/neuron/extra_regions.py.  Vertices which don't
+ * reserve a region leave its entry in the region table as zero, so any
+ * feature using one is disabled when extra_regions_get returns NULL.
+ */
+
+#ifndef _EXTRA_REGIONS_H_
+#define _EXTRA_REGIONS_H_
+
+#include <common-typedefs.h>
+#include <data_specification.h>
+
+typedef enum extra_regions_e {
+    SYNAPSE_PROVENANCE_REGION = 10,
+    TURBO_REGION = 11,
+    TARGET_SCHEDULE_REGION = 12,
+    CHANGED_ROWS_REGION = 13,
+    CHECKPOINT_REGION = 14,
+    BACKGROUND_NOISE_REGION = 15,
+} extra_regions_e;
+
+//! The number of entries in the region table
+#define EXTRA_REGIONS_MAX_REGIONS 16
+
+//! The standard region holding the synaptic matrix, which the changed rows
+//! bitmap covers
+#define SYNAPTIC_MATRIX_REGION 4
+
+//! \brief gets the address of one of the extra regions
+//! \param[in] region the region to get
+//! \return the address of the region, or NULL if it was not reserved
+static inline address_t extra_regions_get(extra_regions_e region) {
+    address_t region_address = data_specification_get_region(
+        region, data_specification_get_data_address());
+    return (region_address == (address_t) 0)? NULL : region_address;
+}
+
+//! \brief gets the size of a region as the distance to the region which
+//! follows it, as the data specification allocates regions one after another
+//! \param[in] region the region to get the size of
+//! \return the size in bytes, or 0 if no region follows it
+static inline uint32_t extra_regions_get_size(uint32_t region) {
+    address_t data_address = data_specification_get_data_address();
+    uint32_t begin = (uint32_t) data_specification_get_region(
+        region, data_address);
+    uint32_t end = begin;
+    for (uint32_t r = 0; r < EXTRA_REGIONS_MAX_REGIONS; r++) {
+        uint32_t address = (uint32_t) data_specification_get_region(
+            r, data_address);
+        if (address > begin && (end == begin || address < end)) {
+            end = address;
+        }
+    }
+    return end - begin;
+}
+
+#endif  // _EXTRA_REGIONS_H_
@@ -0,0 +1,160 @@
+""" Generate the Makefiles of the builds of the component models from their\
+    descriptions in spynnaker_extra_pynn_models/neuron/build_descriptions.py.
+
+    usage: python generate_builds.py [--check]
+
+    Writes builds/<build>/Makefile for each described build and the MODELS\
+    of the Makefile of this directory.  With --check, writes nothing, but\
+    fails if a Makefile differs from its description, or if a model class\
+    names a binary which no build makes.
+"""
+from __future__ import print_function
+
+import os
+import re
+import sys
+import textwrap
+
+_HERE = os.path.dirname(os.path.abspath(__file__))
+_REPO = os.path.normpath(os.path.join(_HERE, "..", "..", ".."))
+_PACKAGE = os.path.join(_REPO, "spynnaker_extra_pynn_models")
+
+
+def _load_build_descriptions():
+    """ Load the descriptions, which only use the standard library, without\
+        the package, which needs the rest of sPyNNaker
+    """
+    path = os.path.join(_PACKAGE, "neuron", "build_descriptions.py")
+    try:
+        import importlib.util
+        spec = importlib.util.spec_from_file_location(
+            "build_descriptions", path)
+        module = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(module)
+        return module
+    except ImportError:
+        import imp
+        return imp.load_source("build_descriptions", path)
+
+
+build_descriptions = _load_build_descriptions()
+
+_HEADER = textwrap.wrap(
+    "Generated by neural_modelling/src/neuron/generate_builds.py from"
+    " spynnaker_extra_pynn_models/neuron/build_descriptions.py; change the"
+    " description and regenerate rather than editing this file", 77)
+
+
+def _comment(text):
+    return ["# " + line for line in textwrap.wrap(text, 77)]
+
+
+def get_makefile(description):
+    """ Get the text of the Makefile of a build
+    """
+    lines = ["# " + line for line in _HEADER]
+    lines.extend(["APP = $(notdir $(CURDIR))", "BUILD_DIR = build/", ""])
+    lines.extend("{} = {}".format(name, value)
+                 for name, value in description.get_makefile_variables())
+    for comment, flags in description.cflags:
+        lines.append("")
+        if comment is not None:
+            lines.extend(_comment(comment))
+        lines.append("CFLAGS += " + flags)
+    feature_cflags, wrapped = description.get_features()
+    for comment, flags in feature_cflags:
+        lines.append("")
+        lines.extend(_comment(comment))
+        lines.append("CFLAGS += " + flags)
+    if wrapped:
+        lines.append("")
+        lines.extend(_comment("Functions wrapped by the features above"))
+        lines.append("LFLAGS += " + " ".join(
+            "-Wl,--wrap=" + function for function in wrapped))
+    feature_flags = description.get_feature_cflags()
+    if feature_flags:
+        lines.append("")
+        lines.extend(_comment(
+            "Features the build can't use, compiled out of synapses.c"))
+        lines.append("CFLAGS += " + " ".join(feature_flags))
+    lines.extend(["", "include ../Makefile.common", ""])
+    return "\n".join(lines)
+
+
+def get_models_line():
+    return "MODELS = " + " ".join(build_descriptions.get_build_names())
+
+
+def _read(path):
+    if not os.path.exists(path):
+        return None
+    with open(path) as f:
+        return f.read()
+
+
+def _write(path, text):
+    directory = os.path.dirname(path)
+    if not os.path.isdir(directory):
+        os.makedirs(directory)
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def _get_named_binaries():
+    """ Get the binaries named by the model classes, with the files naming\
+        them
+    """
+    binaries = dict()
+    for directory, _, filenames in os.walk(_PACKAGE):
+        for filename in filenames:
+            if not filename.endswith(".py"):
+                continue
+            path = os.path.join(directory, filename)
+            for binary in re.findall(r"\b(\w+\.aplx)\b", _read(path)):
+                binaries.setdefault(binary, path)
+    return binaries
+
+
+def main(check):
+    problems = list()
+    names = set(build_descriptions.get_build_names())
+
+    # The Makefile of each build
+    for description in build_descriptions.BUILDS:
+        path = os.path.join(_HERE, "builds", description.name, "Makefile")
+        text = get_makefile(description)
+        if _read(path) == text:
+            continue
+        if check:
+            problems.append("{} differs from its description".format(path))
+        else:
+            _write(path, text)
+            print("wrote", path)
+
+    # The builds made by the Makefile of this directory
+    path = os.path.join(_HERE, "Makefile")
+    makefile = _read(path)
+    models = re.sub(r"(?m)^MODELS = .*$", get_models_line(), makefile)
+    if models != makefile:
+        if check:
+            problems.append("the MODELS of {} differ from the builds".format(
+                path))
+        else:
+            _write(path, models)
+            print("wrote", path)
+
+    # The binaries the model classes load must be made by a build; a class
+    # which adds the suffix of its rule names only the start of the binary
+    for binary, source in sorted(_get_named_binaries().items()):
+        prefix = binary[:-len(".aplx")]
+        if not any(name.startswith(prefix) for name in names):
+            problems.append("{} names {}, which no build makes".format(
+                source, binary))
+
+    for problem in problems:
+        print(problem, file=sys.stderr)
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main("--check" in sys.argv[1:]))
@@ -0,0 +1,42 @@
+/*! \file
+ * \brief Marsaglia's KISS generator, as the stochastic timing rules use it
+ * through random_util.h, with its state held by the caller so that it can be
+ * seeded per core.
+ */
+
+#ifndef _MARS_KISS_H_
+#define _MARS_KISS_H_
+
+#include <common-typedefs.h>
+
+//! State of the generator; y must not be zero and c starts at zero
+typedef struct mars_kiss_state_t {
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+    uint32_t w;
+    uint32_t c;
+} mars_kiss_state_t;
+
+//! The state random_util.h starts from
+#define MARS_KISS_DEFAULT_STATE {123456789, 234567891, 345678912, 456789123, 0}
+
+//! \brief advances the generator
+//! \param[in,out] state the state of the generator
+//! \return 32 random bits
+static inline uint32_t mars_kiss_next(mars_kiss_state_t *state) {
+    int32_t t;
+
+    state->y ^= (state->y << 5);
+    state->y ^= (state->y >> 7);
+    state->y ^= (state->y << 22);
+    t = state->z + state->w + state->c;
+    state->z = state->w;
+    state->c = t < 0;
+    state->w = t & 2147483647;
+    state->x += 1411392427;
+
+    return state->x + state->y + state->w;
+}
+
+#endif  // _MARS_KISS_H_
@@ -0,0 +1,68 @@
+/*! \file
+ * \brief Leaky integrate and fire neuron model whose neurons neuron.c may
+ * skip while they have no input, bringing them up to date analytically
+ * when it next updates them.
+ *
+ * \details Used by the *_skip_idle builds, which define NEURON_SKIP_IDLE.
+ * With no input and no offset current the membrane voltage of an LIF neuron
+ * decays exponentially to rest once it is out of its refractory period, so
+ * while V_rest and V_reset are below a static threshold no spike can be
+ * missed while the neuron is skipped; IFCurrDelta and IFCurrExpCa2Adaptive
+ * check this before choosing these builds.
+ */
+
+#ifndef _NEURON_MODEL_LIF_SKIP_IDLE_IMPL_H_
+#define _NEURON_MODEL_LIF_SKIP_IDLE_IMPL_H_
+
+#include <neuron/models/neuron_model_lif_impl.h>
+
+//! \brief raises the membrane decay to the power of n_steps by repeated
+//! squaring, rather than applying it once per skipped timestep
+//! \param[in] exp_tc the per-timestep decay, exp(-dt / (R * C))
+//! \param[in] n_steps the number of timesteps to decay over
+//! \return exp_tc ^ n_steps
+static inline REAL _lif_decay_power(REAL exp_tc, uint32_t n_steps) {
+    REAL result = REAL_CONST(1.0);
+    while (n_steps > 0) {
+        if (n_steps & 1) {
+            result = result * exp_tc;
+        }
+        exp_tc = exp_tc * exp_tc;
+        n_steps >>= 1;
+    }
+    return result;
+}
+
+//! \brief tells whether a neuron with no synaptic input would do nothing
+//! but decay to rest
+//! \param[in] neuron the neuron being considered
+//! \return true if the neuron has no offset current
+static inline bool neuron_model_is_idle(neuron_pointer_t neuron) {
+    return bitsk(neuron->I_offset) == 0;
+}
+
+//! \brief advances an idle neuron over the timesteps it was skipped for,
+//! as neuron_model_state_update would with no input
+//! \param[in] neuron the neuron to advance
+//! \param[in] n_steps the number of timesteps it was skipped for
+//! \return nothing
+static inline void neuron_model_fast_forward(
+        neuron_pointer_t neuron, uint32_t n_steps) {
+
+    // The membrane voltage is held while the neuron is refractory
+    if (neuron->refract_timer > 0) {
+        uint32_t refract_steps = ((uint32_t) neuron->refract_timer < n_steps)?
+            (uint32_t) neuron->refract_timer : n_steps;
+        neuron->refract_timer -= refract_steps;
+        n_steps -= refract_steps;
+    }
+
+    // After which it decays exponentially towards rest
+    if (n_steps > 0) {
+        neuron->V_membrane = neuron->V_rest
+            + ((neuron->V_membrane - neuron->V_rest)
+               * _lif_decay_power(neuron->exp_TC, n_steps));
+    }
+}
+
+#endif  // _NEURON_MODEL_LIF_SKIP_IDLE_IMPL_H_
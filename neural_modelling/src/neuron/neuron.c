@@ -0,0 +1,436 @@
+/*! \file
+ * \brief implementation of the neuron.h interface.
+ *
+ * \details sPyNNaker's neuron loop, used in its place as synapses.c is, so
+ * that builds with NEURON_SKIP_IDLE can pass over the neurons which have no
+ * input (see models/neuron_model_lif_skip_idle_impl.h).  Without it the
+ * loop is sPyNNaker's.
+ */
+
+#include "neuron.h"
+#include "models/neuron_model.h"
+#include "input_types/input_type.h"
+#include "additional_inputs/additional_input.h"
+#include "threshold_types/threshold_type.h"
+#include "synapse_types/synapse_types.h"
+#include "plasticity/synapse_dynamics.h"
+#ifdef NEURON_SKIP_IDLE
+#include "synapses_input_bitmap.h"
+#endif  // NEURON_SKIP_IDLE
+#include <common/out_spikes.h>
+#include <common/recording.h>
+#include <debug.h>
+#include <string.h>
+
+//! Array of neuron states
+static neuron_pointer_t neuron_array;
+
+//! Input states array
+static input_type_pointer_t input_type_array;
+
+//! Additional input array
+static additional_input_pointer_t additional_input_array;
+
+//! Threshold states array
+static threshold_type_pointer_t threshold_type_array;
+
+//! Global parameters for the neurons
+static global_neuron_params_pointer_t global_parameters;
+
+//! The key to be used for this core (will be ORed with neuron id)
+static key_t key;
+
+//! A checker that says if this model should be transmitting. If set to false
+//! by the data region, then this model should not have a key.
+static bool use_key;
+
+//! The number of neurons on the core
+static uint32_t n_neurons;
+
+//! The recording flags
+static uint32_t recording_flags;
+
+//! The input buffers - from synapses.c
+static input_t *input_buffers;
+
+#ifdef NEURON_SKIP_IDLE
+//! Bit per neuron, set while the neuron must be updated whether or not it
+//! has synaptic input, as it has an offset current or additional input
+static uint32_t neuron_busy[SYNAPSES_INPUT_BITMAP_WORDS];
+
+//! The last timestep at which each neuron was updated
+static uint32_t *neuron_last_update_time;
+
+//! Whether the neurons are skipped; not while their voltages or inputs are
+//! recorded, which needs every neuron every timestep
+static bool skip_idle_neurons;
+static bool skip_idle_started = false;
+#endif  // NEURON_SKIP_IDLE
+
+//! parameters that reside in the neuron_parameter_data_region in human
+//! readable form
+typedef enum parmeters_in_neuron_parameter_data_region {
+    HAS_KEY, TRANSMISSION_KEY, N_NEURONS_TO_SIMULATE,
+    START_OF_GLOBAL_PARAMETERS,
+} parmeters_in_neuron_parameter_data_region;
+
+
+//! private method for doing output debug data on the neurons
+static inline void _print_neurons() {
+
+//! only if the models are compiled in debug mode will this method contain
+//! said lines.
+#if LOG_LEVEL >= LOG_DEBUG
+    log_debug("-------------------------------------\n");
+    for (index_t n = 0; n < n_neurons; n++) {
+        neuron_model_print_state_variables(&(neuron_array[n]));
+    }
+    log_debug("-------------------------------------\n");
+#endif // LOG_LEVEL >= LOG_DEBUG
+}
+
+//! private method for doing output debug data on the neurons
+static inline void _print_neuron_parameters() {
+#if LOG_LEVEL >= LOG_DEBUG
+    log_debug("-------------------------------------\n");
+    for (index_t n = 0; n < n_neurons; n++) {
+        neuron_model_print_parameters(&(neuron_array[n]));
+    }
+    log_debug("-------------------------------------\n");
+#endif // LOG_LEVEL >= LOG_DEBUG
+}
+
+#ifdef NEURON_SKIP_IDLE
+// Additional inputs which hold state say when it leaves the neuron alone by
+// defining ADDITIONAL_INPUT_HAS_QUIESCENCE; those which hold none never
+// affect it
+#ifndef ADDITIONAL_INPUT_HAS_QUIESCENCE
+static inline bool additional_input_is_quiescent(
+        additional_input_pointer_t additional_input) {
+    use(additional_input);
+    return sizeof(additional_input_t) == 0;
+}
+#endif  // ADDITIONAL_INPUT_HAS_QUIESCENCE
+
+static bool _skip_idle_initialise() {
+    neuron_last_update_time = (uint32_t *) spin1_malloc(
+        n_neurons * sizeof(uint32_t));
+    if (neuron_last_update_time == NULL) {
+        log_error("Unable to allocate neuron update times - Out of DTCM");
+        return false;
+    }
+
+    // Every neuron is updated in the first timestep
+    for (index_t n = 0; n < n_neurons; n++) {
+        neuron_busy[n >> 5] |= 1 << (n & 0x1F);
+    }
+    skip_idle_neurons = !recording_is_channel_enabled(
+            recording_flags, e_recording_channel_neuron_potential)
+        && !recording_is_channel_enabled(
+            recording_flags, e_recording_channel_neuron_gsyn);
+    log_info("\tIdle neurons are %s",
+             skip_idle_neurons? "skipped" : "updated, as they are recorded");
+    return true;
+}
+
+//! \brief brings a neuron up to date with the timesteps it was skipped for,
+//! before it is updated in this one
+static inline void _catch_up(index_t neuron_index, uint32_t time) {
+
+    // The time before the first timestep is one less, modulo 2^32
+    uint32_t n_skipped = time - neuron_last_update_time[neuron_index] - 1;
+    if (n_skipped > 0) {
+        neuron_model_fast_forward(&neuron_array[neuron_index], n_skipped);
+    }
+    neuron_last_update_time[neuron_index] = time;
+}
+
+//! \brief records whether a neuron just updated must be updated next
+//! timestep even without synaptic input
+static inline void _set_busy(index_t neuron_index) {
+    uint32_t bit = 1 << (neuron_index & 0x1F);
+    if (neuron_model_is_idle(&neuron_array[neuron_index])
+            && additional_input_is_quiescent(
+                &additional_input_array[neuron_index])) {
+        neuron_busy[neuron_index >> 5] &= ~bit;
+    } else {
+        neuron_busy[neuron_index >> 5] |= bit;
+    }
+}
+#else  // NEURON_SKIP_IDLE
+
+static inline bool _skip_idle_initialise() {
+    return true;
+}
+#endif  // NEURON_SKIP_IDLE
+
+//! \brief translate the data stored in the NEURON_PARAMS data region in SDRAM
+//!        and convert it into c based objects for use.
+//! \param[in] address the absolute address in SDRAM for the start of the
+//!            NEURON_PARAMS data region in SDRAM
+//! \param[in] recording_flags_param the recordings parameters
+//!            (contains which regions are active and how big they are)
+//! \param[out] n_neurons_value The number of neurons this model is to emulate
+//! \return boolean which is True is the translation was successful
+//! otherwise False
+bool neuron_initialise(address_t address, uint32_t recording_flags_param,
+        uint32_t *n_neurons_value) {
+    log_info("neuron_initialise: starting");
+
+    // Check if there is a key to use
+    use_key = address[HAS_KEY];
+
+    // Read the spike key to use
+    key = address[TRANSMISSION_KEY];
+
+    // output if this model is expecting to transmit
+    if (!use_key) {
+        log_info("\tThis model is not expecting to transmit as it has no key");
+    } else {
+        log_info("\tThis model is expected to transmit with key = %08x", key);
+    }
+
+    // Read the neuron details
+    n_neurons = address[N_NEURONS_TO_SIMULATE];
+    *n_neurons_value = n_neurons;
+
+    // Read the global parameter details
+    uint32_t next = START_OF_GLOBAL_PARAMETERS;
+    if (sizeof(global_neuron_params_t) > 0) {
+        global_parameters = (global_neuron_params_t *) spin1_malloc(
+            sizeof(global_neuron_params_t));
+        if (global_parameters == NULL) {
+            log_error("Unable to allocate global neuron parameters"
+                      "- Out of DTCM");
+            return false;
+        }
+        memcpy(global_parameters, &address[next],
+               sizeof(global_neuron_params_t));
+        next += sizeof(global_neuron_params_t) / 4;
+    }
+
+    log_info("\t neurons = %u", n_neurons);
+
+    // Allocate DTCM for neuron array and copy block of data
+    if (sizeof(neuron_t) != 0) {
+        neuron_array = (neuron_t *) spin1_malloc(n_neurons * sizeof(neuron_t));
+        if (neuron_array == NULL) {
+            log_error("Unable to allocate neuron array - Out of DTCM");
+            return false;
+        }
+        memcpy(neuron_array, &address[next], n_neurons * sizeof(neuron_t));
+        next += (n_neurons * sizeof(neuron_t)) / 4;
+    }
+
+    // Allocate DTCM for input type array and copy block of data
+    if (sizeof(input_type_t) != 0) {
+        input_type_array = (input_type_t *) spin1_malloc(
+            n_neurons * sizeof(input_type_t));
+        if (input_type_array == NULL) {
+            log_error("Unable to allocate input type array - Out of DTCM");
+            return false;
+        }
+        memcpy(input_type_array, &address[next],
+               n_neurons * sizeof(input_type_t));
+        next += (n_neurons * sizeof(input_type_t)) / 4;
+    }
+
+    // Allocate DTCM for additional input array and copy block of data
+    if (sizeof(additional_input_t) != 0) {
+        additional_input_array = (additional_input_pointer_t) spin1_malloc(
+            n_neurons * sizeof(additional_input_t));
+        if (additional_input_array == NULL) {
+            log_error("Unable to allocate additional input array"
+                      " - Out of DTCM");
+            return false;
+        }
+        memcpy(additional_input_array, &address[next],
+               n_neurons * sizeof(additional_input_t));
+        next += (n_neurons * sizeof(additional_input_t)) / 4;
+    }
+
+    // Allocate DTCM for threshold type array and copy block of data
+    if (sizeof(threshold_type_t) != 0) {
+        threshold_type_array = (threshold_type_t *) spin1_malloc(
+            n_neurons * sizeof(threshold_type_t));
+        if (threshold_type_array == NULL) {
+            log_error("Unable to allocate threshold type array - Out of DTCM");
+            return false;
+        }
+        memcpy(threshold_type_array, &address[next],
+               n_neurons * sizeof(threshold_type_t));
+    }
+
+    // Set up the out spikes array
+    if (!out_spikes_initialize(n_neurons)) {
+        return false;
+    }
+
+    // Set up the neuron model
+    neuron_model_set_global_neuron_params(global_parameters);
+
+    recording_flags = recording_flags_param;
+
+    if (!_skip_idle_initialise()) {
+        return false;
+    }
+
+    _print_neuron_parameters();
+
+    return true;
+}
+
+//! \setter for the internal input buffers
+//! \param[in] input_buffers_value the new input buffers
+void neuron_set_input_buffers(input_t *input_buffers_value) {
+    input_buffers = input_buffers_value;
+}
+
+//! \brief updates a neuron for a timestep, and sends its spike if it fires
+//! \param[in] time the timer tick value currently being executed
+//! \param[in] neuron_index the index of the neuron on this core
+static inline void _update_neuron(timer_t time, index_t neuron_index) {
+
+    // Get the parameters for this neuron
+    neuron_pointer_t neuron = &neuron_array[neuron_index];
+    input_type_pointer_t input_type = &input_type_array[neuron_index];
+    threshold_type_pointer_t threshold_type =
+        &threshold_type_array[neuron_index];
+    additional_input_pointer_t additional_input =
+        &additional_input_array[neuron_index];
+
+    // Get the voltage
+    state_t voltage = neuron_model_get_membrane_voltage(neuron);
+
+    // If we should be recording potential, record this neuron parameter
+    if (recording_is_channel_enabled(recording_flags,
+            e_recording_channel_neuron_potential)) {
+        recording_record(e_recording_channel_neuron_potential, &voltage,
+                         sizeof(state_t));
+    }
+
+    // Get excitatory and inhibitory input from synapses and convert it
+    // to current input
+    input_t exc_input_value = input_type_get_input_value(
+        synapse_types_get_excitatory_input(input_buffers, neuron_index),
+        input_type);
+    input_t inh_input_value = input_type_get_input_value(
+        synapse_types_get_inhibitory_input(input_buffers, neuron_index),
+        input_type);
+    input_t exc_input = input_type_convert_excitatory_input_to_current(
+        exc_input_value, input_type, voltage);
+    input_t inh_input = input_type_convert_inhibitory_input_to_current(
+        inh_input_value, input_type, voltage);
+
+    // Get external bias from any source of intrinsic plasticity
+    input_t external_bias =
+        synapse_dynamics_get_intrinsic_bias(time, neuron_index) +
+        additional_input_get_input_value_as_current(
+            additional_input, voltage);
+
+    // If we should be recording input, record the values
+    if (recording_is_channel_enabled(recording_flags,
+            e_recording_channel_neuron_gsyn)) {
+        input_t temp_record_input = exc_input_value - inh_input_value;
+        recording_record(
+            e_recording_channel_neuron_gsyn, &temp_record_input,
+            sizeof(input_t));
+    }
+
+    // update neuron parameters
+    state_t result = neuron_model_state_update(
+        exc_input, inh_input, external_bias, neuron);
+
+    // determine if a spike should occur
+    bool spike = threshold_type_is_above_threshold(result, threshold_type);
+
+    // If the neuron has spiked
+    if (spike) {
+        log_debug("neuron %u spiked at time %u", neuron_index, time);
+
+        // Tell the neuron model
+        neuron_model_has_spiked(neuron);
+
+        // Tell the additional input
+        additional_input_has_spiked(additional_input);
+
+        // Do any required synapse processing
+        synapse_dynamics_process_post_synaptic_event(time, neuron_index);
+
+        // Record the spike
+        out_spikes_set_spike(neuron_index);
+
+        // Send the spike
+        if (use_key) {
+            while (!spin1_send_mc_packet(
+                    key | neuron_index, 0, NO_PAYLOAD)) {
+                spin1_delay_us(1);
+            }
+        }
+    } else {
+        log_debug("the neuron %d has been determined to not spike",
+                  neuron_index);
+    }
+}
+
+#ifdef NEURON_SKIP_IDLE
+//! \brief updates the neurons which have synaptic input or are busy,
+//! passing over 32 neurons at a time where none are; the neurons passed
+//! over are brought up to date when they are next updated
+static inline void _update_active_neurons(timer_t time) {
+
+    // The neurons updated before the first timestep are all up to date
+    if (!skip_idle_started) {
+        for (index_t n = 0; n < n_neurons; n++) {
+            neuron_last_update_time[n] = time - 1;
+        }
+        skip_idle_started = true;
+    }
+
+    uint32_t n_words = (n_neurons + 31) >> 5;
+    for (uint32_t w = 0; w < n_words; w++) {
+        uint32_t active = synapses_input_received[w] | neuron_busy[w];
+        while (active != 0) {
+            index_t neuron_index = (w << 5) + __builtin_ctz(active);
+            active &= active - 1;
+            _catch_up(neuron_index, time);
+            _update_neuron(time, neuron_index);
+            _set_busy(neuron_index);
+        }
+    }
+}
+#endif  // NEURON_SKIP_IDLE
+
+//! \executes all the updates to neural parameters when a given timer period
+//! has occurred.
+//! \param[in] time the timer tick  value currently being executed
+void neuron_do_timestep_update(timer_t time) {
+
+#ifdef NEURON_SKIP_IDLE
+    if (skip_idle_neurons) {
+        _update_active_neurons(time);
+    } else
+#endif  // NEURON_SKIP_IDLE
+    {
+        // update each neuron individually
+        for (index_t neuron_index = 0; neuron_index < n_neurons;
+                neuron_index++) {
+            _update_neuron(time, neuron_index);
+        }
+    }
+
+    // do logging stuff if required
+    out_spikes_print();
+    _print_neurons();
+
+    // Record any spikes this timestep
+    if (recording_is_channel_enabled(recording_flags,
+            e_recording_channel_spike_history)) {
+        if (!out_spikes_is_empty()) {
+
+            // record out spikes
+            out_spikes_record(e_recording_channel_spike_history);
+        }
+    }
+    out_spikes_reset();
+}
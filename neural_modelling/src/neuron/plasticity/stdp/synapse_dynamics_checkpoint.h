@@ -0,0 +1,26 @@
+/*! \file
+ * \brief Checkpointing of the target rule's state, used by synapses.c when
+ * built with TARGET_CHECKPOINT.
+ *
+ * \details The post-event histories and the time of the last target live in
+ * DTCM, and the times in them and in the rows' pre-event histories count
+ * from the start of training.  A restored run starts again from timestep 0,
+ * so the rule adds the time of the checkpoint to each timestep it is given.
+ */
+
+#ifndef _SYNAPSE_DYNAMICS_CHECKPOINT_H_
+#define _SYNAPSE_DYNAMICS_CHECKPOINT_H_
+
+#include <common-typedefs.h>
+
+//! The time of the checkpoint the core was restored from, or 0
+extern uint32_t synapse_dynamics_checkpoint_time_base;
+
+//! \brief copies the state of the synapse dynamics into a checkpoint
+//! \param[in] address where to copy the state to
+//! \param[in] max_bytes the space at address
+//! \return the number of bytes copied, or 0 if the state doesn't fit
+uint32_t synapse_dynamics_checkpoint_save(address_t address,
+                                          uint32_t max_bytes);
+
+#endif  // _SYNAPSE_DYNAMICS_CHECKPOINT_H_
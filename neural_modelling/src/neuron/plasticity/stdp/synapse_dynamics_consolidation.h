@@ -0,0 +1,33 @@
+/*! \file
+ * \brief Background consolidation of the target rule's deferred updates,
+ * used by synapses.c when built with TARGET_CONSOLIDATION.
+ *
+ * \details The target rule only applies the post events since a row's last
+ * presynaptic spike when the next spike fetches the row, so the accumulated
+ * updates of an input which falls silent wait until it fires again, and are
+ * lost if the post-event history overflows first.  The sweep applies those
+ * events to rows in SDRAM in the time the core has left each timestep, as
+ * the deferred update would have done, and records how far it got in the
+ * row's pre-event history so that the next spike doesn't apply them again.
+ */
+
+#ifndef _SYNAPSE_DYNAMICS_CONSOLIDATION_H_
+#define _SYNAPSE_DYNAMICS_CONSOLIDATION_H_
+
+#include <common-typedefs.h>
+
+//! The number of synapses the sweep may consolidate each timestep, read from
+//! the plasticity region; 0 disables the sweep
+extern uint32_t synapse_dynamics_consolidation_budget;
+
+//! \brief applies the post events since the row was last updated to each
+//! plastic synapse of a row in place, without adding a presynaptic event
+//! \param[in] plastic_region_address the plastic region of the row
+//! \param[in] fixed_region_address the fixed region of the row
+//! \param[in] time the current timestep
+//! \return the number of synapses updated
+uint32_t synapse_dynamics_consolidate_plastic_synapses(
+    address_t plastic_region_address, address_t fixed_region_address,
+    uint32_t time);
+
+#endif  // _SYNAPSE_DYNAMICS_CONSOLIDATION_H_
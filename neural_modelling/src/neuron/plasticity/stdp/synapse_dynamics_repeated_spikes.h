@@ -0,0 +1,32 @@
+/*! \file
+ * \brief Processing of a plastic row for several spikes from its source at
+ * once, used by synapses.c when built with TARGET_REPEATED_SPIKES.
+ *
+ * \details Spike coalescing fetches the row of a source once for all of its
+ * waiting spikes, which all arrive in the same timestep.  The first spike
+ * applies the post events since the row's last presynaptic spike and moves
+ * its pre-event history to this timestep; the window of the later ones is
+ * then empty, so each leaves the synapses as they are and only adds their
+ * weights to the ring buffers again.  The target rule does that in one pass
+ * over the row, with the same results as a pass per spike.
+ */
+
+#ifndef _SYNAPSE_DYNAMICS_REPEATED_SPIKES_H_
+#define _SYNAPSE_DYNAMICS_REPEATED_SPIKES_H_
+
+#include <common-typedefs.h>
+#include "../synapse_dynamics.h"
+
+//! \brief processes the plastic synapses of a row for n_spikes spikes from
+//! its source in the same timestep
+//! \param[in] plastic_region_address the plastic region of the row
+//! \param[in] fixed_region_address the fixed region of the row
+//! \param[in] ring_buffers the ring buffers to add the weights to
+//! \param[in] time the current timestep
+//! \param[in] n_spikes the number of spikes, at least 1
+//! \return false if the row couldn't be processed
+bool synapse_dynamics_process_repeated_plastic_synapses(
+    address_t plastic_region_address, address_t fixed_region_address,
+    weight_t *ring_buffers, uint32_t time, uint32_t n_spikes);
+
+#endif  // _SYNAPSE_DYNAMICS_REPEATED_SPIKES_H_
@@ -3,6 +3,15 @@
 
 // sPyNNaker neural modelling includes
 #include "../../synapses.h"
+#include "../../synapse_provenance.h"
+#include "../../changed_rows.h"
+#include "synapse_dynamics_consolidation.h"
+#include "synapse_dynamics_repeated_spikes.h"
+#ifdef TARGET_CHECKPOINT
+#include "../../extra_regions.h"
+#include "../../checkpoint.h"
+#include "synapse_dynamics_checkpoint.h"
+#endif  // TARGET_CHECKPOINT
 
 // Plasticity common includes
 #include "../common/maths.h"
@@ -52,22 +61,50 @@
 #error "Not enough bits for axonal synaptic delay bits"
 #endif
 
+// The furthest past the last presynaptic spike that the consolidation sweep
+// can record having applied post events to a row
+#define CONSOLIDATED_OFFSET_MAX 0xFFFF
+
 //---------------------------------------
 // Structures
 //---------------------------------------
 typedef struct {
+    // The target rule has no pre-trace, so this slot holds the number of
+    // timesteps after prev_time up to which post events have been applied
+    // by the consolidation sweep
     pre_trace_t prev_trace;
     uint32_t prev_time;
 } pre_event_history_t;
 
 post_event_history_t *post_event_history;
 
+uint32_t synapse_dynamics_consolidation_budget;
+
+#ifdef TARGET_CHECKPOINT
+uint32_t synapse_dynamics_checkpoint_time_base = 0;
+
+// The number of neurons with a post-event history
+static uint32_t n_post_neurons;
+
+//! \brief converts a timestep of this run into the time the rule works in,
+//! which counts from the start of training
+static inline uint32_t _rule_time(uint32_t time) {
+    return time + synapse_dynamics_checkpoint_time_base;
+}
+#else  // TARGET_CHECKPOINT
+
+static inline uint32_t _rule_time(uint32_t time) {
+    return time;
+}
+#endif  // TARGET_CHECKPOINT
+
 //---------------------------------------
 // Synapse update loop
 //---------------------------------------
 static inline final_state_t _plasticity_update_synapse(
         uint32_t time,
-        const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
+        const uint32_t last_pre_time, const uint32_t consolidated_time,
+        const pre_trace_t last_pre_trace,
         const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
         const uint32_t delay_axonal, update_state_t current_state,
         const post_event_history_t *post_event_history) {
@@ -77,8 +114,9 @@ static inline final_state_t _plasticity_update_synapse(
     // Apply axonal delay to time of last presynaptic spike
     const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
 
-    // Get the post-synaptic window of events to be processed
-    const uint32_t window_begin_time = delayed_last_pre_time;
+    // Get the post-synaptic window of events to be processed, skipping those
+    // the consolidation sweep has already applied
+    const uint32_t window_begin_time = consolidated_time + delay_axonal;
     const uint32_t window_end_time = time + delay_axonal;
     post_event_window_t post_window = post_events_get_window_delayed(
             post_event_history, window_begin_time, window_end_time);
@@ -139,6 +177,12 @@ static inline pre_event_history_t *_plastic_event_history(
     return (pre_event_history_t*) (&plastic_region_address[0]);
 }
 
+//---------------------------------------
+static inline uint32_t _consolidated_time(
+        const pre_event_history_t *event_history) {
+    return event_history->prev_time + (uint16_t) event_history->prev_trace;
+}
+
 void synapse_dynamics_print_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
@@ -184,12 +228,73 @@ static inline index_t _sparse_axonal_delay(uint32_t x) {
     return ((x >> SYNAPSE_DELAY_TYPE_INDEX_BITS) & SYNAPSE_AXONAL_DELAY_MASK);
 }
 
+#ifdef TARGET_CHECKPOINT
+//---------------------------------------
+// Checkpoint of the rule's state: the number of neurons, the time of the
+// last target and the post-event histories
+//---------------------------------------
+#define CHECKPOINT_HEADER_WORDS 2
+
+static inline uint32_t _checkpoint_size_bytes() {
+    return (CHECKPOINT_HEADER_WORDS * sizeof(uint32_t))
+        + (n_post_neurons * sizeof(post_event_history_t));
+}
+
+//! \brief restores the rule's state from the checkpoint region, if the host
+//! asked for it
+//! \return false if the checkpoint doesn't match this core
+static bool _checkpoint_restore() {
+    checkpoint_t *checkpoint = (checkpoint_t *) extra_regions_get(
+        CHECKPOINT_REGION);
+    if (checkpoint == NULL || !checkpoint->restore) {
+        return true;
+    }
+
+    if (checkpoint->dynamics_bytes != _checkpoint_size_bytes()
+            || checkpoint->data[0] != n_post_neurons) {
+        log_error("Checkpoint of %u bytes for %u neurons doesn't match %u"
+                  " neurons", checkpoint->dynamics_bytes,
+                  checkpoint->data[0], n_post_neurons);
+        return false;
+    }
+    last_target_time = checkpoint->data[1];
+    memcpy(post_event_history, &checkpoint->data[CHECKPOINT_HEADER_WORDS],
+           n_post_neurons * sizeof(post_event_history_t));
+    synapse_dynamics_checkpoint_time_base = checkpoint->time;
+    log_info("\tResuming plasticity from timestep %u", checkpoint->time);
+    return true;
+}
+
+uint32_t synapse_dynamics_checkpoint_save(address_t address,
+                                          uint32_t max_bytes) {
+    uint32_t size_bytes = _checkpoint_size_bytes();
+    if (size_bytes > max_bytes) {
+        return 0;
+    }
+    address[0] = n_post_neurons;
+    address[1] = last_target_time;
+    memcpy(&address[CHECKPOINT_HEADER_WORDS], post_event_history,
+           n_post_neurons * sizeof(post_event_history_t));
+    return size_bytes;
+}
+#else  // TARGET_CHECKPOINT
+
+static inline bool _checkpoint_restore() {
+    return true;
+}
+#endif  // TARGET_CHECKPOINT
+
 bool synapse_dynamics_initialise(
         address_t address, uint32_t n_neurons,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
 
+    // The consolidation budget precedes the timing dependence data
+    synapse_dynamics_consolidation_budget = address[0];
+    log_info("\tConsolidating up to %u synapses per timestep",
+             synapse_dynamics_consolidation_budget);
+
     // Load timing dependence data
-    address_t weight_region_address = timing_initialise(address);
+    address_t weight_region_address = timing_initialise(&address[1]);
     if (address == NULL) {
         return false;
     }
@@ -205,13 +310,71 @@ bool synapse_dynamics_initialise(
     if (post_event_history == NULL) {
         return false;
     }
+#ifdef TARGET_CHECKPOINT
+    n_post_neurons = n_neurons;
+#endif  // TARGET_CHECKPOINT
 
-    return true;
+    return _checkpoint_restore();
 }
 
-bool synapse_dynamics_process_plastic_synapses(
+//! \brief updates a plastic synapse for n_spikes presynaptic spikes and
+//! adds its weight to the ring buffers for each
+//! \return whether the weight of the synapse changed
+static inline bool _process_plastic_synapse(
+        uint32_t control_word, plastic_synapse_t *plastic_word,
+        weight_t *ring_buffers, uint32_t time, uint32_t n_spikes,
+        uint32_t rule_time,
+        const uint32_t last_pre_time, const uint32_t consolidated_time,
+        const pre_trace_t last_pre_trace, const pre_trace_t new_pre_trace) {
+
+    // Extract control-word components
+    // **NOTE** cunningly, control word is just the same as lower
+    // 16-bits of 32-bit fixed synapse so same functions can be used
+    uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
+    uint32_t delay_dendritic = synapse_row_sparse_delay(control_word);
+    uint32_t type = synapse_row_sparse_type(control_word);
+    uint32_t index = synapse_row_sparse_index(control_word);
+    uint32_t type_index = synapse_row_sparse_type_index(control_word);
+
+    //io_printf(IO_BUF,"current_weight:%u\n", *plastic_words);
+
+    // Create update state from the plastic synaptic word
+    update_state_t current_state = synapse_structure_get_update_state(
+        *plastic_word, type);
+
+    // Update the synapse state
+    final_state_t final_state = _plasticity_update_synapse(
+        rule_time, last_pre_time, consolidated_time, last_pre_trace,
+        new_pre_trace, delay_dendritic, delay_axonal,
+        current_state, &post_event_history[index]);
+    bool weight_changed = (synapse_structure_get_final_weight(final_state)
+                           != plastic_word->weight);
+
+    // Convert into ring buffer offset
+    uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
+            delay_axonal + delay_dendritic + time, type_index);
+
+    // Add weight to ring-buffer entry, once for each spike; the spikes after
+    // the first find no post events to apply, so leave the weight as it is
+    // **NOTE** Dave suspects that this could be a
+    // potential location for overflow
+    ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
+        final_state) * n_spikes;
+
+    // Write back updated synaptic word to plastic region
+    *plastic_word = synapse_structure_get_final_synaptic_word(final_state);
+    return weight_changed;
+}
+
+//! \brief processes the plastic synapses of a row for n_spikes spikes in
+//! the timestep
+static inline bool _process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time, uint32_t n_spikes) {
+
+    // The ring buffers are indexed by the timestep of this run, but the
+    // histories by the time since training started
+    const uint32_t rule_time = _rule_time(time);
 
     // Extract seperate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
@@ -222,10 +385,6 @@ bool synapse_dynamics_process_plastic_synapses(
     size_t plastic_synapse = synapse_row_num_plastic_controls(
         fixed_region_address);
 
-#ifdef SYNAPSE_BENCHMARK
-    num_plastic_pre_synaptic_events += plastic_synapse;
-#endif  // SYNAPSE_BENCHMARK
-
     // Get event history from synaptic row
     pre_event_history_t *event_history = _plastic_event_history(
         plastic_region_address);
@@ -233,56 +392,103 @@ bool synapse_dynamics_process_plastic_synapses(
     // Get last pre-synaptic event from event history
     const uint32_t last_pre_time = event_history->prev_time;
     const pre_trace_t last_pre_trace = event_history->prev_trace;
+    const uint32_t consolidated_time = _consolidated_time(event_history);
 
     // Update pre-synaptic trace
-    log_debug("Adding pre-synaptic event to trace at time:%u", time);
-    event_history->prev_time = time;
+    log_debug("Adding pre-synaptic event to trace at time:%u", rule_time);
+    event_history->prev_time = rule_time;
+    event_history->prev_trace = 0;
     //event_history->prev_trace = timing_add_pre_spike(time, last_pre_time,
     //                                                 last_pre_trace);
 
+    // Only the weights are read back by the host, so changes to the
+    // accumulators don't count
+    bool weights_changed = false;
+
+#ifdef SYNAPSE_BENCHMARK
+    num_plastic_pre_synaptic_events += plastic_synapse * n_spikes;
+#endif  // SYNAPSE_BENCHMARK
+
     // Loop through plastic synapses
     for (; plastic_synapse > 0; plastic_synapse--) {
+        weights_changed |= _process_plastic_synapse(
+            *control_words++, plastic_words++, ring_buffers, time, n_spikes,
+            rule_time, last_pre_time, consolidated_time, last_pre_trace,
+            event_history->prev_trace);
+    }
+    changed_rows_set_weights_changed(weights_changed);
+    return true;
+}
 
-        // Get next control word (autoincrementing)
-        uint32_t control_word = *control_words++;
+bool synapse_dynamics_process_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        weight_t *ring_buffers, uint32_t time) {
+    return _process_plastic_synapses(
+        plastic_region_address, fixed_region_address, ring_buffers, time, 1);
+}
 
-        // Extract control-word components
-        // **NOTE** cunningly, control word is just the same as lower
-        // 16-bits of 32-bit fixed synapse so same functions can be used
-        uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
+bool synapse_dynamics_process_repeated_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        weight_t *ring_buffers, uint32_t time, uint32_t n_spikes) {
+    return _process_plastic_synapses(
+        plastic_region_address, fixed_region_address, ring_buffers, time,
+        n_spikes);
+}
+
+uint32_t synapse_dynamics_consolidate_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t time) {
+    time = _rule_time(time);
+
+    // Get event history from synaptic row
+    pre_event_history_t *event_history = _plastic_event_history(
+        plastic_region_address);
+    const uint32_t last_pre_time = event_history->prev_time;
+    const uint32_t consolidated_time = _consolidated_time(event_history);
+
+    // Stop where the offset from the last presynaptic spike can be recorded;
+    // later events are left for that row's next spike
+    uint32_t end_time = time;
+    if ((end_time - last_pre_time) > CONSOLIDATED_OFFSET_MAX) {
+        end_time = last_pre_time + CONSOLIDATED_OFFSET_MAX;
+    }
+    if (end_time <= consolidated_time) {
+        changed_rows_set_weights_changed(false);
+        return 0;
+    }
+
+    plastic_synapse_t *plastic_words = _plastic_synapses(
+        plastic_region_address);
+    const control_t *control_words = synapse_row_plastic_controls(
+        fixed_region_address);
+    size_t plastic_synapse = synapse_row_num_plastic_controls(
+        fixed_region_address);
+    const size_t n_synapses = plastic_synapse;
+    bool weights_changed = false;
+
+    // Apply the window as the next spike would, but add nothing to the ring
+    // buffers
+    for (; plastic_synapse > 0; plastic_synapse--) {
+        uint32_t control_word = *control_words++;
         uint32_t delay_dendritic = synapse_row_sparse_delay(control_word);
         uint32_t type = synapse_row_sparse_type(control_word);
         uint32_t index = synapse_row_sparse_index(control_word);
-        uint32_t type_index = synapse_row_sparse_type_index(control_word);
-
-        //io_printf(IO_BUF,"current_weight:%u\n", *plastic_words);
 
-        // Create update state from the plastic synaptic word
         update_state_t current_state = synapse_structure_get_update_state(
             *plastic_words, type);
-
-        // Update the synapse state
         final_state_t final_state = _plasticity_update_synapse(
-            time, last_pre_time, last_pre_trace, event_history->prev_trace,
-            delay_dendritic, delay_axonal, current_state,
-            &post_event_history[index]);
-
-
-        // Convert into ring buffer offset
-        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay_axonal + delay_dendritic + time, type_index);
-
-        // Add weight to ring-buffer entry
-        // **NOTE** Dave suspects that this could be a
-        // potential location for overflow
-        ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
-            final_state);
-
-        // Write back updated synaptic word to plastic region
+            end_time, last_pre_time, consolidated_time,
+            event_history->prev_trace, event_history->prev_trace,
+            delay_dendritic, 0, current_state, &post_event_history[index]);
+        weights_changed |= (synapse_structure_get_final_weight(final_state)
+                            != plastic_words->weight);
         *plastic_words++ = synapse_structure_get_final_synaptic_word(
             final_state);
     }
-    return true;
+
+    event_history->prev_trace = (pre_trace_t) (end_time - last_pre_time);
+    changed_rows_set_weights_changed(weights_changed);
+    return n_synapses;
 }
 
 void synapse_dynamics_process_post_synaptic_event(
@@ -297,7 +503,9 @@ void synapse_dynamics_process_post_synaptic_event(
     // action potential (ap) is 1 if event comes from neuron, which it does in this function 
     last_post_trace.ap = 1;
     //io_printf(IO_BUF,"Adding spike to post event buffer at: %dms\n", time);
-    post_events_add(time, history, last_post_trace);
+    uint32_t post_event_start = synapse_provenance_start();
+    post_events_add(_rule_time(time), history, last_post_trace);
+    synapse_provenance_end(SYNAPSE_PROVENANCE_POST_EVENTS, post_event_start);
 }
 
 void synapse_dynamics_process_target_synaptic_event(
@@ -312,13 +520,13 @@ void synapse_dynamics_process_target_synaptic_event(
     // action potential (ap) is 0, denoting that event comes from target ring buffer
     last_post_trace.ap = 0;
 
-    post_events_add(time, history, last_post_trace);
+    post_events_add(_rule_time(time), history, last_post_trace);
 }
 
 input_t synapse_dynamics_get_intrinsic_bias(uint32_t time, index_t neuron_index) {
     use(time);
     use(neuron_index);
-    return 0.0k;
+    return 0;
 }
 
 //! \either prints the counters for plastic pre synaptic events based
@@ -1,4 +1,5 @@
 #include "timing_recurrent_dual_fsm_impl.h"
+#include "../weight_recording.h"
 
 //---------------------------------------
 // Globals
@@ -18,6 +19,9 @@ uint32_t *timing_initialise(address_t address) {
     log_info("timing_initialise: starting");
     log_info("\tRecurrent dual-FSM STDP rule");
 
+    // Weight recording precedes the parameters
+    address = weight_recording_initialise(address);
+
     // Copy plasticity region data from address
     // **NOTE** this seems somewhat safer than relying on sizeof
     plasticity_trace_region_data.accumulator_depression_plus_one =
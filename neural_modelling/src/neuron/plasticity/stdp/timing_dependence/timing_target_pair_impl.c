@@ -21,26 +21,26 @@ typedef int16_t pre_trace_t;
 // Macros
 //---------------------------------------
 // Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
 #define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
 #define TAU_MINUS_SIZE 256
 
-// Helper macros for looking up decays
-#define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
-#define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+// PSP kernel lookup parameters
+#define TAU_KERNEL_SIZE 256
 
 //---------------------------------------
 // Globals
 //---------------------------------------
-// Exponential lookup-tables
+#ifdef TARGET_PAIR_COMBINED_KERNEL
+// Difference-of-exponentials lookup-table and its time shift
+uint32_t tau_kernel_time_shift;
+int16_t psp_kernel_lookup[TAU_KERNEL_SIZE];
+#else
+// Exponential lookup-tables and their time shifts
+uint32_t tau_plus_time_shift;
+uint32_t tau_minus_time_shift;
 int16_t tau_plus_lookup[TAU_PLUS_SIZE];
 int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+#endif  // TARGET_PAIR_COMBINED_KERNEL
 
 //---------------------------------------
 // Functions
@@ -51,11 +51,27 @@ address_t timing_initialise(address_t address) {
     log_info("\tSTDP pair rule");
     // **TODO** assert number of neurons is less than max
 
+#ifdef TARGET_PAIR_COMBINED_KERNEL
+    // Copy time shift
+    tau_kernel_time_shift = address[0];
+    log_info("\tPSP kernel time shift=%u", tau_kernel_time_shift);
+
+    // Copy combined PSP kernel LUT from following memory
+    address_t lut_address = maths_copy_int16_lut(&address[1], TAU_KERNEL_SIZE,
+                                                 &psp_kernel_lookup[0]);
+#else
+    // Copy time shifts
+    tau_plus_time_shift = address[0];
+    tau_minus_time_shift = address[1];
+    log_info("\tTau plus time shift=%u, tau minus time shift=%u",
+             tau_plus_time_shift, tau_minus_time_shift);
+
     // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
+    address_t lut_address = maths_copy_int16_lut(&address[2], TAU_PLUS_SIZE,
                                                  &tau_plus_lookup[0]);
     lut_address = maths_copy_int16_lut(lut_address, TAU_MINUS_SIZE,
                                        &tau_minus_lookup[0]);
+#endif  // TARGET_PAIR_COMBINED_KERNEL
 
     log_info("timing_initialise: completed successfully");
 
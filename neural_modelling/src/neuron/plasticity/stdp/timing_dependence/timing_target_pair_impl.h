@@ -50,26 +50,43 @@ static update_state_t timing_apply_post_spike(
 //---------------------------------------
 // Macros
 //---------------------------------------
+// **NOTE** LUT time shifts are chosen on the host from the time constants
+// and the timestep, so long windows aren't truncated at 256 timesteps
+#ifdef TARGET_PAIR_COMBINED_KERNEL
+// PSP kernel lookup parameters - the host writes a single table holding
+// exp(-t / tau_plus) - exp(-t / tau_minus), so each event needs one lookup
+#define TAU_KERNEL_SIZE 256
+
+// Helper macro for looking up the PSP kernel
+#define PSP_KERNEL_LOOKUP(time) \
+    maths_lut_exponential_decay( \
+        time, tau_kernel_time_shift, TAU_KERNEL_SIZE, psp_kernel_lookup)
+#else
 // Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
 #define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
 #define TAU_MINUS_SIZE 256
 
 // Helper macros for looking up decays
 #define DECAY_LOOKUP_TAU_PLUS(time) \
     maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+        time, tau_plus_time_shift, TAU_PLUS_SIZE, tau_plus_lookup)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
     maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+        time, tau_minus_time_shift, TAU_MINUS_SIZE, tau_minus_lookup)
+#endif  // TARGET_PAIR_COMBINED_KERNEL
 
 //---------------------------------------
 // Externals
 //---------------------------------------
+#ifdef TARGET_PAIR_COMBINED_KERNEL
+extern uint32_t tau_kernel_time_shift;
+extern int16_t psp_kernel_lookup[TAU_KERNEL_SIZE];
+#else
+extern uint32_t tau_plus_time_shift;
+extern uint32_t tau_minus_time_shift;
 extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
 extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+#endif  // TARGET_PAIR_COMBINED_KERNEL
 
 //---------------------------------------
 // Timing dependence inline functions
@@ -102,8 +119,12 @@ static inline update_state_t timing_apply_post_spike(
     {
 
         // decayed state
+#ifdef TARGET_PAIR_COMBINED_KERNEL
+        int32_t PSP = PSP_KERNEL_LOOKUP(time_since_last_pre);
+#else
         int32_t PSP = DECAY_LOOKUP_TAU_PLUS( time_since_last_pre) -
                       DECAY_LOOKUP_TAU_MINUS(time_since_last_pre);
+#endif  // TARGET_PAIR_COMBINED_KERNEL
 
         // io_printf(IO_BUF,"time_since_last_pre: %dms\n", time_since_last_pre);
         log_debug("\t\t\ttime_since_last_pre_event=%u, PSP=%d\n", 
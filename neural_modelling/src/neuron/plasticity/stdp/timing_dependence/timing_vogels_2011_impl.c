@@ -1,4 +1,5 @@
 #include "timing_vogels_2011_impl.h"
+#include "../weight_recording.h"
 
 //---------------------------------------
 // Globals
@@ -16,12 +17,20 @@ uint32_t *timing_initialise(uint32_t* address)
 {
   log_info("timing_initialise: starting");
   log_info("\tVogels 2011 timing rule");
-  
+
+  // Weight recording precedes the parameters
+  address = weight_recording_initialise(address);
+
   // Copy parameters
   plasticity_trace_region_data.alpha = (int32_t)address[0];
-  
+  plasticity_trace_region_data.tau_time_shift = address[1];
+
+  log_info("\tAlpha=%d, tau time shift=%u",
+           plasticity_trace_region_data.alpha,
+           plasticity_trace_region_data.tau_time_shift);
+
   // Copy LUTs from following memory
-  address_t lut_address = maths_copy_int16_lut(&address[1], TAU_SIZE, &tau_lookup[0]);
+  address_t lut_address = maths_copy_int16_lut(&address[2], TAU_SIZE, &tau_lookup[0]);
 
   log_info("timing_initialise: completed successfully");
 
@@ -22,11 +22,11 @@ typedef int16_t pre_trace_t;
 // Macros
 //---------------------------------------
 // Exponential decay lookup parameters
-#define TAU_TIME_SHIFT 0
+// **NOTE** the time shift is chosen on the host from tau and the timestep
 #define TAU_SIZE 256
 
 // Helper macros for looking up decays
-#define DECAY_LOOKUP_TAU(time)  maths_lut_exponential_decay(time, TAU_TIME_SHIFT, TAU_SIZE, tau_lookup)
+#define DECAY_LOOKUP_TAU(time)  maths_lut_exponential_decay(time, plasticity_trace_region_data.tau_time_shift, TAU_SIZE, tau_lookup)
 
 //---------------------------------------
 // Structures
@@ -34,6 +34,7 @@ typedef int16_t pre_trace_t;
 typedef struct
 {
   int32_t alpha;
+  uint32_t tau_time_shift;
 } plasticity_trace_region_data_t;
 
 //---------------------------------------
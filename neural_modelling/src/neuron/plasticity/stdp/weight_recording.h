@@ -0,0 +1,75 @@
+/*! \file
+ * \brief Periodic recording of plastic weights while the simulation runs,
+ * into space at the start of the plasticity region, when built with
+ * SYNAPSE_WEIGHT_RECORDING.
+ *
+ * \details The timing rules which support it call
+ * weight_recording_initialise before reading their own parameters.  The
+ * host sets how often to snapshot and how many synapses to record; the
+ * recorded synapses are the plastic synapses of the first rows processed,
+ * in the order they are found, and each is listed in the slot table with
+ * the source key of its row and its neuron index.
+ *
+ * Every period timesteps a snapshot of the recorded weights is appended to
+ * the buffer, delta-encoded against the previous snapshot:
+ *
+ *     uint32_t time;
+ *     uint32_t n_slots;
+ *     uint32_t changed[(n_slots + 31) / 32];  // bit per slot
+ *     int16_t deltas[n changed];              // padded to a word
+ *
+ * so unchanged weights cost a bit each.  Recording stops, setting overflow,
+ * when what is left of the buffer couldn't hold a snapshot in which every
+ * weight changed.
+ */
+
+#ifndef _WEIGHT_RECORDING_H_
+#define _WEIGHT_RECORDING_H_
+
+#include <common-typedefs.h>
+
+//! Layout of the start of the plasticity region of rules which support
+//! weight recording; must match
+//! spynnaker_extra_pynn_models/neural_properties/synapse_dynamics/
+//! plastic_weight_recording.py
+typedef struct weight_recording_config_t {
+
+    // Written by the host; a period of 0 disables recording
+    uint32_t period;
+    uint32_t max_synapses;
+    uint32_t buffer_bytes;
+    uint32_t row_header_bytes;
+    uint32_t synapse_bytes;
+
+    // Written by the core
+    uint32_t n_slots;
+    uint32_t overflow;
+    uint32_t bytes_written;
+} weight_recording_config_t;
+
+typedef struct weight_recording_slot_t {
+    uint32_t key;
+    uint32_t index;
+} weight_recording_slot_t;
+
+//! \brief gets the address following the weight recording space
+static inline address_t weight_recording_end(address_t address) {
+    weight_recording_config_t *config = (weight_recording_config_t *) address;
+    return (address_t) (((uint8_t *) &config[1])
+        + (config->max_synapses * sizeof(weight_recording_slot_t))
+        + config->buffer_bytes);
+}
+
+#ifdef SYNAPSE_WEIGHT_RECORDING
+//! \brief sets up weight recording from the start of the plasticity region
+//! \param[in] address the start of the plasticity region
+//! \return the address of the timing rule's parameters, which follow
+address_t weight_recording_initialise(address_t address);
+#else  // SYNAPSE_WEIGHT_RECORDING
+
+static inline address_t weight_recording_initialise(address_t address) {
+    return weight_recording_end(address);
+}
+#endif  // SYNAPSE_WEIGHT_RECORDING
+
+#endif  // _WEIGHT_RECORDING_H_
@@ -0,0 +1,130 @@
+/*! \file
+ * \brief Per-timestep cycle counts of the synapse and plasticity phases,
+ * recorded into the SYNAPSE_PROVENANCE_REGION when built with
+ * SYNAPSE_PROVENANCE.
+ *
+ * \details Timer 2 is run free at the CPU clock, and each phase adds the
+ * cycles it takes to a per-timestep total.  At the start of each timestep the
+ * previous timestep's totals are folded into the region: a running total, the
+ * maximum per timestep and a histogram of per-timestep totals, in which
+ * bucket b counts timesteps using [2^(b - 1), 2^b) cycles and the last bucket
+ * counts everything larger.  The region is updated in place, so it can be
+ * read back even if the simulation ends with the core in an error state.
+ * The host writes only its first words, which say whether the row costs of
+ * synapse_row_costs.h follow the phases, and how many cycles a timer tick
+ * has.
+ *
+ * The timer callback of the application is also timed, by wrapping its
+ * registration at link time.  A timestep is busy from its tick until the end
+ * of the timer callback or of the last phase, whichever is later, and at
+ * each tick the last timestep is counted as an overrun if it was busy for
+ * more than the tick, or if the tick itself was late; otherwise its slack,
+ * the cycles left of the tick, is added to a histogram bucketed as the
+ * phases are.  spynnaker_extra_pynn_models/neuron/overrun_calibration.py
+ * feeds these back into the CPU estimates of the next run.
+ *
+ * Phases are measured inclusively: the fixed row phase includes the
+ * post-event insertion of any target synapses it processes, and phases
+ * interrupted by the timer include the timer callback.
+ */
+
+#ifndef _SYNAPSE_PROVENANCE_H_
+#define _SYNAPSE_PROVENANCE_H_
+
+#include <common-typedefs.h>
+#include <spin1_api.h>
+#include <spinnaker.h>
+
+#define SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS 20
+
+//! The phases which are timed; must match SYNAPSE_PROVENANCE_PHASES in
+//! spynnaker_extra_pynn_models/neuron/synapse_provenance.py
+typedef enum synapse_provenance_phase_e {
+    SYNAPSE_PROVENANCE_RING_BUFFER_DRAIN,
+    SYNAPSE_PROVENANCE_PLASTIC_ROWS,
+    SYNAPSE_PROVENANCE_FIXED_ROWS,
+    SYNAPSE_PROVENANCE_POST_EVENTS,
+    SYNAPSE_PROVENANCE_WRITEBACK,
+    SYNAPSE_PROVENANCE_CONSOLIDATION,
+    SYNAPSE_PROVENANCE_N_PHASES,
+} synapse_provenance_phase_e;
+
+typedef struct phase_provenance_t {
+    uint32_t total_cycles_low;
+    uint32_t total_cycles_high;
+    uint32_t max_timestep_cycles;
+    uint32_t timestep_histogram[SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS];
+} phase_provenance_t;
+
+//! Layout of the SYNAPSE_PROVENANCE_REGION
+typedef struct synapse_provenance_t {
+    //! Written by the host: whether a synapse_row_costs_t follows, and the
+    //! cycles of a timer tick, or 0 if timesteps don't keep to the timer
+    uint32_t record_row_costs;
+    uint32_t timer_period_cycles;
+
+    uint32_t n_timesteps;
+    uint32_t n_overruns;
+    uint32_t max_overrun_cycles;
+    uint32_t max_busy_cycles;
+    uint32_t slack_histogram[SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS];
+    phase_provenance_t phases[SYNAPSE_PROVENANCE_N_PHASES];
+} synapse_provenance_t;
+
+#ifdef SYNAPSE_PROVENANCE
+
+// Cycles spent in each phase so far this timestep
+extern uint32_t synapse_provenance_timestep_cycles[SYNAPSE_PROVENANCE_N_PHASES];
+
+// The cycle counter at the end of the last work of the timestep
+extern uint32_t synapse_provenance_busy_count;
+
+//! \brief locates the provenance region and starts the cycle counter; the
+//! rest of the functions do nothing if the region was not reserved
+//! \return nothing
+void synapse_provenance_initialise();
+
+//! \brief folds the cycles counted over the last timestep into the region
+//! \return nothing
+void synapse_provenance_end_timestep();
+
+//! \brief marks the start of a phase
+//! \return the cycle counter, to pass to synapse_provenance_end
+static inline uint32_t synapse_provenance_start() {
+    return tc[T2_COUNT];
+}
+
+//! \brief adds the cycles since synapse_provenance_start to a phase
+//! \param[in] phase the phase being timed
+//! \param[in] start_count the value returned by synapse_provenance_start
+//! \return nothing
+static inline void synapse_provenance_end(
+        synapse_provenance_phase_e phase, uint32_t start_count) {
+
+    // Timer 2 counts down
+    uint32_t end_count = tc[T2_COUNT];
+    synapse_provenance_timestep_cycles[phase] += start_count - end_count;
+    synapse_provenance_busy_count = end_count;
+}
+
+#else  // SYNAPSE_PROVENANCE
+
+static inline void synapse_provenance_initialise() {
+}
+
+static inline void synapse_provenance_end_timestep() {
+}
+
+static inline uint32_t synapse_provenance_start() {
+    return 0;
+}
+
+static inline void synapse_provenance_end(
+        synapse_provenance_phase_e phase, uint32_t start_count) {
+    use(phase);
+    use(start_count);
+}
+
+#endif  // SYNAPSE_PROVENANCE
+
+#endif  // _SYNAPSE_PROVENANCE_H_
@@ -0,0 +1,49 @@
+/*! \file
+ * \brief Cost of each synaptic row processed, recorded after the phases of
+ * the SYNAPSE_PROVENANCE_REGION when built with SYNAPSE_ROW_COSTS, if the
+ * host asks for them.
+ *
+ * \details Two things are recorded for each row that
+ * synapses_process_synaptic_row handles:
+ *
+ * - A histogram of row length (plastic plus fixed synapses) against cycles,
+ *   both bucketed by their number of significant bits.
+ * - The SYNAPSE_ROW_COSTS_HOT_ROWS source keys with the most total cycles,
+ *   tracked with the space-saving algorithm: a key which isn't tracked
+ *   replaces the cheapest tracked key, inheriting its total as error_cycles,
+ *   so total_cycles - error_cycles is a lower bound on the key's cost.
+ *
+ * Upstream spike_processing.c doesn't pass the source key of a row on, so
+ * the build wraps population_table_get_first_address and
+ * population_table_get_next_address at link time to queue the key of each
+ * row it starts a DMA for; rows are processed in the same order.  Both are kept in DTCM and copied to the region at the end of each
+ * timestep in which rows were processed.
+ */
+
+#ifndef _SYNAPSE_ROW_COSTS_H_
+#define _SYNAPSE_ROW_COSTS_H_
+
+#include <common-typedefs.h>
+
+#define SYNAPSE_ROW_COSTS_LENGTH_BUCKETS 10
+#define SYNAPSE_ROW_COSTS_CYCLE_BUCKETS 16
+#define SYNAPSE_ROW_COSTS_HOT_ROWS 16
+
+typedef struct row_cost_t {
+    uint32_t key;
+    uint32_t n_rows;
+    uint32_t total_cycles;
+    uint32_t max_cycles;
+    uint32_t error_cycles;
+} row_cost_t;
+
+//! Layout of the row costs after the synapse_provenance_t; must match
+//! spynnaker_extra_pynn_models/neuron/synapse_provenance.py
+typedef struct synapse_row_costs_t {
+    uint32_t histogram[SYNAPSE_ROW_COSTS_LENGTH_BUCKETS]
+                      [SYNAPSE_ROW_COSTS_CYCLE_BUCKETS];
+    uint32_t n_hot_rows;
+    row_cost_t hot_rows[SYNAPSE_ROW_COSTS_HOT_ROWS];
+} synapse_row_costs_t;
+
+#endif  // _SYNAPSE_ROW_COSTS_H_
@@ -2,15 +2,105 @@
 #include "spike_processing.h"
 #include "synapse_types/synapse_types.h"
 #include "plasticity/synapse_dynamics.h"
+#include "synapse_provenance.h"
+#include "changed_rows.h"
+#include "extra_regions.h"
+#ifdef SYNAPSE_ROW_COSTS
+#include "synapse_row_costs.h"
+#endif  // SYNAPSE_ROW_COSTS
+#ifdef TARGET_CONSOLIDATION
+#include "plasticity/stdp/synapse_dynamics_consolidation.h"
+#endif  // TARGET_CONSOLIDATION
+#ifdef TARGET_REPEATED_SPIKES
+#include "plasticity/stdp/synapse_dynamics_repeated_spikes.h"
+#endif  // TARGET_REPEATED_SPIKES
+#ifdef SYNAPSE_WEIGHT_RECORDING
+#include "plasticity/stdp/weight_recording.h"
+#endif  // SYNAPSE_WEIGHT_RECORDING
+#ifdef TARGET_CHECKPOINT
+#include "checkpoint.h"
+#include "plasticity/stdp/synapse_dynamics_checkpoint.h"
+#endif  // TARGET_CHECKPOINT
+#ifdef SYNAPSE_BACKGROUND_NOISE
+#include "background_noise.h"
+#endif  // SYNAPSE_BACKGROUND_NOISE
+#ifdef SYNAPSE_TURBO
+#include "turbo.h"
+#endif  // SYNAPSE_TURBO
+#ifdef NEURON_SKIP_IDLE
+#include "synapses_input_bitmap.h"
+#endif  // NEURON_SKIP_IDLE
+
+// Features which need the key or SDRAM address of each row processed, or
+// to know when the rows fetched have all been processed
+#if defined(SYNAPSE_ROW_COSTS) || defined(TARGET_CONSOLIDATION) \
+    || defined(SYNAPSE_CHANGED_ROWS) || defined(SYNAPSE_WEIGHT_RECORDING) \
+    || defined(SYNAPSE_SPIKE_COALESCING) || defined(SYNAPSE_TURBO) \
+    || defined(TARGET_CHECKPOINT)
+#define FETCHED_ROWS
+#include <neuron/population_table/population_table.h>
+#endif  // FETCHED_ROWS
+#if defined(SYNAPSE_SPIKE_COALESCING) || defined(SYNAPSE_TURBO)
+#include <common/in_spikes.h>
+#endif  // SYNAPSE_SPIKE_COALESCING || SYNAPSE_TURBO
+
+// Features which take over callbacks of the application, as it registers
+// them after synapses_initialise
+#if defined(SYNAPSE_PROVENANCE) || defined(SYNAPSE_TURBO)
+#define WRAPPED_CALLBACKS
+#endif  // WRAPPED_CALLBACKS
 #include <debug.h>
 #include <spin1_api.h>
 #include <string.h>
+#ifdef SYNAPSE_MATRIX_RESET
+#include <sark.h>
+#endif  // SYNAPSE_MATRIX_RESET
 
-// Compute the size of the input buffers and ring buffers
+// Compute the size of the input buffers and ring buffers; the
+// *_delay_bits_<bits> builds lower SYNAPSE_DELAY_BITS for populations whose
+// delays are all short, which shrinks the ring buffers
 #define INPUT_BUFFER_SIZE (1 << (SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS))
 #define RING_BUFFER_SIZE (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_BITS\
                                 + SYNAPSE_INDEX_BITS))
 
+// The buffers are sized by the row bit fields rather than the number of
+// neurons, so a build with more SYNAPSE_INDEX_BITS (for larger slices) must
+// leave DTCM for the per-neuron state; see dtcm_budget.py
+#if ((RING_BUFFER_SIZE * 2) + (INPUT_BUFFER_SIZE * 4)) > (48 * 1024)
+#error "Ring and input buffers leave too little DTCM for the neurons"
+#endif
+
+// The delay, type and index fields of a fixed synaptic word, below its
+// weight, are the offset of its ring buffer entry from the entries of the
+// current timestep, so the entry is found by adding the whole word to the
+// start of those entries and masking
+#define RING_BUFFER_MASK (RING_BUFFER_SIZE - 1)
+#define RING_BUFFER_TIME_SHIFT (SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS)
+#if (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS) > 16
+#error "The ring buffer offset of a synapse overlaps its weight"
+#endif
+
+#ifdef SYNAPSE_CODEBOOK_ROWS
+// Fixed synapses of codebook rows are half-words, with the code of the weight
+// in the bits above the ring buffer offset
+#define CODEBOOK_ROW_MARKER 0xFFFF
+#define CODEBOOK_OFFSET_BITS \
+    (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS)
+#define CODEBOOK_OFFSET_MASK ((1 << CODEBOOK_OFFSET_BITS) - 1)
+#define CODEBOOK_SIZE (1 << (16 - CODEBOOK_OFFSET_BITS))
+#if CODEBOOK_OFFSET_BITS > 15
+#error "A codebook row has no bits for the code of a synapse"
+#endif
+#endif  // SYNAPSE_CODEBOOK_ROWS
+
+#ifdef SYNAPSE_DELAY_BUCKETED_ROWS
+// Fixed synapses of delay-bucketed rows are grouped by delay and type
+#define DELAY_BUCKETED_ROW_MARKER 0xFFFE
+#if (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_BITS + SYNAPSE_INDEX_BITS) > 15
+#error "A synaptic word can look like the start of a delay-bucketed row"
+#endif
+#endif  // SYNAPSE_DELAY_BUCKETED_ROWS
+
 // Globals required for synapse benchmarking to work.
 #ifdef SYNAPSE_BENCHMARK
     uint32_t  num_fixed_pre_synaptic_events = 0;
@@ -19,6 +109,15 @@
 // The number of neurons
 static uint32_t n_neurons;
 
+// A bit for each synapse type whose synapses go to the post-event buffer
+// rather than the ring buffers; builds without a target synapse type know
+// there are none, so the checks for them compile out
+#ifdef SYNAPSE_NO_TARGET_TYPES
+#define target_synapse_types 0
+#else
+static uint32_t target_synapse_types = 0;
+#endif  // SYNAPSE_NO_TARGET_TYPES
+
 // Ring buffers to handle delays between synapses and neurons
 static weight_t ring_buffers[RING_BUFFER_SIZE];
 
@@ -34,9 +133,210 @@ static synapse_param_t *neuron_synapse_shaping_params[SYNAPSE_TYPE_COUNT];
 // Count of the number of times the ring buffers have saturated
 static uint32_t saturation_count = 0;
 
+#ifdef NEURON_SKIP_IDLE
+// Bit per neuron, set if the neuron has synaptic input this timestep
+uint32_t synapses_input_received[SYNAPSES_INPUT_BITMAP_WORDS];
+#endif  // NEURON_SKIP_IDLE
+
+#ifdef SYNAPSE_PROVENANCE
+// Cycles spent in each phase so far this timestep
+uint32_t synapse_provenance_timestep_cycles[SYNAPSE_PROVENANCE_N_PHASES];
+
+// The cycle counter at the end of the last work of the timestep
+uint32_t synapse_provenance_busy_count;
+
+// The provenance region, or NULL if the vertex didn't reserve it
+static synapse_provenance_t *synapse_provenance = NULL;
+
+// The timer callback of the application, and the cycle counter at its last
+// tick, if it has ticked
+static callback_t provenance_timer_callback;
+static uint32_t provenance_tick_count;
+static bool provenance_ticked = false;
+#endif  // SYNAPSE_PROVENANCE
+
+// The source key and SDRAM address of a row fetched by spike processing,
+// and the number of spikes from the source it is processed for
+typedef struct fetched_row_t {
+    uint32_t key;
+    address_t address;
+    uint32_t n_spikes;
+} fetched_row_t;
+
+#ifdef FETCHED_ROWS
+// The rows being fetched, in the order they will be processed
+#define FETCHED_ROWS_SIZE 4
+static fetched_row_t fetched_rows[FETCHED_ROWS_SIZE];
+static uint32_t fetched_rows_input = 0;
+static uint32_t fetched_rows_output = 0;
+#endif  // FETCHED_ROWS
+
+#ifdef SYNAPSE_ROW_COSTS
+// The row costs, and the region they are copied to if it was reserved
+static synapse_row_costs_t row_costs;
+static synapse_row_costs_t *row_costs_region = NULL;
+static bool row_costs_changed = false;
+#endif  // SYNAPSE_ROW_COSTS
+
+#ifdef TARGET_SCHEDULE
+// Target events written by the host in place of teacher populations, each
+// (timestep << SYNAPSE_INDEX_BITS) | neuron index, sorted by timestep
+static address_t target_schedule = NULL;
+static uint32_t target_schedule_n_events = 0;
+
+// The next target event to apply
+static uint32_t target_schedule_cursor = 0;
+#endif  // TARGET_SCHEDULE
+
+#ifdef SYNAPSE_CHANGED_ROWS
+// Whether the weights of the row just processed changed
+bool changed_rows_weights_changed;
+
+// The bitmap, or NULL if the vertex didn't reserve it, and the synaptic
+// matrix it covers
+static changed_rows_t *changed_rows = NULL;
+static uint32_t synaptic_matrix_address;
+#endif  // SYNAPSE_CHANGED_ROWS
+
+#ifdef SYNAPSE_WEIGHT_RECORDING
+// The weight recording space of the plasticity region, or NULL if the timing
+// rule isn't recording weights
+static weight_recording_config_t *weight_recording = NULL;
+static weight_recording_slot_t *weight_recording_slots;
+static uint8_t *weight_recording_buffer;
+
+// The SDRAM address of the weight of each slot, and its value when the last
+// snapshot was taken
+static weight_t **weight_recording_weights;
+static weight_t *weight_recording_previous;
+#endif  // SYNAPSE_WEIGHT_RECORDING
+
+#ifdef SYNAPSE_SPIKE_COALESCING
+// The most spikes a row is processed for at once, which keeps the product of
+// a weight and the number of spikes within a word
+#define SPIKE_COALESCING_MAX_SPIKES 256
+
+// Spikes whose row was processed along with an earlier spike from the same
+// source
+static uint32_t coalesced_spike_count = 0;
+#endif  // SYNAPSE_SPIKE_COALESCING
+
+#ifdef TARGET_CONSOLIDATION
+// Open-addressed set of the SDRAM addresses of the plastic rows which have
+// been processed, and so may have post events left to apply; only filled to
+// three quarters so that probes stay short
+#define CONSOLIDATION_ROWS_BITS 9
+#define CONSOLIDATION_ROWS (1 << CONSOLIDATION_ROWS_BITS)
+#define CONSOLIDATION_MAX_ROWS ((CONSOLIDATION_ROWS * 3) / 4)
+static address_t consolidation_rows[CONSOLIDATION_ROWS];
+static uint32_t consolidation_n_rows = 0;
+
+// The slot the next sweep starts from, so successive sweeps share the
+// budget out over all of the rows
+static uint32_t consolidation_cursor = 0;
+static bool consolidation_scheduled = false;
+
+// Rows whose plastic region writeback may still be queued behind the next
+// row's read; as reads complete in order, at most two
+#define CONSOLIDATION_WRITES_IN_FLIGHT 2
+static address_t consolidation_written_rows[CONSOLIDATION_WRITES_IN_FLIGHT];
+static uint32_t consolidation_written_rows_input = 0;
+
+// Below the timer, DMA and packet callbacks, so the sweep only uses time
+// which is left over in each timestep
+#define CONSOLIDATION_PRIORITY 3
+#endif  // TARGET_CONSOLIDATION
+
+#ifdef TARGET_CHECKPOINT
+// The checkpoint region, or NULL if the vertex didn't reserve it
+static checkpoint_t *checkpoint = NULL;
+
+// DMA_STAT bits set while a transfer is in progress or queued
+#define CHECKPOINT_DMA_BUSY 0x3
+
+// The synaptic matrix is copied into the checkpoint in the background, a
+// chunk at a time with interrupts disabled only while each is copied
+#define CHECKPOINT_CHUNK_BITS 7
+#define CHECKPOINT_CHUNK_BYTES (1 << CHECKPOINT_CHUNK_BITS)
+
+// Chunks copied each time the background copy runs before it reschedules
+#define CHECKPOINT_CHUNKS_PER_STEP 32
+
+// Below the timer, DMA and packet callbacks
+#define CHECKPOINT_PRIORITY 3
+
+// The synaptic matrix and its size
+static uint8_t *checkpoint_matrix;
+static uint32_t checkpoint_matrix_bytes;
+
+// Where the matrix is being copied to, or NULL if no copy is in progress
+static uint8_t *checkpoint_matrix_copy = NULL;
+
+// Bit per chunk of the matrix, set once it has been copied, and the next
+// chunk the background copy visits
+static uint32_t *checkpoint_copied_chunks;
+static uint32_t checkpoint_n_chunks;
+static uint32_t checkpoint_cursor;
+static bool checkpoint_copy_scheduled = false;
+
+// The time and size of the dynamics state of the checkpoint being copied,
+// written into the region once the matrix has been copied
+static uint32_t checkpoint_copy_time;
+static uint32_t checkpoint_copy_dynamics_bytes;
+static uint32_t checkpoint_copy_timesteps;
+#endif  // TARGET_CHECKPOINT
+
+#ifdef SYNAPSE_TURBO
+// The turbo region, or NULL if the vertex didn't reserve it
+static turbo_t *turbo = NULL;
+
+// The timer and packet callbacks of the application, which turbo mode calls
+static callback_t turbo_timer_callback = NULL;
+static uint32_t turbo_timer_priority;
+static callback_t turbo_packet_callback = NULL;
+
+// The last timestep the core finished and the one it is running, which are
+// the same between timesteps; timesteps count from 1
+static uint32_t turbo_time = 0;
+static uint32_t turbo_running_time = 0;
+static bool turbo_timestep_scheduled = false;
+
+// Ticks for which the core has been waiting for its neighbours
+static uint32_t turbo_ticks_waited = 0;
+
+// Done packets received for each of the timesteps from the one the core
+// is running or has just finished; a neighbour is at most a timestep ahead
+// unless its watchdog started one, so a few timesteps are counted, each in
+// the slot of its low bits along with the timestep it counts
+#define TURBO_DONE_TIMESTEPS 4
+static uint32_t turbo_done_times[TURBO_DONE_TIMESTEPS];
+static uint32_t turbo_done_counts[TURBO_DONE_TIMESTEPS];
+
+// Spikes of the timestep after the current one, from neighbours ahead
+static spike_t *turbo_early_spikes;
+static uint32_t turbo_n_early_spikes = 0;
+#endif  // SYNAPSE_TURBO
+
+#ifdef SYNAPSE_MATRIX_RESET
+// Tag of the SDRAM block holding each core's synaptic matrix as loaded,
+// offset by the core's ID; above those used by the runtime and the host
+#define MATRIX_RESET_TAG_BASE 0x80
+#endif  // SYNAPSE_MATRIX_RESET
+
 
 /* PRIVATE FUNCTIONS */
 
+// Whether a row has a plastic region; the rows of static builds never do,
+// so their plastic row handling compiles out
+static inline bool _has_plastic_region(synaptic_row_t row) {
+#ifdef SYNAPSE_STATIC_ONLY
+    use(row);
+    return false;
+#else
+    return synapse_row_plastic_size(row) > 0;
+#endif  // SYNAPSE_STATIC_ONLY
+}
+
 static inline void _print_synaptic_row(synaptic_row_t synaptic_row) {
 #if LOG_LEVEL >= LOG_DEBUG
     log_debug("Synaptic row, at address %08x Num plastic words:%u\n",
@@ -55,6 +355,21 @@ static inline void _print_synaptic_row(synaptic_row_t synaptic_row) {
     log_debug("Fixed region %u fixed synapses (%u plastic control words):\n",
               n_fixed_synapses,
               synapse_row_num_plastic_controls(fixed_region_address));
+#ifdef SYNAPSE_CODEBOOK_ROWS
+    if (n_fixed_synapses > 0 && (fixed_synapses[0] & CODEBOOK_ROW_MARKER)
+            == CODEBOOK_ROW_MARKER) {
+        log_debug("Codebook row of %u synapses\n", fixed_synapses[0] >> 16);
+        n_fixed_synapses = 0;
+    }
+#endif  // SYNAPSE_CODEBOOK_ROWS
+#ifdef SYNAPSE_DELAY_BUCKETED_ROWS
+    if (n_fixed_synapses > 0 && (fixed_synapses[0] & 0xFFFF)
+            == DELAY_BUCKETED_ROW_MARKER) {
+        log_debug("Delay-bucketed row of %u groups\n",
+                  fixed_synapses[0] >> 16);
+        n_fixed_synapses = 0;
+    }
+#endif  // SYNAPSE_DELAY_BUCKETED_ROWS
 
     for (uint32_t i = 0; i < n_fixed_synapses; i++) {
         uint32_t synapse = fixed_synapses[i];
@@ -73,7 +388,7 @@ static inline void _print_synaptic_row(synaptic_row_t synaptic_row) {
     }
 
     // If there's a plastic region
-    if (synapse_row_plastic_size(synaptic_row) > 0) {
+    if (_has_plastic_region(synaptic_row)) {
         log_debug("----------------------------------------\n");
         address_t plastic_region_address =
             synapse_row_plastic_region(synaptic_row);
@@ -150,63 +465,1399 @@ static inline void _print_inputs() {
 }
 
 
+// Gives the target events of a synapse to the post-event buffer, once for
+// each spike
+static inline void _add_target_events(uint32_t time, uint32_t index,
+                                      uint32_t n_spikes) {
+    uint32_t post_event_start = synapse_provenance_start();
+    for (uint32_t s = n_spikes; s > 0; s--) {
+        synapse_dynamics_process_target_synaptic_event(time, index);
+    }
+    synapse_provenance_end(SYNAPSE_PROVENANCE_POST_EVENTS, post_event_start);
+}
+
+// Adds the weight of a synapse to a ring buffer entry, once for each spike
+static inline void _add_to_ring_buffer(uint32_t ring_buffer_index,
+                                       uint32_t weight, uint32_t n_spikes) {
+
+    // Add weight to current ring buffer value
+    uint32_t accumulation = ring_buffers[ring_buffer_index]
+        + (weight * n_spikes);
+
+    // If any bit above the 16th is set, saturate accumulator at
+    // UINT16_MAX (0xFFFF)
+    // **NOTE** 0x10000 can be expressed as an ARM literal,
+    //          but 0xFFFF cannot.  Therefore, we use (0x10000 - 1)
+    //          to obtain this value
+    if (accumulation >> 16) {
+        accumulation = 0x10000 - 1;
+        saturation_count += 1;
+    }
+
+    // Store saturated value back in ring-buffer
+    ring_buffers[ring_buffer_index] = accumulation;
+}
+
+// Adds a synapse to its ring buffer entry, or gives it to the post-event
+// buffer if it is a target synapse; the offset holds the delay, type and
+// index of the synapse in the bits they have in a synaptic word
+static inline void _add_fixed_synapse(uint32_t ring_buffer_base,
+                                      uint32_t offset, uint32_t weight,
+                                      uint32_t time, uint32_t n_spikes) {
+
+    // if this is an input from a target synapse;
+    if (target_synapse_types & (1 << synapse_row_sparse_type(offset))) {
+
+        // bypass the ring buffer and neuron, goto postsynaptic event buffer
+        _add_target_events(time, synapse_row_sparse_index(offset), n_spikes);
+        return;
+    }
+
+    // The same entry as synapses_get_ring_buffer_index_combined finds
+    // from the delay, type and index of the synapse
+    _add_to_ring_buffer((ring_buffer_base + offset) & RING_BUFFER_MASK,
+                        weight, n_spikes);
+}
+
+#ifdef SYNAPSE_CODEBOOK_ROWS
+// The synapses of a fixed region which starts with a word whose low
+// half-word is CODEBOOK_ROW_MARKER are half-words, each the index of its
+// weight in the codebook at the start of the region above the ring buffer
+// offset of the synapse; see codebook_rows.py
+static inline void _process_codebook_synapses(uint32_t *synaptic_words,
+                                              uint32_t time,
+                                              uint32_t n_spikes) {
+    register uint32_t n_synapses = synaptic_words[0] >> 16;
+    register const uint16_t *codebook = (const uint16_t *) &synaptic_words[1];
+    register const uint16_t *synapses = &codebook[CODEBOOK_SIZE];
+
+#ifdef SYNAPSE_BENCHMARK
+    num_fixed_pre_synaptic_events += n_synapses * n_spikes;
+#endif // SYNAPSE_BENCHMARK
+
+    register uint32_t ring_buffer_base = time << RING_BUFFER_TIME_SHIFT;
+    for (; n_synapses > 0; n_synapses--) {
+        uint32_t synapse = *synapses++;
+        _add_fixed_synapse(ring_buffer_base, synapse & CODEBOOK_OFFSET_MASK,
+                           codebook[synapse >> CODEBOOK_OFFSET_BITS], time,
+                           n_spikes);
+    }
+}
+#endif  // SYNAPSE_CODEBOOK_ROWS
+
+#ifdef SYNAPSE_DELAY_BUCKETED_ROWS
+// The synapses of a fixed region which starts with a word whose low
+// half-word is DELAY_BUCKETED_ROW_MARKER (above the number of groups) are in
+// groups of the same delay and type, each a word of the ring buffer offset of
+// the group (above the number of synapses in the group) and a word of the
+// weight and index of each synapse; see delay_bucketed_rows.py
+static inline void _process_delay_bucketed_synapses(uint32_t *synaptic_words,
+                                                    uint32_t time,
+                                                    uint32_t n_spikes) {
+    register uint32_t n_groups = *synaptic_words++ >> 16;
+    register uint32_t ring_buffer_base = time << RING_BUFFER_TIME_SHIFT;
+    for (; n_groups > 0; n_groups--) {
+        uint32_t group = *synaptic_words++;
+        register uint32_t n_synapses = group >> 16;
+
+#ifdef SYNAPSE_BENCHMARK
+        num_fixed_pre_synaptic_events += n_synapses * n_spikes;
+#endif // SYNAPSE_BENCHMARK
+
+        if (target_synapse_types & (1 << synapse_row_sparse_type(group))) {
+            for (; n_synapses > 0; n_synapses--) {
+                _add_target_events(
+                    time, synapse_row_sparse_index(*synaptic_words++),
+                    n_spikes);
+            }
+            continue;
+        }
+
+        // The entries of the group's delay and type start here, so each
+        // synapse only adds its index
+        register uint32_t group_base =
+            (ring_buffer_base + group) & RING_BUFFER_MASK;
+        for (; n_synapses > 0; n_synapses--) {
+            uint32_t synaptic_word = *synaptic_words++;
+            _add_to_ring_buffer(
+                group_base + synapse_row_sparse_index(synaptic_word),
+                synapse_row_sparse_weight(synaptic_word), n_spikes);
+        }
+    }
+}
+#endif  // SYNAPSE_DELAY_BUCKETED_ROWS
+
 // This is the "inner loop" of the neural simulation.
 // Every spike event could cause upto 256 different weights to
-// be put into the ring buffer.
+// be put into the ring buffer.  A row processed for several spikes from its
+// source adds each weight that many times over.
 static inline void _process_fixed_synapses(address_t fixed_region_address,
-                                           uint32_t time) {
+                                           uint32_t time, uint32_t n_spikes) {
     register uint32_t *synaptic_words = synapse_row_fixed_weight_controls(
         fixed_region_address);
     register uint32_t fixed_synapse = synapse_row_num_fixed_synapses(
         fixed_region_address);
 
+#ifdef SYNAPSE_CODEBOOK_ROWS
+    if (fixed_synapse > 0 && (synaptic_words[0] & CODEBOOK_ROW_MARKER)
+            == CODEBOOK_ROW_MARKER) {
+        _process_codebook_synapses(synaptic_words, time, n_spikes);
+        return;
+    }
+#endif  // SYNAPSE_CODEBOOK_ROWS
+#ifdef SYNAPSE_DELAY_BUCKETED_ROWS
+    if (fixed_synapse > 0 && (synaptic_words[0] & 0xFFFF)
+            == DELAY_BUCKETED_ROW_MARKER) {
+        _process_delay_bucketed_synapses(synaptic_words, time, n_spikes);
+        return;
+    }
+#endif  // SYNAPSE_DELAY_BUCKETED_ROWS
+
 #ifdef SYNAPSE_BENCHMARK
-    num_fixed_pre_synaptic_events += fixed_synapse;
+    num_fixed_pre_synaptic_events += fixed_synapse * n_spikes;
 #endif // SYNAPSE_BENCHMARK
 
+    // The ring buffer entries of the current timestep start here
+    register uint32_t ring_buffer_base = time << RING_BUFFER_TIME_SHIFT;
+
     for (; fixed_synapse > 0; fixed_synapse--) {
 
         // Get the next 32 bit word from the synaptic_row
         // (should autoincrement pointer in single instruction)
         uint32_t synaptic_word = *synaptic_words++;
 
-        // if this is an input from a target synapse; 
-        if (strcmp(synapse_types_get_type_char(synapse_row_sparse_type(
-                                                   synaptic_word)), "T") == 0) {
-
-            // bypass the ring buffer and neuron, goto postsynaptic event buffer
-            synapse_dynamics_process_target_synaptic_event(time, 
-                                       synapse_row_sparse_index(synaptic_word));
-        }
-        else {
-            // Extract components from this word
-            uint32_t delay = synapse_row_sparse_delay(synaptic_word);
-            uint32_t combined_synapse_neuron_index = synapse_row_sparse_type_index(
-                    synaptic_word);
-            uint32_t weight = synapse_row_sparse_weight(synaptic_word);
-
-            // Convert into ring buffer offset
-            uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay + time, combined_synapse_neuron_index);
-
-            // Add weight to current ring buffer value
-            uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
-
-            // If 17th bit is set, saturate accumulator at UINT16_MAX (0xFFFF)
-            // **NOTE** 0x10000 can be expressed as an ARM literal,
-            //          but 0xFFFF cannot.  Therefore, we use (0x10000 - 1)
-            //          to obtain this value
-            uint32_t sat_test = accumulation & 0x10000;
-            if (sat_test) {
-                accumulation = sat_test - 1;
-                saturation_count += 1;
-            }
+        // The weight above the offset is masked off with the ring buffer
+        // index
+        _add_fixed_synapse(ring_buffer_base, synaptic_word,
+                           synapse_row_sparse_weight(synaptic_word), time,
+                           n_spikes);
+    }
+}
+
+#ifdef TARGET_SCHEDULE
+static void _target_schedule_initialise() {
+    address_t target_schedule_region = extra_regions_get(
+        TARGET_SCHEDULE_REGION);
+    if (target_schedule_region == NULL) {
+        return;
+    }
+    target_schedule_n_events = target_schedule_region[0];
+    target_schedule = &target_schedule_region[1];
+    log_info("Target schedule of %u events", target_schedule_n_events);
+}
+
+//! \brief applies the scheduled target events which are due, as if each had
+//! arrived through a target synapse of a teacher population
+//! \param[in] time the current timestep
+//! \return nothing
+static inline void _process_target_schedule(uint32_t time) {
+    while (target_schedule_cursor < target_schedule_n_events) {
+        uint32_t target_event = target_schedule[target_schedule_cursor];
+        if ((target_event >> SYNAPSE_INDEX_BITS) > time) {
+            break;
+        }
+        synapse_dynamics_process_target_synaptic_event(
+            time, target_event & SYNAPSE_INDEX_MASK);
+        target_schedule_cursor++;
+    }
+}
+#else  // TARGET_SCHEDULE
+
+static inline void _target_schedule_initialise() {
+}
+
+static inline void _process_target_schedule(uint32_t time) {
+    use(time);
+}
+#endif  // TARGET_SCHEDULE
+
+#ifdef SYNAPSE_BACKGROUND_NOISE
+//! A noisy neuron as the core keeps it
+typedef struct noise_source_t {
+    uint32_t exp_minus_lambda;
+
+    //! The weight above the synapse type and index, as in a synaptic word
+    uint32_t synaptic_word;
+} noise_source_t;
+
+static noise_source_t *noise_sources;
+static uint32_t n_noise_sources = 0;
+static mars_kiss_state_t noise_state;
+
+//! \brief copies the noisy neurons into DTCM, converting their weights into
+//! the units of the ring buffers
+//! \return false if there was no DTCM for them
+static bool _background_noise_initialise() {
+    background_noise_t *background_noise = (background_noise_t *)
+        extra_regions_get(BACKGROUND_NOISE_REGION);
+    if (background_noise == NULL || background_noise->n_sources == 0) {
+        return true;
+    }
+
+    noise_sources = (noise_source_t *) spin1_malloc(
+        background_noise->n_sources * sizeof(noise_source_t));
+    if (noise_sources == NULL) {
+        log_error("Cannot allocate background noise - Out of DTCM");
+        return false;
+    }
+    for (uint32_t i = 0; i < background_noise->n_sources; i++) {
+        background_noise_source_t *source = &background_noise->sources[i];
+        uint32_t left_shift = ring_buffer_to_input_left_shifts[
+            (source->type_index >> SYNAPSE_INDEX_BITS) & SYNAPSE_TYPE_MASK];
+        uint32_t weight = ((uint32_t) source->weight
+                           + ((1 << left_shift) >> 1)) >> left_shift;
+        if (weight > 0xFFFF) {
+            log_warning("Background noise weight of neuron %u saturates",
+                        source->type_index & SYNAPSE_INDEX_MASK);
+            weight = 0xFFFF;
+        }
+        noise_sources[i].exp_minus_lambda = source->exp_minus_lambda;
+        noise_sources[i].synaptic_word = (weight << 16) | source->type_index;
+    }
+    noise_state = background_noise->seed;
+    n_noise_sources = background_noise->n_sources;
+    log_info("Background noise into %u neurons", n_noise_sources);
+    return true;
+}
+
+//! \brief draws a Poisson number of events
+//! \param[in] exp_minus_lambda exp(-mean), as an unsigned 0.32 fraction
+//! \return the number of events
+static inline uint32_t _background_noise_draw(uint32_t exp_minus_lambda) {
+    uint32_t n_events = 0;
+    uint32_t product = mars_kiss_next(&noise_state);
+    while (product > exp_minus_lambda) {
+        n_events++;
+        product = (uint32_t) (((uint64_t) product
+                               * mars_kiss_next(&noise_state)) >> 32);
+    }
+    return n_events;
+}
 
-            // Store saturated value back in ring-buffer
-            ring_buffers[ring_buffer_index] = accumulation;
+//! \brief adds the background spikes of the timestep to the ring buffer
+//! entries about to be drained
+//! \param[in] time the current timestep
+static inline void _background_noise_add(uint32_t time) {
+    uint32_t ring_buffer_base = time << RING_BUFFER_TIME_SHIFT;
+    noise_source_t *source = noise_sources;
+    for (uint32_t i = n_noise_sources; i > 0; i--) {
+        uint32_t n_events = _background_noise_draw(source->exp_minus_lambda);
+        if (n_events > 0) {
+            _add_to_ring_buffer(
+                (ring_buffer_base + source->synaptic_word) & RING_BUFFER_MASK,
+                synapse_row_sparse_weight(source->synaptic_word), n_events);
         }
+        source++;
     }
 }
+#else  // SYNAPSE_BACKGROUND_NOISE
+
+static inline bool _background_noise_initialise() {
+    return true;
+}
+
+static inline void _background_noise_add(uint32_t time) {
+    use(time);
+}
+#endif  // SYNAPSE_BACKGROUND_NOISE
+
+
+#ifdef NEURON_SKIP_IDLE
+//! \brief publishes whether a neuron has any input this timestep, including
+//! shaped input still decaying from earlier timesteps
+static inline void _publish_input(index_t neuron_index) {
+    uint32_t input_bit = 1 << (neuron_index & 0x1F);
+    if (bitsk(synapse_types_get_excitatory_input(
+                input_buffers, neuron_index)) != 0
+            || bitsk(synapse_types_get_inhibitory_input(
+                input_buffers, neuron_index)) != 0) {
+        synapses_input_received[neuron_index >> 5] |= input_bit;
+    } else {
+        synapses_input_received[neuron_index >> 5] &= ~input_bit;
+    }
+}
+#else  // NEURON_SKIP_IDLE
+
+static inline void _publish_input(index_t neuron_index) {
+    use(neuron_index);
+}
+#endif  // NEURON_SKIP_IDLE
+
+#if defined(SYNAPSE_PROVENANCE) || defined(SYNAPSE_ROW_COSTS)
+static inline void _start_cycle_counter() {
+
+    // Run timer 2 free at the CPU clock as a 32-bit down counter
+    tc[T2_CONTROL] = 0;
+    tc[T2_LOAD] = 0;
+    tc[T2_CONTROL] = 0x82;
+}
+
+static inline uint32_t _bucket(uint32_t value, uint32_t n_buckets) {
+
+    // Bucket by the number of significant bits in the value
+    uint32_t bucket = (value == 0)? 0 : (32 - __builtin_clz(value));
+    return (bucket < n_buckets)? bucket : (n_buckets - 1);
+}
+#endif  // SYNAPSE_PROVENANCE || SYNAPSE_ROW_COSTS
+
+#ifdef TARGET_REPEATED_SPIKES
+// The target rule processes a row for all of its spikes in one pass
+static inline bool _process_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t time, uint32_t n_spikes) {
+    return synapse_dynamics_process_repeated_plastic_synapses(
+        plastic_region_address, fixed_region_address, ring_buffers, time,
+        n_spikes);
+}
+#else  // TARGET_REPEATED_SPIKES
+
+static inline bool _process_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t time, uint32_t n_spikes) {
+    for (uint32_t s = n_spikes; s > 0; s--) {
+        if (!synapse_dynamics_process_plastic_synapses(
+                plastic_region_address, fixed_region_address, ring_buffers,
+                time)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif  // TARGET_REPEATED_SPIKES
+
+#ifdef SYNAPSE_SPIKE_COALESCING
+//! \brief takes the spikes waiting to be processed which repeat the spike
+//! whose row is being fetched, so that the row is fetched and processed once
+//! for all of them; the spikes from other sources keep their order
+//! \param[in] spike the spike whose row is being fetched
+//! \return the number of spikes the row is to be processed for
+static uint32_t _coalesce_spikes(spike_t spike) {
+    uint32_t n_spikes = 1;
+
+    // Most rows are fetched with no spikes waiting, and a spike arriving now
+    // is processed after this one anyway
+    if (in_spikes_size() == 0) {
+        return n_spikes;
+    }
+
+    // Stop spikes arriving while the queue is rebuilt
+    uint32_t state = spin1_int_disable();
+    uint32_t n_waiting = in_spikes_size();
+    for (uint32_t i = 0; i < n_waiting; i++) {
+        spike_t waiting;
+        in_spikes_get_next_spike(&waiting);
+        if (waiting == spike && n_spikes < SPIKE_COALESCING_MAX_SPIKES) {
+            n_spikes++;
+        } else {
+            in_spikes_add_spike(waiting);
+        }
+    }
+    spin1_mode_restore(state);
+
+    coalesced_spike_count += n_spikes - 1;
+    return n_spikes;
+}
+#else  // SYNAPSE_SPIKE_COALESCING
+
+static inline uint32_t _coalesce_spikes(spike_t spike) {
+    use(spike);
+    return 1;
+}
+#endif  // SYNAPSE_SPIKE_COALESCING
+
+#ifdef SYNAPSE_TURBO
+uint __real_spin1_send_mc_packet(uint key, uint data, uint load);
+
+static void _turbo_timestep(uint unused0, uint unused1);
+
+static bool _turbo_initialise() {
+    turbo = (turbo_t *) extra_regions_get(TURBO_REGION);
+    if (turbo == NULL) {
+        return true;
+    }
+    turbo_early_spikes = (spike_t *) spin1_malloc(
+        TURBO_MAX_EARLY_SPIKES * sizeof(spike_t));
+    if (turbo_early_spikes == NULL) {
+        log_error("Cannot allocate the turbo mode spikes - Out of DTCM");
+        turbo = NULL;
+        return false;
+    }
+    turbo->n_timesteps = 0;
+    turbo->n_watchdog_timesteps = 0;
+    turbo->n_dropped_spikes = 0;
+    turbo->max_early_spikes = 0;
+    log_info("Turbo mode with %u neighbours", turbo->n_neighbours);
+    return true;
+}
+
+//! \brief gets the number of done packets received for a timestep
+static inline uint32_t _turbo_done_count(uint32_t time) {
+    uint32_t slot = time & (TURBO_DONE_TIMESTEPS - 1);
+    return (turbo_done_times[slot] == time)? turbo_done_counts[slot] : 0;
+}
+
+//! \brief counts a done packet of a timestep; those of timesteps the core
+//! has already started, which a watchdog started without them, are late
+//! and ignored, as are those too far ahead to count, which the watchdog
+//! will make up for
+static inline void _turbo_add_done(uint32_t time) {
+    if (time < turbo_running_time
+            || time >= (turbo_running_time + TURBO_DONE_TIMESTEPS)) {
+        return;
+    }
+    uint32_t slot = time & (TURBO_DONE_TIMESTEPS - 1);
+    if (turbo_done_times[slot] != time) {
+        turbo_done_times[slot] = time;
+        turbo_done_counts[slot] = 0;
+    }
+    turbo_done_counts[slot]++;
+}
+
+//! \brief tells whether the core has finished its timestep and processed
+//! the spikes of it, so that it only waits for its neighbours; must be
+//! called with interrupts disabled
+static inline bool _turbo_waiting() {
+    return turbo_time > 0 && turbo_running_time == turbo_time
+        && !turbo_timestep_scheduled && in_spikes_size() == 0
+        && fetched_rows_input == fetched_rows_output;
+}
+
+//! \brief schedules the next timestep if the core and its neighbours have
+//! all finished the last one
+static void _turbo_try_timestep() {
+    if (turbo == NULL) {
+        return;
+    }
+    uint32_t state = spin1_int_disable();
+    if (_turbo_waiting()
+            && _turbo_done_count(turbo_time) >= turbo->n_neighbours) {
+        turbo_timestep_scheduled = spin1_schedule_callback(
+            _turbo_timestep, 0, 0, turbo_timer_priority) == SUCCESS;
+        if (turbo_timestep_scheduled) {
+            turbo->n_timesteps++;
+        }
+    }
+    spin1_mode_restore(state);
+}
+
+//! \brief runs a timestep of the application, then lets in the spikes of
+//! it which arrived early and tells the neighbours it has finished
+static void _turbo_timestep(uint unused0, uint unused1) {
+    use(unused0);
+    use(unused1);
+
+    // From here on, done packets of the last timestep are late
+    turbo_timestep_scheduled = false;
+    turbo_ticks_waited = 0;
+    turbo_running_time = turbo_time + 1;
+    turbo_timer_callback(turbo_running_time, 0);
+
+    uint32_t state = spin1_int_disable();
+    turbo_time = turbo_running_time;
+    for (uint32_t i = 0; i < turbo_n_early_spikes; i++) {
+        turbo_packet_callback(turbo_early_spikes[i], 0);
+    }
+    turbo_n_early_spikes = 0;
+    spin1_mode_restore(state);
+
+    // The spikes of the timestep were sent before this, along the same routes
+    if (turbo->has_key) {
+        while (!__real_spin1_send_mc_packet(
+                turbo->key, TURBO_DONE_BIT | turbo_time, WITH_PAYLOAD)) {
+            spin1_delay_us(1);
+        }
+    }
+    _turbo_try_timestep();
+}
+
+//! \brief starts the first timestep on the first tick, which every core
+//! shares; after that, starts a timestep which the core has waited for its
+//! neighbours for watchdog_ticks ticks, in case a done packet was dropped
+static void _turbo_tick(uint ticks, uint unused) {
+    use(ticks);
+    use(unused);
+    if (turbo_running_time == 0) {
+        _turbo_timestep(0, 0);
+        return;
+    }
+
+    uint32_t state = spin1_int_disable();
+    bool waiting = _turbo_waiting();
+    spin1_mode_restore(state);
+    if (waiting && turbo->watchdog_ticks > 0
+            && ++turbo_ticks_waited >= turbo->watchdog_ticks) {
+        turbo->n_watchdog_timesteps++;
+        _turbo_timestep(0, 0);
+    }
+}
+
+//! \brief counts done packets, and passes spikes on to spike processing,
+//! holding those of the next timestep until the core starts it
+static void _turbo_packet_received(uint key, uint payload) {
+    if (payload & TURBO_DONE_BIT) {
+        _turbo_add_done(payload & ~TURBO_DONE_BIT);
+        _turbo_try_timestep();
+    } else if (payload <= turbo_time) {
+        turbo_packet_callback(key, 0);
+    } else if (turbo_n_early_spikes < TURBO_MAX_EARLY_SPIKES) {
+        turbo_early_spikes[turbo_n_early_spikes++] = key;
+        if (turbo_n_early_spikes > turbo->max_early_spikes) {
+            turbo->max_early_spikes = turbo_n_early_spikes;
+        }
+    } else {
+        turbo->n_dropped_spikes++;
+    }
+}
+
+//! \brief takes over the timer and packet callbacks of the application in
+//! turbo mode
+static void _turbo_take_callback(
+        uint *event_id, callback_t *cback, int priority) {
+    if (turbo != NULL && *event_id == TIMER_TICK) {
+        turbo_timer_callback = *cback;
+        turbo_timer_priority = priority;
+        *cback = _turbo_tick;
+    } else if (turbo != NULL && *event_id == MC_PACKET_RECEIVED) {
+
+        // Every packet between turbo cores has a payload
+        turbo_packet_callback = *cback;
+        *event_id = MCPL_PACKET_RECEIVED;
+        *cback = _turbo_packet_received;
+    }
+}
+
+//! \brief adds the timestep to each spike sent in turbo mode, as
+//! spin1_send_mc_packet is wrapped with this at link time
+uint __wrap_spin1_send_mc_packet(uint key, uint data, uint load) {
+    if (turbo != NULL && load == NO_PAYLOAD) {
+        return __real_spin1_send_mc_packet(
+            key, turbo_running_time, WITH_PAYLOAD);
+    }
+    return __real_spin1_send_mc_packet(key, data, load);
+}
+#else  // SYNAPSE_TURBO
+
+static inline bool _turbo_initialise() {
+    return true;
+}
+
+static inline void _turbo_try_timestep() {
+}
+
+static inline void _turbo_take_callback(
+        uint *event_id, callback_t *cback, int priority) {
+    use(event_id);
+    use(cback);
+    use(priority);
+}
+#endif  // SYNAPSE_TURBO
+
+#ifdef FETCHED_ROWS
+bool __real_population_table_get_first_address(
+    spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer);
+bool __real_population_table_get_next_address(
+    address_t* row_address, size_t* n_bytes_to_transfer);
+
+// The key of the last spike looked up, and the number of spikes its rows
+// are processed for
+static uint32_t fetched_spike_key;
+static uint32_t fetched_spike_n_spikes;
+
+static inline void _queue_fetched_row(address_t row_address) {
+    fetched_rows[fetched_rows_input].key = fetched_spike_key;
+    fetched_rows[fetched_rows_input].address = row_address;
+    fetched_rows[fetched_rows_input].n_spikes = fetched_spike_n_spikes;
+    fetched_rows_input = (fetched_rows_input + 1) & (FETCHED_ROWS_SIZE - 1);
+}
+
+//! \brief queues the key and address of the first row that spike processing
+//! fetches for a spike, as population_table_get_first_address is wrapped
+//! with this at link time, along with the repeats of the spike it coalesces
+bool __wrap_population_table_get_first_address(
+        spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer) {
+    bool found = __real_population_table_get_first_address(
+        spike, row_address, n_bytes_to_transfer);
+    if (found) {
+        fetched_spike_key = spike;
+        fetched_spike_n_spikes = _coalesce_spikes(spike);
+        _queue_fetched_row(*row_address);
+    } else {
+
+        // A spike with no row may have been the last of the timestep
+        _turbo_try_timestep();
+    }
+    return found;
+}
+
+//! \brief queues each further row that spike processing fetches for the
+//! last spike, as population_table_get_next_address is wrapped with this at
+//! link time; the rows of a source on several master population table
+//! entries are processed for the same spikes as its first row
+bool __wrap_population_table_get_next_address(
+        address_t* row_address, size_t* n_bytes_to_transfer) {
+    bool found = __real_population_table_get_next_address(
+        row_address, n_bytes_to_transfer);
+    if (found) {
+        _queue_fetched_row(*row_address);
+    }
+    return found;
+}
+
+//! \brief gets the row which is being processed; rows are processed in the
+//! order they were fetched
+static inline fetched_row_t _next_fetched_row() {
+    fetched_row_t fetched_row = fetched_rows[fetched_rows_output];
+    fetched_rows_output =
+        (fetched_rows_output + 1) & (FETCHED_ROWS_SIZE - 1);
+    return fetched_row;
+}
+#else  // FETCHED_ROWS
+
+static inline fetched_row_t _next_fetched_row() {
+    fetched_row_t fetched_row = {0, NULL, 1};
+    return fetched_row;
+}
+#endif  // FETCHED_ROWS
+
+#ifdef SYNAPSE_ROW_COSTS
+
+static void _row_costs_initialise() {
+    memset(&row_costs, 0, sizeof(synapse_row_costs_t));
+    synapse_provenance_t *provenance_region = (synapse_provenance_t *)
+        extra_regions_get(SYNAPSE_PROVENANCE_REGION);
+    if (provenance_region == NULL || !provenance_region->record_row_costs) {
+        return;
+    }
+    row_costs_region = (synapse_row_costs_t *) &provenance_region[1];
+    memset(row_costs_region, 0, sizeof(synapse_row_costs_t));
+    _start_cycle_counter();
+}
+
+static inline uint32_t _row_costs_start() {
+    if (row_costs_region == NULL) {
+        return 0;
+    }
+    return tc[T2_COUNT];
+}
+
+static void _row_costs_end(uint32_t key, address_t fixed_region_address,
+                           uint32_t start_count) {
+    if (row_costs_region == NULL) {
+        return;
+    }
+
+    // Timer 2 counts down
+    uint32_t cycles = start_count - tc[T2_COUNT];
+    uint32_t row_length =
+        synapse_row_num_fixed_synapses(fixed_region_address)
+        + synapse_row_num_plastic_controls(fixed_region_address);
+    row_costs.histogram
+        [_bucket(row_length, SYNAPSE_ROW_COSTS_LENGTH_BUCKETS)]
+        [_bucket(cycles, SYNAPSE_ROW_COSTS_CYCLE_BUCKETS)]++;
+    row_costs_changed = true;
+
+    // Find the key, or the cheapest tracked key to replace with it
+    row_cost_t *cheapest = NULL;
+    row_cost_t *hot_row = NULL;
+    for (uint32_t i = 0; i < row_costs.n_hot_rows; i++) {
+        row_cost_t *candidate = &row_costs.hot_rows[i];
+        if (candidate->key == key) {
+            hot_row = candidate;
+            break;
+        }
+        if (cheapest == NULL
+                || candidate->total_cycles < cheapest->total_cycles) {
+            cheapest = candidate;
+        }
+    }
+    if (hot_row == NULL) {
+        if (row_costs.n_hot_rows < SYNAPSE_ROW_COSTS_HOT_ROWS) {
+            hot_row = &row_costs.hot_rows[row_costs.n_hot_rows++];
+        } else {
+            hot_row = cheapest;
+            hot_row->error_cycles = hot_row->total_cycles;
+            hot_row->n_rows = 0;
+            hot_row->max_cycles = 0;
+        }
+        hot_row->key = key;
+    }
+
+    hot_row->n_rows++;
+    hot_row->total_cycles += cycles;
+    if (cycles > hot_row->max_cycles) {
+        hot_row->max_cycles = cycles;
+    }
+}
+
+static inline void _row_costs_end_timestep() {
+    if (row_costs_changed) {
+        memcpy(row_costs_region, &row_costs, sizeof(synapse_row_costs_t));
+        row_costs_changed = false;
+    }
+}
+#else  // SYNAPSE_ROW_COSTS
+
+static inline void _row_costs_initialise() {
+}
+
+static inline uint32_t _row_costs_start() {
+    return 0;
+}
+
+static inline void _row_costs_end(uint32_t key,
+                                  address_t fixed_region_address,
+                                  uint32_t start_count) {
+    use(key);
+    use(fixed_region_address);
+    use(start_count);
+}
+
+static inline void _row_costs_end_timestep() {
+}
+#endif  // SYNAPSE_ROW_COSTS
+
+#ifdef SYNAPSE_CHANGED_ROWS
+static void _changed_rows_initialise() {
+    changed_rows = (changed_rows_t *) extra_regions_get(CHANGED_ROWS_REGION);
+    if (changed_rows == NULL) {
+        return;
+    }
+    synaptic_matrix_address = (uint32_t) data_specification_get_region(
+        SYNAPTIC_MATRIX_REGION, data_specification_get_data_address());
+
+    // The host only writes the size, and clears the bits it reads
+    changed_rows->overflow = 0;
+    memset(changed_rows->bitmap, 0,
+           ((changed_rows->n_chunks + 31) >> 5) * sizeof(uint32_t));
+    log_info("Tracking changed weights in %u chunks of the synaptic matrix",
+             changed_rows->n_chunks);
+}
+
+static inline void _changed_rows_start() {
+
+    // Dynamics which don't say otherwise change every row they process
+    changed_rows_weights_changed = true;
+}
+
+//! \brief marks the chunks of the synaptic matrix holding the plastic
+//! region of a row as changed, if the dynamics changed any of its weights
+//! \param[in] row the SDRAM address of the row
+//! \param[in] n_plastic_words the size of the row's plastic region
+static void _changed_rows_end(address_t row, uint32_t n_plastic_words) {
+    if (changed_rows == NULL || !changed_rows_weights_changed) {
+        return;
+    }
+
+    uint32_t begin = (uint32_t) synapse_row_plastic_region(row)
+        - synaptic_matrix_address;
+    uint32_t end = begin + (n_plastic_words * sizeof(uint32_t));
+    for (uint32_t chunk = begin >> CHANGED_ROWS_CHUNK_BITS;
+            chunk <= ((end - 1) >> CHANGED_ROWS_CHUNK_BITS); chunk++) {
+        if (chunk >= changed_rows->n_chunks) {
+            changed_rows->overflow = 1;
+            break;
+        }
+        changed_rows->bitmap[chunk >> 5] |= 1 << (chunk & 0x1F);
+    }
+}
+#else  // SYNAPSE_CHANGED_ROWS
+
+static inline void _changed_rows_initialise() {
+}
+
+static inline void _changed_rows_start() {
+}
+
+static inline void _changed_rows_end(address_t row,
+                                     uint32_t n_plastic_words) {
+    use(row);
+    use(n_plastic_words);
+}
+#endif  // SYNAPSE_CHANGED_ROWS
+
+#ifdef SYNAPSE_WEIGHT_RECORDING
+address_t weight_recording_initialise(address_t address) {
+    weight_recording_config_t *config = (weight_recording_config_t *) address;
+    address_t end_address = weight_recording_end(address);
+    if (config->period == 0 || config->max_synapses == 0) {
+        return end_address;
+    }
+
+    weight_recording_weights = (weight_t **) spin1_malloc(
+        config->max_synapses * sizeof(weight_t *));
+    weight_recording_previous = (weight_t *) spin1_malloc(
+        config->max_synapses * sizeof(weight_t));
+    if (weight_recording_weights == NULL
+            || weight_recording_previous == NULL) {
+        log_warning("Cannot allocate weight recording - Out of DTCM");
+        return end_address;
+    }
+
+    config->n_slots = 0;
+    config->overflow = 0;
+    config->bytes_written = 0;
+    weight_recording_slots = (weight_recording_slot_t *) &config[1];
+    weight_recording_buffer =
+        (uint8_t *) &weight_recording_slots[config->max_synapses];
+    weight_recording = config;
+    log_info("Recording up to %u weights every %u timesteps",
+             config->max_synapses, config->period);
+    return end_address;
+}
+
+//! \brief gives the plastic synapses of a row slots to record, if there
+//! are slots left and the row hasn't been given them already
+//! \param[in] fetched_row the key and SDRAM address of the row
+//! \param[in] fixed_region_address the fixed region of the row
+static void _weight_recording_add_row(fetched_row_t fetched_row,
+                                      address_t fixed_region_address) {
+    if (weight_recording == NULL
+            || weight_recording->n_slots == weight_recording->max_synapses) {
+        return;
+    }
+    uint32_t n_plastic = synapse_row_num_plastic_controls(
+        fixed_region_address);
+    if (n_plastic == 0) {
+        return;
+    }
+
+    // The weight is the first field of each plastic synapse
+    uint8_t *first_weight = ((uint8_t *) synapse_row_plastic_region(
+        fetched_row.address)) + weight_recording->row_header_bytes;
+    for (uint32_t s = 0; s < weight_recording->n_slots; s++) {
+        if (weight_recording_weights[s] == (weight_t *) first_weight) {
+            return;
+        }
+    }
+
+    const control_t *control_words = synapse_row_plastic_controls(
+        fixed_region_address);
+    for (uint32_t i = 0; (i < n_plastic)
+            && (weight_recording->n_slots < weight_recording->max_synapses);
+            i++) {
+        uint32_t slot = weight_recording->n_slots;
+        weight_recording_slots[slot].key = fetched_row.key;
+        weight_recording_slots[slot].index =
+            synapse_row_sparse_index(control_words[i]);
+        weight_recording_weights[slot] = (weight_t *)
+            (first_weight + (i * weight_recording->synapse_bytes));
+        weight_recording_previous[slot] = 0;
+        weight_recording->n_slots = slot + 1;
+    }
+}
+
+//! \brief appends a snapshot of the recorded weights to the buffer if one
+//! is due, stopping if one in which every weight changed wouldn't fit
+//! \param[in] time the current timestep
+static void _weight_recording_snapshot(uint32_t time) {
+    if (weight_recording == NULL || weight_recording->overflow
+            || (time % weight_recording->period) != 0) {
+        return;
+    }
+
+    uint32_t n_slots = weight_recording->n_slots;
+    uint32_t n_changed_words = (n_slots + 31) >> 5;
+    uint32_t max_bytes = (2 * sizeof(uint32_t))
+        + (n_changed_words * sizeof(uint32_t))
+        + (((n_slots * sizeof(int16_t)) + 3) & ~3);
+    if ((weight_recording->bytes_written + max_bytes)
+            > weight_recording->buffer_bytes) {
+        weight_recording->overflow = 1;
+        return;
+    }
+
+    uint32_t *record = (uint32_t *)
+        &weight_recording_buffer[weight_recording->bytes_written];
+    record[0] = time;
+    record[1] = n_slots;
+    uint32_t *changed = &record[2];
+    int16_t *deltas = (int16_t *) &changed[n_changed_words];
+    uint32_t n_changed = 0;
+    uint32_t changed_word = 0;
+    for (uint32_t s = 0; s < n_slots; s++) {
+        weight_t weight = *weight_recording_weights[s];
+        if (weight != weight_recording_previous[s]) {
+            changed_word |= 1 << (s & 0x1F);
+            deltas[n_changed++] =
+                (int16_t) (weight - weight_recording_previous[s]);
+            weight_recording_previous[s] = weight;
+        }
+        if ((s & 0x1F) == 0x1F || s == (n_slots - 1)) {
+            changed[s >> 5] = changed_word;
+            changed_word = 0;
+        }
+    }
+
+    weight_recording->bytes_written += (2 * sizeof(uint32_t))
+        + (n_changed_words * sizeof(uint32_t))
+        + (((n_changed * sizeof(int16_t)) + 3) & ~3);
+}
+#else  // SYNAPSE_WEIGHT_RECORDING
+
+static inline void _weight_recording_add_row(fetched_row_t fetched_row,
+                                             address_t fixed_region_address) {
+    use(fetched_row.address);
+    use(fixed_region_address);
+}
+
+static inline void _weight_recording_snapshot(uint32_t time) {
+    use(time);
+}
+#endif  // SYNAPSE_WEIGHT_RECORDING
+
+#ifdef TARGET_CHECKPOINT
+//! \brief copies the synaptic matrix of a checkpoint over the one the host
+//! loaded, if the host asked for it; the synapse dynamics restore their own
+//! state when they are initialised
+//! \return false if the checkpoint doesn't match this core
+static bool _checkpoint_initialise() {
+    checkpoint = (checkpoint_t *) extra_regions_get(CHECKPOINT_REGION);
+    if (checkpoint == NULL) {
+        return true;
+    }
+    checkpoint_matrix = (uint8_t *) data_specification_get_region(
+        SYNAPTIC_MATRIX_REGION, data_specification_get_data_address());
+    checkpoint_matrix_bytes = extra_regions_get_size(SYNAPTIC_MATRIX_REGION);
+
+    if (checkpoint->checkpoint_time != CHECKPOINT_NEVER) {
+        checkpoint_n_chunks = (checkpoint_matrix_bytes
+            + (CHECKPOINT_CHUNK_BYTES - 1)) >> CHECKPOINT_CHUNK_BITS;
+        checkpoint_copied_chunks = (uint32_t *) spin1_malloc(
+            ((checkpoint_n_chunks + 31) >> 5) * sizeof(uint32_t));
+        if (checkpoint_copied_chunks == NULL) {
+            log_error("Cannot allocate the checkpoint chunks - Out of DTCM");
+            return false;
+        }
+    }
+    if (!checkpoint->restore) {
+        return true;
+    }
+
+    if (checkpoint->dynamics_bytes == 0
+            || checkpoint->matrix_bytes != checkpoint_matrix_bytes) {
+        log_error("Checkpoint of a %u byte synaptic matrix doesn't match"
+                  " the %u byte matrix loaded", checkpoint->matrix_bytes,
+                  checkpoint_matrix_bytes);
+        return false;
+    }
+    memcpy(checkpoint_matrix,
+           ((uint8_t *) checkpoint->data) + checkpoint->dynamics_bytes,
+           checkpoint_matrix_bytes);
+    log_info("Restored the synaptic matrix checkpointed at timestep %u",
+             checkpoint->time);
+    return true;
+}
+
+//! \brief copies a chunk of the synaptic matrix into the checkpoint, if it
+//! hasn't been already; called with interrupts disabled, so that a row
+//! can't be written back part way through
+//! \param[in] chunk the chunk to copy
+static void _checkpoint_copy_chunk(uint32_t chunk) {
+    uint32_t bit = 1 << (chunk & 0x1F);
+    if (checkpoint_copied_chunks[chunk >> 5] & bit) {
+        return;
+    }
+    uint32_t offset = chunk << CHECKPOINT_CHUNK_BITS;
+    uint32_t n_bytes = checkpoint_matrix_bytes - offset;
+    if (n_bytes > CHECKPOINT_CHUNK_BYTES) {
+        n_bytes = CHECKPOINT_CHUNK_BYTES;
+    }
+    memcpy(&checkpoint_matrix_copy[offset], &checkpoint_matrix[offset],
+           n_bytes);
+    checkpoint_copied_chunks[chunk >> 5] |= bit;
+}
+
+//! \brief copies the chunks holding the plastic region of a row into the
+//! checkpoint being taken before the row is changed, so that the checkpoint
+//! holds the matrix as it was at the checkpoint's timestep
+//! \param[in] row the SDRAM address of the row
+//! \param[in] n_plastic_words the size of the row's plastic region
+static void _checkpoint_row_changing(address_t row,
+                                     uint32_t n_plastic_words) {
+    if (checkpoint_matrix_copy == NULL || n_plastic_words == 0) {
+        return;
+    }
+
+    uint32_t begin = (uint32_t) synapse_row_plastic_region(row)
+        - (uint32_t) checkpoint_matrix;
+    uint32_t end = begin + (n_plastic_words * sizeof(uint32_t));
+    for (uint32_t chunk = begin >> CHECKPOINT_CHUNK_BITS;
+            chunk <= ((end - 1) >> CHECKPOINT_CHUNK_BITS); chunk++) {
+        _checkpoint_copy_chunk(chunk);
+    }
+}
+
+static void _checkpoint_copy_step(uint unused0, uint unused1);
+
+static inline void _checkpoint_schedule_copy() {
+    if (!checkpoint_copy_scheduled) {
+        checkpoint_copy_scheduled = spin1_schedule_callback(
+            _checkpoint_copy_step, 0, 0, CHECKPOINT_PRIORITY);
+    }
+}
+
+//! \brief copies the next chunks of the synaptic matrix in the time left
+//! over in each timestep, and completes the checkpoint once every chunk has
+//! been copied
+//! \param[in] unused0 unused
+//! \param[in] unused1 unused
+static void _checkpoint_copy_step(uint unused0, uint unused1) {
+    use(unused0);
+    use(unused1);
+    checkpoint_copy_scheduled = false;
+
+    for (uint32_t n = 0; (n < CHECKPOINT_CHUNKS_PER_STEP)
+            && (checkpoint_cursor < checkpoint_n_chunks); n++) {
+        uint32_t state = spin1_irq_disable();
+        _checkpoint_copy_chunk(checkpoint_cursor++);
+        spin1_mode_restore(state);
+    }
+    if (checkpoint_cursor < checkpoint_n_chunks) {
+        _checkpoint_schedule_copy();
+        return;
+    }
+
+    // The dynamics bytes are written last, as until then the host takes
+    // the checkpoint to be incomplete
+    uint32_t state = spin1_irq_disable();
+    checkpoint_matrix_copy = NULL;
+    checkpoint->time = checkpoint_copy_time;
+    checkpoint->matrix_bytes = checkpoint_matrix_bytes;
+    checkpoint->dynamics_bytes = checkpoint_copy_dynamics_bytes;
+    spin1_mode_restore(state);
+    log_info("Checkpointed at timestep %u, copied over %u timesteps",
+             checkpoint_copy_time, checkpoint_copy_timesteps);
+}
+
+//! \brief starts the checkpoint at the start of its timestep, so that it
+//! holds every spike processed before that timestep; the state of the
+//! dynamics is copied straight away, and the synaptic matrix in the
+//! background while spikes carry on being processed
+//! \param[in] time the current timestep
+static void _checkpoint_save(uint32_t time) {
+    if (checkpoint == NULL) {
+        return;
+    }
+
+    // Carry on a copy which couldn't be scheduled last timestep
+    if (checkpoint_matrix_copy != NULL) {
+        checkpoint_copy_timesteps++;
+        _checkpoint_schedule_copy();
+        return;
+    }
+    if (time != checkpoint->checkpoint_time) {
+        return;
+    }
+
+    // Let the writebacks of the last rows processed land; they are the
+    // only DMAs waited for with interrupts disabled
+    uint32_t state = spin1_irq_disable();
+    while (dma[DMA_STAT] & CHECKPOINT_DMA_BUSY) {
+        continue;
+    }
+
+    checkpoint->dynamics_bytes = 0;
+    uint32_t dynamics_bytes = 0;
+    if (checkpoint_matrix_bytes < checkpoint->capacity_bytes) {
+        dynamics_bytes = synapse_dynamics_checkpoint_save(
+            checkpoint->data,
+            checkpoint->capacity_bytes - checkpoint_matrix_bytes);
+    }
+    if (dynamics_bytes != 0) {
+        checkpoint_copy_time = time + synapse_dynamics_checkpoint_time_base;
+        checkpoint_copy_dynamics_bytes = dynamics_bytes;
+        checkpoint_copy_timesteps = 1;
+        checkpoint_cursor = 0;
+        memset(checkpoint_copied_chunks, 0,
+               ((checkpoint_n_chunks + 31) >> 5) * sizeof(uint32_t));
+        checkpoint_matrix_copy =
+            ((uint8_t *) checkpoint->data) + dynamics_bytes;
+    }
+    spin1_mode_restore(state);
+
+    if (dynamics_bytes == 0) {
+        log_warning("Checkpoint doesn't fit in %u bytes",
+                    checkpoint->capacity_bytes);
+        return;
+    }
+    _checkpoint_schedule_copy();
+}
+#else  // TARGET_CHECKPOINT
+
+static inline bool _checkpoint_initialise() {
+    return true;
+}
+
+static inline void _checkpoint_row_changing(address_t row,
+                                            uint32_t n_plastic_words) {
+    use(row);
+    use(n_plastic_words);
+}
+
+static inline void _checkpoint_save(uint32_t time) {
+    use(time);
+}
+#endif  // TARGET_CHECKPOINT
+
+#ifdef TARGET_CONSOLIDATION
+//! \brief adds a plastic row to the rows swept, if it isn't already one
+//! \param[in] row the SDRAM address of the row
+static void _consolidation_add_row(address_t row) {
+    uint32_t slot = ((uint32_t) row * 2654435761u)
+        >> (32 - CONSOLIDATION_ROWS_BITS);
+    while (consolidation_rows[slot] != NULL) {
+        if (consolidation_rows[slot] == row) {
+            return;
+        }
+        slot = (slot + 1) & (CONSOLIDATION_ROWS - 1);
+    }
+
+    if (consolidation_n_rows == CONSOLIDATION_MAX_ROWS) {
+        log_warning("Only the first %u plastic rows are consolidated",
+                    CONSOLIDATION_MAX_ROWS);
+        consolidation_n_rows++;
+    }
+    if (consolidation_n_rows < CONSOLIDATION_MAX_ROWS) {
+        consolidation_rows[slot] = row;
+        consolidation_n_rows++;
+    }
+}
+
+static inline void _consolidation_row_written(address_t row) {
+    consolidation_written_rows[consolidation_written_rows_input] = row;
+    consolidation_written_rows_input =
+        (consolidation_written_rows_input + 1)
+        % CONSOLIDATION_WRITES_IN_FLIGHT;
+}
+
+//! \brief checks if a DMA of the row may be in progress, in which case
+//! the copy being read or written back would undo the sweep's update
+static inline bool _consolidation_row_in_flight(address_t row) {
+    for (uint32_t i = fetched_rows_output; i != fetched_rows_input;
+            i = (i + 1) & (FETCHED_ROWS_SIZE - 1)) {
+        if (fetched_rows[i].address == row) {
+            return true;
+        }
+    }
+    for (uint32_t i = 0; i < CONSOLIDATION_WRITES_IN_FLIGHT; i++) {
+        if (consolidation_written_rows[i] == row) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! \brief consolidates rows from where the last sweep stopped until the
+//! budget of synapses is used up or every row has been visited
+//! \param[in] time the timestep the sweep was scheduled in
+//! \param[in] unused unused
+static void _consolidation_sweep(uint time, uint unused) {
+    use(unused);
+    consolidation_scheduled = false;
+
+    uint32_t budget = synapse_dynamics_consolidation_budget;
+    for (uint32_t n_slots = 0; (n_slots < CONSOLIDATION_ROWS) && (budget > 0);
+            n_slots++) {
+        address_t row = consolidation_rows[consolidation_cursor];
+        consolidation_cursor =
+            (consolidation_cursor + 1) & (CONSOLIDATION_ROWS - 1);
+        if (row == NULL) {
+            continue;
+        }
+
+        // Hold off spike processing so it can't fetch the row part way
+        // through its update
+        uint32_t state = spin1_irq_disable();
+        if (!_consolidation_row_in_flight(row)) {
+            uint32_t sweep_start = synapse_provenance_start();
+            _checkpoint_row_changing(row, synapse_row_plastic_size(row));
+            _changed_rows_start();
+            uint32_t n_synapses =
+                synapse_dynamics_consolidate_plastic_synapses(
+                    synapse_row_plastic_region(row),
+                    synapse_row_fixed_region(row), time);
+            _changed_rows_end(row, synapse_row_plastic_size(row));
+            synapse_provenance_end(SYNAPSE_PROVENANCE_CONSOLIDATION,
+                                   sweep_start);
+            budget = (n_synapses < budget)? (budget - n_synapses) : 0;
+        }
+        spin1_mode_restore(state);
+    }
+}
+
+static inline void _consolidation_schedule(uint32_t time) {
+    if ((synapse_dynamics_consolidation_budget > 0)
+            && (consolidation_n_rows > 0) && !consolidation_scheduled) {
+        consolidation_scheduled = spin1_schedule_callback(
+            _consolidation_sweep, time, 0, CONSOLIDATION_PRIORITY);
+    }
+}
+#else  // TARGET_CONSOLIDATION
+
+static inline void _consolidation_add_row(address_t row) {
+    use(row);
+}
+
+static inline void _consolidation_row_written(address_t row) {
+    use(row);
+}
+
+static inline void _consolidation_schedule(uint32_t time) {
+    use(time);
+}
+#endif  // TARGET_CONSOLIDATION
+
+#ifdef SYNAPSE_MATRIX_RESET
+//! \brief keeps a copy of the synaptic matrix as the host loaded it the
+//! first time the application runs, and copies it back over the matrix each
+//! time the application is restarted without being reloaded, so that every
+//! run of a parameter sweep starts from the same weights
+static void _matrix_reset_initialise() {
+    address_t matrix = data_specification_get_region(
+        SYNAPTIC_MATRIX_REGION, data_specification_get_data_address());
+    uint32_t matrix_bytes = extra_regions_get_size(SYNAPTIC_MATRIX_REGION);
+    uint32_t tag = MATRIX_RESET_TAG_BASE + spin1_get_core_id();
+
+    // Blocks tagged with the application ID outlive the run
+    address_t loaded_matrix = (address_t) sark_tag_ptr(tag, sark_app_id());
+    if (loaded_matrix != NULL) {
+        memcpy(matrix, loaded_matrix, matrix_bytes);
+        log_info("Reset the %u byte synaptic matrix", matrix_bytes);
+        return;
+    }
+
+    loaded_matrix = (address_t) sark_xalloc(
+        sv->sdram_heap, matrix_bytes, tag, ALLOC_LOCK | ALLOC_ID);
+    if (loaded_matrix == NULL) {
+        log_warning("No SDRAM to keep the synaptic matrix - restarted runs"
+                    " will carry on from the weights of the last run");
+        return;
+    }
+    memcpy(loaded_matrix, matrix, matrix_bytes);
+}
+#else  // SYNAPSE_MATRIX_RESET
+
+static inline void _matrix_reset_initialise() {
+}
+#endif  // SYNAPSE_MATRIX_RESET
+
+#ifdef SYNAPSE_PROVENANCE
+void synapse_provenance_initialise() {
+    for (uint32_t p = 0; p < SYNAPSE_PROVENANCE_N_PHASES; p++) {
+        synapse_provenance_timestep_cycles[p] = 0;
+    }
+
+    synapse_provenance = (synapse_provenance_t *) extra_regions_get(
+        SYNAPSE_PROVENANCE_REGION);
+    if (synapse_provenance == NULL) {
+        log_info("No synapse provenance region - not recording provenance");
+        return;
+    }
+
+    // Leave the host's words
+    memset(&synapse_provenance->n_timesteps, 0,
+           sizeof(synapse_provenance_t) - (2 * sizeof(uint32_t)));
+    _start_cycle_counter();
+}
+
+void synapse_provenance_end_timestep() {
+    if (synapse_provenance == NULL) {
+        return;
+    }
+
+    synapse_provenance->n_timesteps++;
+    for (uint32_t p = 0; p < SYNAPSE_PROVENANCE_N_PHASES; p++) {
+        uint32_t cycles = synapse_provenance_timestep_cycles[p];
+        synapse_provenance_timestep_cycles[p] = 0;
+        phase_provenance_t *phase = &synapse_provenance->phases[p];
+
+        // Add to the 64-bit total, carrying into the high word
+        uint32_t total_low = phase->total_cycles_low + cycles;
+        if (total_low < cycles) {
+            phase->total_cycles_high++;
+        }
+        phase->total_cycles_low = total_low;
+
+        if (cycles > phase->max_timestep_cycles) {
+            phase->max_timestep_cycles = cycles;
+        }
+
+        phase->timestep_histogram[
+            _bucket(cycles, SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS)]++;
+    }
+}
+
+//! \brief counts the last timestep as an overrun, or adds its slack to the
+//! histogram
+static inline void _provenance_end_tick(uint32_t busy, uint32_t elapsed) {
+    if (busy > synapse_provenance->max_busy_cycles) {
+        synapse_provenance->max_busy_cycles = busy;
+    }
+    uint32_t period = synapse_provenance->timer_period_cycles;
+    if (period == 0) {
+        return;
+    }
+
+    // A tick more than a little late was held up by the last timestep, even
+    // if by work which isn't timed
+    if (busy > period || elapsed > period + (period >> 4)) {
+        uint32_t overrun = ((busy > elapsed)? busy : elapsed) - period;
+        synapse_provenance->n_overruns++;
+        if (overrun > synapse_provenance->max_overrun_cycles) {
+            synapse_provenance->max_overrun_cycles = overrun;
+        }
+    } else {
+        synapse_provenance->slack_histogram[
+            _bucket(period - busy, SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS)]++;
+    }
+}
+
+//! \brief times the timer callback of the application, which is busy
+//! until it returns or until the last phase of its timestep ends
+static void _provenance_timer_tick(uint ticks, uint arg) {
+    uint32_t tick_count = tc[T2_COUNT];
+    if (provenance_ticked) {
+
+        // Timer 2 counts down
+        _provenance_end_tick(
+            provenance_tick_count - synapse_provenance_busy_count,
+            provenance_tick_count - tick_count);
+    }
+    provenance_tick_count = tick_count;
+    provenance_ticked = true;
+
+    provenance_timer_callback(ticks, arg);
+    synapse_provenance_busy_count = tc[T2_COUNT];
+}
+
+//! \brief takes over the timer callback of the application to time it
+static void _provenance_take_callback(uint event_id, callback_t *cback) {
+    if (synapse_provenance != NULL && event_id == TIMER_TICK) {
+        provenance_timer_callback = *cback;
+        *cback = _provenance_timer_tick;
+    }
+}
+#else  // SYNAPSE_PROVENANCE
+
+static inline void _provenance_take_callback(
+        uint event_id, callback_t *cback) {
+    use(event_id);
+    use(cback);
+}
+#endif  // SYNAPSE_PROVENANCE
+
+#ifdef WRAPPED_CALLBACKS
+void __real_spin1_callback_on(uint event_id, callback_t cback, int priority);
+
+//! \brief takes over callbacks of the application, as spin1_callback_on is
+//! wrapped with this at link time; in turbo mode, the timer callback taken
+//! over is the one which times the application's
+void __wrap_spin1_callback_on(uint event_id, callback_t cback, int priority) {
+    _provenance_take_callback(event_id, &cback);
+    _turbo_take_callback(&event_id, &cback, priority);
+    __real_spin1_callback_on(event_id, cback, priority);
+}
+#endif  // WRAPPED_CALLBACKS
 
 
 /* INTERFACE FUNCTIONS */
@@ -227,6 +1878,26 @@ bool synapses_initialise(address_t address, uint32_t n_neurons_value,
         ring_buffers[i] = 0;
     }
 
+#ifndef SYNAPSE_NO_TARGET_TYPES
+    // Find the synapse types of target synapses once, rather than for each
+    // synapse processed
+    target_synapse_types = 0;
+    for (index_t t = 0; t < SYNAPSE_TYPE_COUNT; t++) {
+        if (strcmp(synapse_types_get_type_char(t), "T") == 0) {
+            target_synapse_types |= 1 << t;
+        }
+    }
+#endif  // SYNAPSE_NO_TARGET_TYPES
+
+    synapse_provenance_initialise();
+    _row_costs_initialise();
+    _target_schedule_initialise();
+    _changed_rows_initialise();
+    _matrix_reset_initialise();
+    if (!_checkpoint_initialise()) {
+        return false;
+    }
+
     // Get the synapse shaping data
     if (sizeof(synapse_param_t) > 0) {
         for (index_t synapse_index = 0; synapse_index < SYNAPSE_TYPE_COUNT;
@@ -269,16 +1940,33 @@ bool synapses_initialise(address_t address, uint32_t n_neurons_value,
     }
     *ring_buffer_to_input_buffer_left_shifts = ring_buffer_to_input_left_shifts;
 
+    // The noise weights are converted with the left shifts
+    if (!_background_noise_initialise()) {
+        return false;
+    }
+
+    // Before the application registers the callbacks turbo mode takes over
+    if (!_turbo_initialise()) {
+        return false;
+    }
+
     log_info("synapses_initialise: completed successfully");
     return true;
 }
 
 void synapses_do_timestep_update(timer_t time) {
 
+    _checkpoint_save(time);
     _print_ring_buffers(time);
 
+    // Record the provenance of the previous timestep
+    synapse_provenance_end_timestep();
+    _row_costs_end_timestep();
+
     // Disable interrupts to stop DMAs interfering with the ring buffers
     uint32_t state = spin1_irq_disable();
+    uint32_t drain_start = synapse_provenance_start();
+    _background_noise_add(time);
 
     // Transfer the input from the ring buffers into the input buffers
     for (uint32_t neuron_index = 0; neuron_index < n_neurons;
@@ -308,18 +1996,34 @@ void synapses_do_timestep_update(timer_t time) {
             // Clear ring buffer
             ring_buffers[ring_buffer_index] = 0;
         }
+        _publish_input(neuron_index);
     }
 
+    synapse_provenance_end(SYNAPSE_PROVENANCE_RING_BUFFER_DRAIN, drain_start);
+
+    // Apply scheduled target events with the DMAs which read the post-event
+    // history still held off
+    uint32_t target_start = synapse_provenance_start();
+    _process_target_schedule(time);
+    synapse_provenance_end(SYNAPSE_PROVENANCE_POST_EVENTS, target_start);
+
     _print_inputs();
 
     // Re-enable the interrupts
     spin1_mode_restore(state);
+
+    _weight_recording_snapshot(time);
+
+    // Sweep the plastic rows once the rest of the timestep's work is done
+    _consolidation_schedule(time);
 }
 
 bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
                                    bool write, uint32_t process_id) {
 
     _print_synaptic_row(row);
+    uint32_t row_start = _row_costs_start();
+    fetched_row_t fetched_row = _next_fetched_row();
 
     // Get address of non-plastic region from row
     address_t fixed_region_address = synapse_row_fixed_region(row);
@@ -328,20 +2032,35 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
     //if (plastic_tag(row) == 0)
     //{
     // If this row has a plastic region
-    if (synapse_row_plastic_size(row) > 0) {
+    if (_has_plastic_region(row)) {
 
         // Get region's address
         address_t plastic_region_address = synapse_row_plastic_region(row);
 
-        // Process any plastic synapses
-        if (!synapse_dynamics_process_plastic_synapses(plastic_region_address,
-                fixed_region_address, ring_buffers, time)) {
+        // Process any plastic synapses for each spike, as separate fetches of
+        // the row would have
+        uint32_t plastic_start = synapse_provenance_start();
+        _changed_rows_start();
+        if (!_process_plastic_synapses(
+                plastic_region_address, fixed_region_address, time,
+                fetched_row.n_spikes)) {
+            _row_costs_end(fetched_row.key, fixed_region_address, row_start);
             return false;
         }
+        synapse_provenance_end(SYNAPSE_PROVENANCE_PLASTIC_ROWS, plastic_start);
+        _consolidation_add_row(fetched_row.address);
+        _changed_rows_end(fetched_row.address, synapse_row_plastic_size(row));
+        _weight_recording_add_row(fetched_row, fixed_region_address);
 
         // Perform DMA writeback
         if (write) {
+            uint32_t writeback_start = synapse_provenance_start();
+            _checkpoint_row_changing(
+                fetched_row.address, synapse_row_plastic_size(row));
             spike_processing_finish_write(process_id);
+            synapse_provenance_end(SYNAPSE_PROVENANCE_WRITEBACK,
+                                   writeback_start);
+            _consolidation_row_written(fetched_row.address);
         }
     }
 
@@ -349,8 +2068,13 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
     // **NOTE** this is done after initiating DMA in an attempt
     // to hide cost of DMA behind this loop to improve the chance
     // that the DMA controller is ready to read next synaptic row afterwards
-    _process_fixed_synapses(fixed_region_address, time);
+    uint32_t fixed_start = synapse_provenance_start();
+    _process_fixed_synapses(fixed_region_address, time, fetched_row.n_spikes);
+    synapse_provenance_end(SYNAPSE_PROVENANCE_FIXED_ROWS, fixed_start);
     //}
+
+    _row_costs_end(fetched_row.key, fixed_region_address, row_start);
+    _turbo_try_timestep();
     return true;
 }
 
@@ -358,6 +2082,10 @@ void synapses_print_saturation_count() {
     if (saturation_count > 0) {
         log_warning("Ring buffer saturation events: %d\n", saturation_count);
     }
+#ifdef SYNAPSE_SPIKE_COALESCING
+    log_info("Spikes coalesced into the rows of earlier spikes: %u",
+             coalesced_spike_count);
+#endif  // SYNAPSE_SPIKE_COALESCING
 }
 
 //! \either prints the counters for plastic and fixed pre synaptic events based
@@ -0,0 +1,26 @@
+/*! \file
+ * \brief Per-timestep "received input" bitmap, published by synapses.c when
+ * built with NEURON_SKIP_IDLE for the neuron loop of neuron.c.
+ *
+ * \details A neuron's bit is set by synapses_do_timestep_update when either
+ * of its input buffers is non-zero after the current timestep's ring buffer
+ * entries have been added, so the neuron loop can pass over the neurons
+ * whose bit is clear, 32 at a time.
+ */
+
+#ifndef _SYNAPSES_INPUT_BITMAP_H_
+#define _SYNAPSES_INPUT_BITMAP_H_
+
+#include <neuron/synapse_row.h>
+
+//---------------------------------------
+// Macros
+//---------------------------------------
+#define SYNAPSES_INPUT_BITMAP_WORDS (((1 << SYNAPSE_INDEX_BITS) + 31) >> 5)
+
+//---------------------------------------
+// Externals
+//---------------------------------------
+extern uint32_t synapses_input_received[SYNAPSES_INPUT_BITMAP_WORDS];
+
+#endif  // _SYNAPSES_INPUT_BITMAP_H_
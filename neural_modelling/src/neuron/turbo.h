@@ -0,0 +1,66 @@
+/*! \file
+ * \brief Turbo mode, in which a core starts each timestep as soon as its
+ * neighbours have finished the last one rather than on the timer tick, when
+ * built with SYNAPSE_TURBO and the TURBO_REGION is reserved.
+ *
+ * \details Offline runs don't need to keep to real time, and a lightly
+ * loaded network spends most of each tick waiting for the next.  In turbo
+ * mode:
+ *
+ * - every packet the core sends carries the timestep it was sent in, and
+ *   after each timestep the core sends a done packet with its key, which
+ *   its routes take to every core it sends spikes to;
+ * - the host adds a route back from each core to the cores which send it
+ *   spikes, so that every core hears from all of its neighbours, and no
+ *   core gets more than one timestep ahead of any of them;
+ * - the core starts timestep t + 1 once each of its neighbours has sent its
+ *   done packet of timestep t and the spikes of t have been processed, so
+ *   every spike lands in the ring buffer entry it would have in real time.
+ *
+ * Spikes of the timestep after the current one, from neighbours which are
+ * ahead, wait in DTCM until the core starts that timestep.  The first
+ * timestep starts on the first timer tick, which all cores share; after
+ * that, ticks only restart a core which has waited for watchdog_ticks of
+ * them, in case a done packet was dropped.
+ *
+ * Upstream c_main.c and spike_processing.c register their timer and packet
+ * callbacks after synapses_initialise has read the region, so the build
+ * wraps spin1_callback_on at link time to take them over, and
+ * spin1_send_mc_packet to add the timestep to each spike.
+ */
+
+#ifndef _TURBO_H_
+#define _TURBO_H_
+
+#include <common-typedefs.h>
+
+//! Set in the payload of a done packet, below which is its timestep
+#define TURBO_DONE_BIT 0x80000000
+
+//! The most spikes of the next timestep held while waiting for it; as many
+//! as upstream's input spike buffer can take at once
+#define TURBO_MAX_EARLY_SPIKES 256
+
+//! Layout of the TURBO_REGION; must match
+//! spynnaker_extra_pynn_models/neuron/turbo.py
+typedef struct turbo_t {
+
+    //! Written by the host: whether the core has a key to send done packets
+    //! with, the key, the number of cores which route packets to the core,
+    //! and the ticks to wait for them before starting a timestep anyway, or
+    //! 0 to wait for as long as it takes
+    uint32_t has_key;
+    uint32_t key;
+    uint32_t n_neighbours;
+    uint32_t watchdog_ticks;
+
+    //! Written by the core: the timesteps started by the neighbours' done
+    //! packets and by the watchdog, the spikes of the next timestep dropped
+    //! for want of space, and the most held at once
+    uint32_t n_timesteps;
+    uint32_t n_watchdog_timesteps;
+    uint32_t n_dropped_spikes;
+    uint32_t max_early_spikes;
+} turbo_t;
+
+#endif  // _TURBO_H_
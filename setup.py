@@ -6,6 +6,7 @@ setup(
     description="Extra models not in PyNN",
     url="https://github.com/SpiNNakerManchester/sPyNNakerExtraModelsPlugin",
     packages=['spynnaker_extra_pynn_models',
+              'spynnaker_extra_pynn_models.neuron',
               'spynnaker_extra_pynn_models.model_binaries',
               'spynnaker_extra_pynn_models.neural_properties',
               'spynnaker_extra_pynn_models.neural_properties.synapse_dynamics',
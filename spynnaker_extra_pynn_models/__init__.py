@@ -25,5 +25,8 @@ from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
 from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
     .dependences.vogels_2011_time_dependency\
     import Vogels2011Rule
-from spynnaker.pyNN.models.neural_models.if_curr_target_exp \
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
+    .dependences.target_pair_time_dependency\
+    import TargetPairRule
+from spynnaker_extra_pynn_models.neuron.neural_models.if_curr_target_exp \
     import IFCurrentTargetExponentialPopulation as IF_curr_target_exp
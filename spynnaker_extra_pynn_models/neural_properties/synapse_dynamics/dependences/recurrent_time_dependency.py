@@ -1,5 +1,3 @@
-import math
-
 from data_specification.enums.data_type import DataType
 
 from spynnaker.pyNN.models.neural_properties.synapse_dynamics.abstract_rules.\
@@ -9,11 +7,17 @@ from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
     import PlasticWeightControlSynapseRowIo
 from spynnaker.pyNN.models.neural_properties.synapse_dynamics\
     import plasticity_helpers
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
+    import plasticity_lut_helpers
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics.\
+    plastic_weight_recording import WeightRecording
 
 
 class RecurrentTimeDependency(AbstractTimeDependency):
     def __init__(self, accumulator_depression=-6, accumulator_potentiation=6,
-                 mean_pre_window=35.0, mean_post_window=35.0, dual_fsm=True):
+                 mean_pre_window=35.0, mean_post_window=35.0, dual_fsm=True,
+                 weight_recording_interval=None, max_recorded_synapses=256,
+                 weight_recording_bytes=65536):
         AbstractTimeDependency.__init__(self)
 
         self.accumulator_depression_plus_one = accumulator_depression + 1
@@ -21,6 +25,9 @@ class RecurrentTimeDependency(AbstractTimeDependency):
         self.mean_pre_window = mean_pre_window
         self.mean_post_window = mean_post_window
         self.dual_fsm = dual_fsm
+        self.weight_recording = WeightRecording(
+            weight_recording_interval, max_recorded_synapses,
+            weight_recording_bytes)
 
     def __eq__(self, other):
         if (other is None) or (not isinstance(other, RecurrentTimeDependency)):
@@ -46,15 +53,23 @@ class RecurrentTimeDependency(AbstractTimeDependency):
             synaptic_row_header_words, dendritic_delay_fraction, False)
 
     def get_params_size_bytes(self):
+        # Weight recording
         # 2 * 32-bit parameters
         # 2 * LUTS with STDP_FIXED_POINT_ONE * 16-bit entries
-        return (4 * 2) + (2 * (2 * plasticity_helpers.STDP_FIXED_POINT_ONE))
+        return (self.weight_recording.size_bytes + (4 * 2) +
+                (2 * (2 * plasticity_helpers.STDP_FIXED_POINT_ONE)))
 
     def is_time_dependance_rule_part(self):
         return True
 
     def write_plastic_params(self, spec, machineTimeStep, weight_scales,
                              global_weight_scale):
+        # Weight recording comes first; synapses are a 16-bit weight and a
+        # 16-bit control word
+        self.weight_recording.write(
+            spec, machineTimeStep, self.pre_trace_size_bytes, self.num_terms,
+            4)
+
         # Write parameters
         spec.write_value(data=self.accumulator_depression_plus_one,
                          data_type=DataType.INT32)
@@ -87,11 +102,24 @@ class RecurrentTimeDependency(AbstractTimeDependency):
         # otherwise it's in the synapse
         return 2 if self.dual_fsm else 0
 
-    def _write_exp_dist_lut(self, spec, mean):
-        for x in range(plasticity_helpers.STDP_FIXED_POINT_ONE):
-            # Calculate inverse CDF
-            x_float = float(x) / float(plasticity_helpers.STDP_FIXED_POINT_ONE)
-            p_float = math.log(1.0 - x_float) * -mean
+    @property
+    def accumulator_depression(self):
+        return self.accumulator_depression_plus_one - 1
+
+    @accumulator_depression.setter
+    def accumulator_depression(self, accumulator_depression):
+        self.accumulator_depression_plus_one = accumulator_depression + 1
 
-            p = round(p_float)
-            spec.write_value(data=p, data_type=DataType.UINT16)
+    @property
+    def accumulator_potentiation(self):
+        return self.accumulator_potentiation_minus_one + 1
+
+    @accumulator_potentiation.setter
+    def accumulator_potentiation(self, accumulator_potentiation):
+        self.accumulator_potentiation_minus_one = accumulator_potentiation - 1
+
+    def _write_exp_dist_lut(self, spec, mean):
+        plasticity_lut_helpers.write_lut(
+            spec, plasticity_lut_helpers.get_exp_dist_lut(
+                mean, plasticity_helpers.STDP_FIXED_POINT_ONE),
+            DataType.UINT16)
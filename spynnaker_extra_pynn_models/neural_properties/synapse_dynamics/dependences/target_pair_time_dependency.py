@@ -0,0 +1,159 @@
+from data_specification.enums.data_type import DataType
+
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics.abstract_rules.\
+    abstract_time_dependency import AbstractTimeDependency
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
+    plastic_weight_control_synapse_row_io\
+    import PlasticWeightControlSynapseRowIo
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
+    import plasticity_lut_helpers
+
+import logging
+logger = logging.getLogger(__name__)
+
+# Constants
+LOOKUP_TAU_PLUS_SIZE = 256
+LOOKUP_TAU_MINUS_SIZE = 256
+
+# Combined PSP kernel LUT size (matches TAU_KERNEL_SIZE on the core)
+LOOKUP_KERNEL_SIZE = 256
+
+
+class TargetPairRule(AbstractTimeDependency):
+    """ Supervised (target) pair rule, where the update applied at each\
+        target or output spike is the difference-of-exponentials PSP\
+        kernel evaluated at the time since the last presynaptic spike.
+
+        By default the core looks the kernel up in a tau_plus and a\
+        tau_minus LUT.  With combined_kernel=True the kernel is precomputed\
+        here and written as a single LUT, run by the *_pair_kernel_* build,\
+        so the core makes one lookup per event.  Each entry is the\
+        difference of the individually rounded tau_plus and tau_minus\
+        entries, so weights are identical to the two-table format when all\
+        three LUTs have the same time shift, as with the default time\
+        constants; a longer tau_plus covered with a larger shift than\
+        tau_minus samples the kernel more coarsely.
+
+        Updates are deferred until the next presynaptic spike fetches a\
+        row, so the updates of an input which falls silent can wait\
+        indefinitely.  With consolidation_synapses_per_timestep > 0, the\
+        core instead applies them in the background, updating up to that\
+        many synapses in the time left over in each timestep.
+    """
+
+    def __init__(self, tau_plus=20.0, tau_minus=5.0, combined_kernel=False,
+                 consolidation_synapses_per_timestep=0):
+        AbstractTimeDependency.__init__(self)
+
+        self._tau_plus = tau_plus
+        self._tau_minus = tau_minus
+        self._combined_kernel = combined_kernel
+        self._consolidation_synapses_per_timestep = \
+            consolidation_synapses_per_timestep
+
+    def __eq__(self, other):
+        if (other is None) or (not isinstance(other, TargetPairRule)):
+            return False
+        return ((self._tau_plus == other._tau_plus) and
+                (self._tau_minus == other._tau_minus) and
+                (self._combined_kernel == other._combined_kernel) and
+                (self._consolidation_synapses_per_timestep ==
+                 other._consolidation_synapses_per_timestep))
+
+    def __ne__(self, other):
+        """
+        comparison  method for comparing TargetPairRule
+        :param other: instance of TargetPairRule
+        :return:
+        """
+        return not self.__eq__(other)
+
+    def create_synapse_row_io(
+            self, synaptic_row_header_words, dendritic_delay_fraction):
+        return PlasticWeightControlSynapseRowIo(
+            synaptic_row_header_words, dendritic_delay_fraction, False)
+
+    def get_params_size_bytes(self):
+        # The consolidation budget, LUT time shift words and the LUTs
+        if self._combined_kernel:
+            return (4 * 2) + (2 * LOOKUP_KERNEL_SIZE)
+        return (4 * 3) + (2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE))
+
+    def is_time_dependance_rule_part(self):
+        return True
+
+    def write_plastic_params(self, spec, machine_time_step, weight_scales,
+                             global_weight_scale):
+
+        # Read by the synapse dynamics before the timing dependence data
+        spec.write_value(data=self._consolidation_synapses_per_timestep,
+                         data_type=DataType.UINT32)
+
+        if self._combined_kernel:
+            self._write_psp_kernel_lut(spec, machine_time_step)
+        else:
+
+            # Choose time shifts so the LUTs cover the whole of each decay
+            tau_plus_shift = plasticity_lut_helpers.get_lut_time_shift(
+                self._tau_plus, machine_time_step, LOOKUP_TAU_PLUS_SIZE)
+            tau_minus_shift = plasticity_lut_helpers.get_lut_time_shift(
+                self._tau_minus, machine_time_step, LOOKUP_TAU_MINUS_SIZE)
+            spec.write_value(data=tau_plus_shift, data_type=DataType.UINT32)
+            spec.write_value(data=tau_minus_shift, data_type=DataType.UINT32)
+
+            # Write lookup tables
+            plasticity_lut_helpers.write_exp_lut(
+                spec, self._tau_plus, machine_time_step,
+                LOOKUP_TAU_PLUS_SIZE, tau_plus_shift)
+            plasticity_lut_helpers.write_exp_lut(
+                spec, self._tau_minus, machine_time_step,
+                LOOKUP_TAU_MINUS_SIZE, tau_minus_shift)
+
+    def _write_psp_kernel_lut(self, spec, machine_time_step):
+
+        # The kernel lasts as long as its slowest exponential
+        kernel_shift = plasticity_lut_helpers.get_lut_time_shift(
+            max(self._tau_plus, self._tau_minus), machine_time_step,
+            LOOKUP_KERNEL_SIZE)
+        spec.write_value(data=kernel_shift, data_type=DataType.UINT32)
+
+        # Round each exponential separately, as the two-table format does
+        plus_lut = plasticity_lut_helpers.get_exp_lut(
+            self._tau_plus, machine_time_step, LOOKUP_KERNEL_SIZE,
+            kernel_shift)
+        minus_lut = plasticity_lut_helpers.get_exp_lut(
+            self._tau_minus, machine_time_step, LOOKUP_KERNEL_SIZE,
+            kernel_shift)
+        plasticity_lut_helpers.write_lut(spec, plus_lut - minus_lut)
+
+    @property
+    def num_terms(self):
+        return 1
+
+    @property
+    def vertex_executable_suffix(self):
+        if self._combined_kernel:
+            return "pair_kernel"
+        return "pair"
+
+    @property
+    def pre_trace_size_bytes(self):
+        # Pre-traces are not used by the target rule; the history just
+        # holds the 16-bit trace slot
+        return 2
+
+    @property
+    def tau_plus(self):
+        return self._tau_plus
+
+    @property
+    def tau_minus(self):
+        return self._tau_minus
+
+    @property
+    def combined_kernel(self):
+        return self._combined_kernel
+
+    @property
+    def consolidation_synapses_per_timestep(self):
+        return self._consolidation_synapses_per_timestep
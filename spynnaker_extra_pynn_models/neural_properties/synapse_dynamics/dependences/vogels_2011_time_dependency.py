@@ -6,22 +6,29 @@ from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
     plastic_weight_synapse_row_io import PlasticWeightSynapseRowIo
 from spynnaker.pyNN.models.neural_properties.synapse_dynamics\
     import plasticity_helpers
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
+    import plasticity_lut_helpers
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics.\
+    plastic_weight_recording import WeightRecording
 
 import logging
 logger = logging.getLogger(__name__)
 
 # Constants
 LOOKUP_TAU_SIZE = 256
-LOOKUP_TAU_SHIFT = 0
 
 
 class Vogels2011Rule(AbstractTimeDependency):
 
-    def __init__(self, alpha, tau=20.0):
+    def __init__(self, alpha, tau=20.0, weight_recording_interval=None,
+                 max_recorded_synapses=256, weight_recording_bytes=65536):
         AbstractTimeDependency.__init__(self)
 
         self._alpha = alpha
         self._tau = tau
+        self._weight_recording = WeightRecording(
+            weight_recording_interval, max_recorded_synapses,
+            weight_recording_bytes)
 
     def __eq__(self, other):
         if (other is None) or (not isinstance(other, Vogels2011Rule)):
@@ -42,7 +49,9 @@ class Vogels2011Rule(AbstractTimeDependency):
             synaptic_row_header_words, dendritic_delay_fraction)
 
     def get_params_size_bytes(self):
-        return 4 + (2 * LOOKUP_TAU_SIZE)
+        # Weight recording, alpha, LUT time shift and LUT
+        return (self._weight_recording.size_bytes + (4 * 2) +
+                (2 * LOOKUP_TAU_SIZE))
 
     def is_time_dependance_rule_part(self):
         return True
@@ -50,20 +59,26 @@ class Vogels2011Rule(AbstractTimeDependency):
     def write_plastic_params(self, spec, machine_time_step, weight_scales,
                              global_weight_scale):
 
-        # Check timestep is valid
-        if machine_time_step != 1000:
-            raise NotImplementedError("STDP LUT generation currently only "
-                                      "supports 1ms timesteps")
+        # Weight recording comes first; synapses are just a 16-bit weight
+        self._weight_recording.write(
+            spec, machine_time_step, self.pre_trace_size_bytes,
+            self.num_terms, 2)
 
         # Write alpha to spec
         fixed_point_alpha = plasticity_helpers.float_to_fixed(
             self._alpha, plasticity_helpers.STDP_FIXED_POINT_ONE)
         spec.write_value(data=fixed_point_alpha, data_type=DataType.INT32)
 
+        # Choose a time shift so the LUT covers the whole decay at this
+        # timestep, rather than truncating it at LOOKUP_TAU_SIZE timesteps
+        tau_shift = plasticity_lut_helpers.get_lut_time_shift(
+            self.tau, machine_time_step, LOOKUP_TAU_SIZE)
+        spec.write_value(data=tau_shift, data_type=DataType.UINT32)
+
         # Write lookup table
-        plasticity_helpers.write_exp_lut(spec, self.tau,
-                                         LOOKUP_TAU_SIZE,
-                                         LOOKUP_TAU_SHIFT)
+        plasticity_lut_helpers.write_exp_lut(spec, self.tau,
+                                             machine_time_step,
+                                             LOOKUP_TAU_SIZE, tau_shift)
 
     @property
     def num_terms(self):
@@ -78,6 +93,22 @@ class Vogels2011Rule(AbstractTimeDependency):
         # Trace entries consist of a single 16-bit number
         return 2
 
+    @property
+    def alpha(self):
+        return self._alpha
+
+    @alpha.setter
+    def alpha(self, alpha):
+        self._alpha = alpha
+
     @property
     def tau(self):
         return self._tau
+
+    @tau.setter
+    def tau(self, tau):
+        self._tau = tau
+
+    @property
+    def weight_recording(self):
+        return self._weight_recording
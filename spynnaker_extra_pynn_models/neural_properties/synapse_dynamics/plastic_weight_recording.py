@@ -0,0 +1,208 @@
+""" Periodic recording of plastic weights while a simulation runs, for the\
+    timing rules whose cores support it (Vogels2011Rule and\
+    RecurrentTimeDependency), so that learning can be followed without\
+    stopping the simulation to read the weights back.
+
+    The space is at the start of the plasticity region; see\
+    neural_modelling/src/neuron/plasticity/stdp/weight_recording.h for the\
+    layout and the delta encoding of the snapshots.
+"""
+import struct
+
+import numpy
+
+from data_specification.enums.data_type import DataType
+
+from spynnaker.pyNN.utilities import constants
+
+from spynnaker_extra_pynn_models.neuron import extra_regions
+
+# Words of weight_recording_config_t written by the host, followed by those
+# written by the core
+_CONFIG_WORDS = 5
+_STATE_WORDS = 3
+_HEADER_BYTES = 4 * (_CONFIG_WORDS + _STATE_WORDS)
+
+# Key and neuron index of each slot
+_SLOT_BYTES = 8
+
+_SLOT_DTYPE = numpy.dtype([("key", "<u4"), ("index", "<u4")])
+
+
+class WeightRecording(object):
+    """ Which weights a timing rule records, and how often
+    """
+
+    def __init__(self, interval=None, max_synapses=256,
+                 buffer_bytes=64 * 1024):
+        """
+
+        :param interval: the time between snapshots in ms, or None to not\
+            record
+        :param max_synapses: the number of synapses recorded on each core;\
+            the plastic synapses of the first rows to receive a spike
+        :param buffer_bytes: the space for snapshots on each core
+        """
+        self._interval = interval
+        self._max_synapses = max_synapses if interval is not None else 0
+        self._buffer_bytes = (
+            ((buffer_bytes + 3) // 4) * 4 if interval is not None else 0)
+
+    @property
+    def size_bytes(self):
+        return (_HEADER_BYTES + (self._max_synapses * _SLOT_BYTES) +
+                self._buffer_bytes)
+
+    def write(self, spec, machine_time_step, pre_trace_size_bytes, num_terms,
+              synapse_bytes):
+        """ Write the recording space, which must come first in the rule's\
+            parameters
+
+        :param pre_trace_size_bytes: the size of each term of the pre-trace\
+            in the header of each row
+        :param synapse_bytes: the size of each plastic synapse, of which the\
+            weight is the first 16 bits
+        """
+        period = 0
+        if self._interval is not None:
+            period = max(1, int(round(
+                float(self._interval) * (1000.0 / float(machine_time_step)))))
+
+        # The time of the last spike, followed by the pre-trace, in words
+        row_header_bytes = 4 * (
+            1 + (((pre_trace_size_bytes * num_terms) + 3) // 4))
+
+        for value in (period, self._max_synapses, self._buffer_bytes,
+                      row_header_bytes, synapse_bytes):
+            spec.write_value(data=value, data_type=DataType.UINT32)
+
+        # The core writes the rest
+        spec.write_array([0] * (_STATE_WORDS + (
+            (self.size_bytes - _HEADER_BYTES) // 4)))
+
+    @property
+    def interval(self):
+        return self._interval
+
+    @property
+    def max_synapses(self):
+        return self._max_synapses
+
+    @property
+    def buffer_bytes(self):
+        return self._buffer_bytes
+
+
+def decode_weight_snapshots(data):
+    """ Decode the delta-encoded snapshots written by a core
+
+    :param data: the bytes written into the buffer
+    :return: the timestep of each snapshot, and an array of the weights of\
+        each slot in each snapshot, with -1 before a slot was first recorded
+    """
+    data = numpy.asarray(data, dtype="uint8")
+    timesteps = list()
+    snapshots = list()
+    current = numpy.zeros(0, dtype="uint16")
+    offset = 0
+    while offset < len(data):
+        timestep, n_slots = data[offset:offset + 8].view("<u4")
+        n_slots = int(n_slots)
+        n_changed_words = (n_slots + 31) // 32
+        offset += 8
+        changed_words = data[offset:offset + (4 * n_changed_words)].view("<u4")
+        offset += 4 * n_changed_words
+        changed = (((changed_words[:, numpy.newaxis] >>
+                     numpy.arange(32, dtype="uint32")) & 1)
+                   .ravel()[:n_slots].astype("bool"))
+        n_changed = int(numpy.count_nonzero(changed))
+        deltas = data[offset:offset + (2 * n_changed)].view("<i2")
+        offset += ((2 * n_changed) + 3) & ~3
+
+        # Slots found since the last snapshot start from zero; the deltas
+        # wrap as the 16-bit weights do
+        if n_slots > len(current):
+            current = numpy.concatenate((
+                current, numpy.zeros(n_slots - len(current), dtype="uint16")))
+        current[:n_slots][changed] += deltas.astype("uint16")
+        timesteps.append(int(timestep))
+        snapshots.append(current.astype("int32"))
+
+    n_slots = len(current)
+    weights = numpy.full((len(snapshots), n_slots), -1, dtype="int32")
+    for i, snapshot in enumerate(snapshots):
+        weights[i, :len(snapshot)] = snapshot
+    return numpy.array(timesteps, dtype="uint32"), weights
+
+
+def read_weight_recording(transceiver, placement, vertex_slice):
+    """ Read the recorded weights of a placed subvertex
+
+    :return: the timestep of each snapshot, the weights of each snapshot,\
+        the (key, post-synaptic neuron) of each recorded synapse, and\
+        whether recording stopped because the buffer was full
+    """
+    address = extra_regions.get_region_address(
+        transceiver, placement,
+        constants.POPULATION_BASED_REGIONS.SYNAPSE_DYNAMICS)
+    header = struct.unpack_from("<8I", str(transceiver.read_memory(
+        placement.x, placement.y, address, _HEADER_BYTES)))
+    max_synapses = header[1]
+    n_slots, overflow, bytes_written = header[_CONFIG_WORDS:]
+
+    slots = numpy.zeros(0, dtype=_SLOT_DTYPE)
+    if n_slots > 0:
+        slots = numpy.asarray(transceiver.read_memory(
+            placement.x, placement.y, address + _HEADER_BYTES,
+            n_slots * _SLOT_BYTES), dtype="uint8").view(_SLOT_DTYPE).copy()
+        slots["index"] += vertex_slice.lo_atom
+
+    data = []
+    if bytes_written > 0:
+        data = transceiver.read_memory(
+            placement.x, placement.y,
+            address + _HEADER_BYTES + (max_synapses * _SLOT_BYTES),
+            bytes_written)
+    timesteps, weights = decode_weight_snapshots(data)
+    return timesteps, weights, slots, overflow != 0
+
+
+def get_recorded_weights(projection):
+    """ Read the weights recorded during a run by the post-synaptic cores of\
+        a projection whose timing rule records weights
+
+    :return: the time of each snapshot in ms, an array of the weights of the\
+        recorded synapses in each snapshot, in the fixed point of the\
+        synaptic rows (-1 before a synapse was first recorded), and an\
+        array of the (key, post-synaptic neuron index) of each synapse,\
+        where the low bits of the key are the index of the pre-synaptic\
+        neuron on its core
+    """
+    spinnaker = projection._spinnaker
+    post_vertex = projection._projection_edge.post_vertex
+    graph_mapper = spinnaker.graph_mapper
+    all_timesteps = None
+    all_weights = list()
+    all_slots = list()
+    for subvertex in graph_mapper.get_subvertices_from_vertex(post_vertex):
+        placement = spinnaker.placements.get_placement_of_subvertex(subvertex)
+        vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+        timesteps, weights, slots, _ = read_weight_recording(
+            spinnaker.transceiver, placement, vertex_slice)
+
+        # Cores snapshot at the same times, but one whose buffer filled up
+        # stopped early
+        if all_timesteps is None or len(timesteps) < len(all_timesteps):
+            all_timesteps = timesteps
+        all_weights.append(weights)
+        all_slots.append(slots)
+
+    if all_timesteps is None:
+        all_timesteps = numpy.zeros(0, dtype="uint32")
+    n_snapshots = len(all_timesteps)
+    weights = numpy.concatenate(
+        [w[:n_snapshots] for w in all_weights] +
+        [numpy.zeros((n_snapshots, 0), dtype="int32")], axis=1)
+    times = all_timesteps * (float(spinnaker.machine_time_step) / 1000.0)
+    return times, weights, numpy.concatenate(
+        all_slots + [numpy.zeros(0, dtype=_SLOT_DTYPE)])
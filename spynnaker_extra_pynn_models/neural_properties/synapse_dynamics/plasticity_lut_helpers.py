@@ -0,0 +1,104 @@
+import math
+
+import numpy
+
+from data_specification.enums.data_type import DataType
+
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics\
+    import plasticity_helpers
+
+# Little-endian numpy types of the 16-bit LUT entry data types
+_LUT_ENTRY_DTYPES = {DataType.INT16: "<i2", DataType.UINT16: "<u2"}
+
+# LUTs which have already been built, keyed by their kind and parameters;
+# every vertex using a rule writes the same tables
+_lut_cache = dict()
+
+
+def _float_to_fixed(values):
+    """ Vectorised plasticity_helpers.float_to_fixed, rounding halves away\
+        from zero as round does, for non-negative values
+    """
+    return numpy.floor(
+        (values * float(plasticity_helpers.STDP_FIXED_POINT_ONE)) + 0.5)\
+        .astype("int32")
+
+
+def get_lut_time_shift(time_constant, machine_time_step, size):
+    """ Get the smallest LUT time shift with which a table of size entries\
+        covers the whole of an exponential decay, i.e. until it rounds to\
+        zero in STDP fixed point
+
+    :param time_constant: decay time constant in ms
+    :param machine_time_step: machine time step in us
+    :param size: number of LUT entries
+    :return: the number of bits time is shifted right by before lookup
+    """
+    tau_timesteps = float(time_constant) * (1000.0 / float(machine_time_step))
+
+    # exp(-t / tau) * STDP_FIXED_POINT_ONE rounds to zero beyond this time
+    zero_time = tau_timesteps * math.log(
+        2.0 * plasticity_helpers.STDP_FIXED_POINT_ONE)
+
+    shift = 0
+    while ((size - 1) << shift) < zero_time:
+        shift += 1
+    return shift
+
+
+def get_exp_lut(time_constant, machine_time_step, size, shift):
+    """ Get the fixed-point entries of an exponential decay LUT, indexed by\
+        time in machine timesteps shifted right by shift
+
+    :return: a read-only array, shared by every caller with the same\
+        parameters
+    """
+    key = ("exp", float(time_constant), machine_time_step, size, shift)
+    lut = _lut_cache.get(key)
+    if lut is None:
+        tau_timesteps = (
+            float(time_constant) * (1000.0 / float(machine_time_step)))
+        times = numpy.arange(size, dtype="float64") * float(1 << shift)
+        lut = _float_to_fixed(numpy.exp(-times / tau_timesteps))
+        lut.setflags(write=False)
+        _lut_cache[key] = lut
+    return lut
+
+
+def get_exp_dist_lut(mean_timesteps, size):
+    """ Get the inverse CDF of an exponential distribution with a mean of\
+        mean_timesteps, indexed by a uniform random fraction of size
+
+    :return: a read-only array, shared by every caller with the same\
+        parameters
+    """
+    key = ("exp_dist", float(mean_timesteps), size)
+    lut = _lut_cache.get(key)
+    if lut is None:
+        fractions = numpy.arange(size, dtype="float64") / float(size)
+        lut = numpy.floor(
+            (numpy.log(1.0 - fractions) * -float(mean_timesteps)) + 0.5)\
+            .astype("int32")
+        lut.setflags(write=False)
+        _lut_cache[key] = lut
+    return lut
+
+
+def write_lut(spec, lut, data_type=DataType.INT16):
+    """ Write a LUT of an even number of 16-bit entries with a single array\
+        write, packing each pair of entries into a little-endian word
+
+    :param lut: the entries
+    :param data_type: DataType.INT16 or DataType.UINT16
+    """
+    entries = numpy.asarray(lut).astype(_LUT_ENTRY_DTYPES[data_type])
+    if len(entries) % 2 != 0:
+        raise Exception("LUTs must have an even number of entries")
+    spec.write_array(entries.view("<u4"))
+
+
+def write_exp_lut(spec, time_constant, machine_time_step, size, shift):
+    """ Write an exponential decay LUT, indexed by time in machine\
+        timesteps shifted right by shift
+    """
+    write_lut(spec, get_exp_lut(time_constant, machine_time_step, size, shift))
@@ -0,0 +1,200 @@
+""" Poisson background input drawn on the core of a population.
+
+    Networks often give each neuron random background current through a\
+    population of Poisson sources connected one to one, which takes cores,\
+    router packets and row fetches for input that carries no information.\
+    Builds with SYNAPSE_BACKGROUND_NOISE instead draw the number of\
+    background spikes of each neuron every timestep and add them to its ring\
+    buffer entry directly; see\
+    neural_modelling/src/neuron/background_noise.h for how they are drawn.
+"""
+import numpy
+
+from data_specification.enums.data_type import DataType
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+from spynnaker.pyNN.utilities import utility_calls
+
+from spynnaker_extra_pynn_models.neuron import cpu_cost_model
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+# Synaptic row bit fields of the builds
+_SYNAPSE_INDEX_BITS = 8
+
+# Words of the generator state and the number of sources, and of each source
+_HEADER_WORDS = 6
+_SOURCE_WORDS = 3
+
+# DTCM of each neuron with background input on the core
+SOURCE_DTCM_BYTES = 8
+
+# The most spikes per timestep a neuron may expect; the core draws one
+# uniform number per spike, and exp(-rate) loses its precision beyond this
+MAX_EVENTS_PER_TIMESTEP = 16.0
+
+
+def get_exp_minus_lambda(rates, machine_time_step):
+    """ Get exp(-expected spikes per timestep) of each rate as the core\
+        reads it, an unsigned 0.32 fraction
+
+    :param rates: the rates in Hz
+    :param machine_time_step: the machine time step in us
+    """
+    events = numpy.asarray(rates, dtype="float64") * (
+        float(machine_time_step) / 1000000.0)
+    if numpy.any(events > MAX_EVENTS_PER_TIMESTEP):
+        raise ConfigurationException(
+            "Background noise rates must give at most {} spikes per"
+            " timestep".format(MAX_EVENTS_PER_TIMESTEP))
+    return numpy.minimum(numpy.rint(numpy.exp(-events) * float(1 << 32)),
+                         0xFFFFFFFF).astype("uint32")
+
+
+def get_mars_kiss_seed(rng):
+    """ Get a state of the core's generator, with y non-zero and c zero
+    """
+    x, z, w = rng.randint(0, 0x7FFFFFFF, 3)
+    y = rng.randint(1, 0x7FFFFFFF)
+    return [int(x), int(y), int(z), int(w), 0]
+
+
+class BackgroundNoiseVertex(object):
+    """ Population vertex mixin which gives its neurons Poisson background\
+        input of a rate, weight and synapse type per neuron.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, n_neurons, machine_time_step, n_synapse_types,
+                 background_noise_rate=None, background_noise_weight=0.0,
+                 background_noise_synapse_type=0, background_noise_seed=None):
+        """
+
+        :param background_noise_rate: the rate of the background spikes of\
+            each neuron in Hz, or None for no background input
+        :param background_noise_weight: the weight of each background spike,\
+            in the units of the synapse type (nA or uS)
+        :param background_noise_synapse_type: the index of the synapse type\
+            the background spikes arrive through, e.g. 0 for excitatory
+        :param background_noise_seed: the seed of the generators of the\
+            cores, or None to seed them randomly
+        """
+        self._background_noise_machine_time_step = machine_time_step
+        self._background_noise_rate = None
+        if background_noise_rate is not None:
+            self._background_noise_rate = \
+                utility_calls.convert_param_to_numpy(
+                    background_noise_rate, n_neurons)
+        self._background_noise_weight = utility_calls.convert_param_to_numpy(
+            background_noise_weight, n_neurons)
+        self._background_noise_synapse_type = numpy.asarray(
+            utility_calls.convert_param_to_numpy(
+                background_noise_synapse_type, n_neurons), dtype="uint32")
+        if numpy.any(self._background_noise_synapse_type >= n_synapse_types):
+            raise ConfigurationException(
+                "Background noise synapse types must be less than {}".format(
+                    n_synapse_types))
+        self._background_noise_seed = background_noise_seed
+
+    def _get_noise_neurons(self, vertex_slice):
+        """ Get the indices in the slice of its neurons with background input
+        """
+        if self._background_noise_rate is None:
+            return numpy.zeros(0, dtype="uint32")
+        lo_atom = vertex_slice.lo_atom
+        hi_atom = vertex_slice.hi_atom + 1
+        noisy = numpy.logical_and(
+            self._background_noise_rate[lo_atom:hi_atom] > 0,
+            self._background_noise_weight[lo_atom:hi_atom] != 0)
+        return numpy.flatnonzero(noisy).astype("uint32")
+
+    def _get_background_noise_dtcm_bytes(self, vertex_slice):
+        return SOURCE_DTCM_BYTES * len(self._get_noise_neurons(vertex_slice))
+
+    def _get_background_noise_cycles(self, vertex_slice):
+        """ Get the cycles per timestep to draw the background spikes
+        """
+        atoms = self._get_noise_neurons(vertex_slice) + vertex_slice.lo_atom
+        if len(atoms) == 0:
+            return 0
+        events = numpy.sum(self._background_noise_rate[atoms]) * (
+            float(self._background_noise_machine_time_step) / 1000000.0)
+        return int(
+            (cpu_cost_model.BACKGROUND_NOISE_CYCLES_PER_NEURON * len(atoms)) +
+            (cpu_cost_model.BACKGROUND_NOISE_CYCLES_PER_EVENT * events))
+
+    def _get_background_noise_size_bytes(self, vertex_slice):
+        if self._background_noise_rate is None:
+            return 0
+        return 4 * (_HEADER_WORDS + (
+            _SOURCE_WORDS * len(self._get_noise_neurons(vertex_slice))))
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return (super(BackgroundNoiseVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                self._get_background_noise_size_bytes(vertex_slice))
+
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
+        return (super(BackgroundNoiseVertex, self)
+                .get_dtcm_usage_for_atoms(vertex_slice, graph) +
+                self._get_background_noise_dtcm_bytes(vertex_slice))
+
+    def get_cpu_usage_for_atoms(self, vertex_slice, graph):
+        return (super(BackgroundNoiseVertex, self)
+                .get_cpu_usage_for_atoms(vertex_slice, graph) +
+                self._get_background_noise_cycles(vertex_slice))
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(BackgroundNoiseVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+        if self._background_noise_rate is not None:
+            spec.reserve_memory_region(
+                region=EXTRA_REGIONS.BACKGROUND_NOISE.value,
+                size=self._get_background_noise_size_bytes(vertex_slice),
+                label="backgroundNoise")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(BackgroundNoiseVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        if self._background_noise_rate is None:
+            return
+
+        # Each core has its own generator, seeded from the seed of the vertex
+        # and the first neuron of the core
+        seed = None
+        if self._background_noise_seed is not None:
+            seed = [self._background_noise_seed, vertex_slice.lo_atom]
+        rng = numpy.random.RandomState(seed)
+
+        neurons = self._get_noise_neurons(vertex_slice)
+        atoms = neurons + vertex_slice.lo_atom
+        sources = numpy.zeros((len(neurons), _SOURCE_WORDS), dtype="uint32")
+        sources[:, 0] = get_exp_minus_lambda(
+            self._background_noise_rate[atoms],
+            self._background_noise_machine_time_step)
+        sources[:, 1] = (
+            (self._background_noise_synapse_type[atoms] <<
+             _SYNAPSE_INDEX_BITS) | neurons)
+
+        # The core converts the weights with the ring buffer left shifts
+        sources[:, 2] = numpy.minimum(numpy.rint(
+            numpy.abs(self._background_noise_weight[atoms]) * 32768.0),
+            0x7FFFFFFF)
+
+        spec.switch_write_focus(region=EXTRA_REGIONS.BACKGROUND_NOISE.value)
+        spec.write_array(get_mars_kiss_seed(rng))
+        spec.write_value(data=len(neurons), data_type=DataType.UINT32)
+        if len(neurons) > 0:
+            spec.write_array(sources.reshape(-1))
+
+    @property
+    def background_noise_rate(self):
+        return self._background_noise_rate
+
+    @property
+    def background_noise_weight(self):
+        return self._background_noise_weight
+
+    @property
+    def background_noise_synapse_type(self):
+        return self._background_noise_synapse_type
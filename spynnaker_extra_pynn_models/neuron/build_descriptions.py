@@ -0,0 +1,339 @@
+""" Declarative descriptions of the builds of the component models.
+
+    Each build in neural_modelling/src/neuron/builds is a choice of\
+    components, and the Makefile of each is generated from its description by\
+    neural_modelling/src/neuron/builds/generate_builds.py, so that a\
+    specialised variant is a line here rather than a copy of a whole build.\
+    Each build enables the FEATURES of synapses.c which its model class\
+    offers its populations.  The generator also tells synapses.c which\
+    features a build can't use, so that they are compiled out: the target\
+    synapse checks of builds without a target synapse type, and the plastic\
+    row processing of static builds.
+
+    The binary of an STDP build is named from the suffixes of its timing and\
+    weight dependences, as the vertex_executable_suffix of the rules name\
+    the binary they need.
+
+    This module only uses the standard library, so that the generator can\
+    load it without the rest of the package.
+"""
+
+# SYNAPSE_DELAY_BITS of the builds without a variant, and the delay bits of
+# the variants of the static builds; see delay_bits.py
+MAX_SYNAPSE_DELAY_BITS = 4
+DELAY_BITS_VARIANTS = (2, 3)
+
+_UPSTREAM = "$(SOURCE_DIRS)/neuron"
+_EXTRA = "$(EXTRA_SRC_DIR)/neuron"
+
+# The Makefile paths of each component; of the object and header of a
+# neuron model, and without the extension for the dependences of STDP
+NEURON_MODELS = {
+    "lif": (_UPSTREAM + "/models/neuron_model_lif_impl.o",
+            _UPSTREAM + "/models/neuron_model_lif_impl.h"),
+    "lif_skip_idle": (_UPSTREAM + "/models/neuron_model_lif_impl.o",
+                      _EXTRA + "/models/neuron_model_lif_skip_idle_impl.h")}
+INPUT_TYPES = {
+    "current": _UPSTREAM + "/input_types/input_type_current.h",
+    "conductance": _UPSTREAM + "/input_types/input_type_conductance.h"}
+THRESHOLD_TYPES = {
+    "static": _UPSTREAM + "/threshold_types/threshold_type_static.h",
+    "maass_stochastic":
+        _EXTRA + "/threshold_types/threshold_type_maass_stochastic.h"}
+SYNAPSE_TYPES = {
+    "delta": _EXTRA + "/synapse_types/synapse_types_delta_impl.h",
+    "exponential":
+        _UPSTREAM + "/synapse_types/synapse_types_exponential_impl.h"}
+ADDITIONAL_INPUTS = {
+    "ca2_adaptive":
+        _EXTRA + "/additional_inputs/additional_input_ca2_adaptive_impl.h"}
+SYNAPSE_DYNAMICS = {
+    "static": _UPSTREAM + "/plasticity/synapse_dynamics_static_impl.o",
+    "stdp": _UPSTREAM + "/plasticity/stdp/synapse_dynamics_stdp_impl.o",
+    "stdp_mad":
+        _UPSTREAM + "/plasticity/stdp/synapse_dynamics_stdp_mad_impl.o"}
+TIMING_DEPENDENCES = {
+    "vogels_2011": _EXTRA + "/plasticity/stdp/timing_dependence/"
+                            "timing_vogels_2011_impl",
+    "recurrent_pre_stochastic":
+        _EXTRA + "/plasticity/stdp/timing_dependence/"
+                 "timing_recurrent_pre_stochastic_impl",
+    "recurrent_dual_fsm": _EXTRA + "/plasticity/stdp/timing_dependence/"
+                                   "timing_recurrent_dual_fsm_impl"}
+WEIGHT_DEPENDENCES = {
+    "additive": _UPSTREAM + "/plasticity/stdp/weight_dependence/"
+                            "weight_additive_one_term_impl",
+    "multiplicative": _UPSTREAM + "/plasticity/stdp/weight_dependence/"
+                                  "weight_multiplicative_impl"}
+
+# The features of synapses.c which the host chooses for each population,
+# as (comment, CFLAGS, functions wrapped at link time); each does nothing on
+# the cores of vertices which don't reserve its region or write its rows,
+# but costs code space and checks in the row loop, so a build has only those
+# its model class offers
+FEATURES = {
+    "provenance": (
+        "Record per-timestep synapse phase timings, and timer overruns and"
+        " slack, into the provenance region of vertices which reserve it;"
+        " the timer callback is timed by wrapping its registration",
+        "-DSYNAPSE_PROVENANCE", ("spin1_callback_on",)),
+    "row_costs": (
+        "Record the cost of each synaptic row; the source key of each row is"
+        " captured by wrapping the population table lookups made by spike"
+        " processing", "-DSYNAPSE_ROW_COSTS",
+        ("population_table_get_first_address",
+         "population_table_get_next_address")),
+    "weight_recording": (
+        "Record snapshots of plastic weights into the plasticity region of"
+        " rules which ask for it; the source key of each row is captured as"
+        " for the row costs", "-DSYNAPSE_WEIGHT_RECORDING",
+        ("population_table_get_first_address",
+         "population_table_get_next_address")),
+    "codebook_rows": (
+        "Accept fixed rows written with a codebook of their weights; see"
+        " spynnaker_extra_pynn_models/neuron/codebook_rows.py",
+        "-DSYNAPSE_CODEBOOK_ROWS", ()),
+    "delay_bucketed_rows": (
+        "Accept fixed rows written in groups of synapses of the same delay"
+        " and type; see"
+        " spynnaker_extra_pynn_models/neuron/delay_bucketed_rows.py",
+        "-DSYNAPSE_DELAY_BUCKETED_ROWS", ()),
+    "background_noise": (
+        "Add Poisson background input to the neurons of vertices which"
+        " reserve the region for it; see"
+        " spynnaker_extra_pynn_models/neuron/background_noise.py",
+        "-DSYNAPSE_BACKGROUND_NOISE", ()),
+    "turbo": (
+        "Start each timestep as soon as the neighbouring cores have finished"
+        " the last, rather than on the timer tick, on the cores of vertices"
+        " which reserve the region for it; see"
+        " spynnaker_extra_pynn_models/neuron/turbo.py.  The timer and packet"
+        " callbacks are taken over through the same wrapper as the"
+        " provenance, spikes are given their timestep by wrapping the"
+        " sending of packets, and the rows fetched are followed through the"
+        " population table lookups, as for the row costs", "-DSYNAPSE_TURBO",
+        ("spin1_callback_on", "spin1_send_mc_packet",
+         "population_table_get_first_address",
+         "population_table_get_next_address"))}
+
+# The features offered by the vertex mixins of the model classes: by
+# SynapseProvenanceVertex, BackgroundNoiseVertex and TurboVertex,
+# FixedRowFormatsVertex, and the weight recording of the STDP rules
+_PROVENANCE_FEATURES = ("provenance", "row_costs")
+_POPULATION_FEATURES = ("background_noise", "turbo")
+_ROW_FORMAT_FEATURES = ("codebook_rows", "delay_bucketed_rows")
+_PLASTIC_FEATURES = ("weight_recording",)
+
+_MATRIX_RESET = (
+    "Restarted runs of a parameter sweep start from the synaptic matrix as"
+    " loaded", "-DSYNAPSE_MATRIX_RESET")
+
+
+class BuildDescription(object):
+    """ The components and compile-time options of a build of the component\
+        models
+    """
+
+    def __init__(
+            self, model_name, neuron_model="lif", input_type="current",
+            threshold_type="static", synapse_type="exponential",
+            additional_input=None, synapse_dynamics="static",
+            timing_dependence=None, weight_dependence=None, cflags=(),
+            features=(), name=None):
+        """
+
+        :param model_name: the model_name of the model class, which names\
+            the binary of a static build
+        :param cflags: (comment, flags) added to the CFLAGS of the build
+        :param features: the names of the FEATURES the build has
+        :param name: the name of the build, if not named from its components
+        """
+        self.model_name = model_name
+        self.neuron_model = neuron_model
+        self.input_type = input_type
+        self.threshold_type = threshold_type
+        self.synapse_type = synapse_type
+        self.additional_input = additional_input
+        self.synapse_dynamics = synapse_dynamics
+        self.timing_dependence = timing_dependence
+        self.weight_dependence = weight_dependence
+        self.cflags = tuple(cflags)
+        self.features = tuple(features)
+        for feature in self.features:
+            if feature not in FEATURES:
+                raise ValueError("No feature {}".format(feature))
+        self._name = name
+
+    @property
+    def name(self):
+        """ The name of the build, and of its binary without .aplx
+        """
+        if self._name is not None:
+            return self._name
+        if self.synapse_dynamics == "static":
+            return self.model_name
+        return "{}_{}_{}_{}".format(
+            self.model_name, self.synapse_dynamics, self.timing_dependence,
+            self.weight_dependence)
+
+    @property
+    def binary(self):
+        return self.name + ".aplx"
+
+    @property
+    def has_target_synapses(self):
+        """ Whether the synapse type has a target synapse; none of the\
+            component synapse types do
+        """
+        return False
+
+    @property
+    def is_static(self):
+        return self.synapse_dynamics == "static"
+
+    def variant(self, suffix, cflags=(), **components):
+        """ Get a variant of the build, named with a suffix, with other\
+            components and more CFLAGS
+        """
+        description = BuildDescription(
+            self.model_name, self.neuron_model, self.input_type,
+            self.threshold_type, self.synapse_type, self.additional_input,
+            self.synapse_dynamics, self.timing_dependence,
+            self.weight_dependence, self.cflags + tuple(cflags),
+            self.features, "{}_{}".format(self.name, suffix))
+        for component, value in components.items():
+            if not hasattr(description, component):
+                raise ValueError("No component {}".format(component))
+            setattr(description, component, value)
+        return description
+
+    def get_makefile_variables(self):
+        """ Get the component variables of the Makefile of the build
+        """
+        neuron_model, neuron_model_h = NEURON_MODELS[self.neuron_model]
+        variables = [
+            ("NEURON_MODEL", neuron_model),
+            ("NEURON_MODEL_H", neuron_model_h),
+            ("INPUT_TYPE_H", INPUT_TYPES[self.input_type]),
+            ("THRESHOLD_TYPE_H", THRESHOLD_TYPES[self.threshold_type]),
+            ("SYNAPSE_TYPE_H", SYNAPSE_TYPES[self.synapse_type]),
+            ("SYNAPSE_DYNAMICS", SYNAPSE_DYNAMICS[self.synapse_dynamics])]
+        if not self.is_static:
+            timing = TIMING_DEPENDENCES[self.timing_dependence]
+            weight = WEIGHT_DEPENDENCES[self.weight_dependence]
+            variables.extend([
+                ("TIMING_DEPENDENCE", timing + ".o"),
+                ("TIMING_DEPENDENCE_H", timing + ".h"),
+                ("WEIGHT_DEPENDENCE", weight + ".o"),
+                ("WEIGHT_DEPENDENCE_H", weight + ".h")])
+        if self.additional_input is not None:
+            variables.append((
+                "ADDITIONAL_INPUT_H",
+                ADDITIONAL_INPUTS[self.additional_input]))
+        return variables
+
+    def get_features(self):
+        """ Get the (comment, CFLAGS) of each of the features of the build,\
+            and the functions they wrap, each once
+        """
+        cflags = list()
+        wrapped = list()
+        for feature in self.features:
+            comment, flags, functions = FEATURES[feature]
+            cflags.append((comment, flags))
+            wrapped.extend(
+                function for function in functions if function not in wrapped)
+        return cflags, wrapped
+
+    def get_feature_cflags(self):
+        """ Get the flags which compile out the features the build can't use
+        """
+        flags = list()
+        if not self.has_target_synapses:
+            flags.append("-DSYNAPSE_NO_TARGET_TYPES")
+        if self.is_static:
+            flags.append("-DSYNAPSE_STATIC_ONLY")
+        return flags
+
+
+def skip_idle(description):
+    """ Get the variant of a static build which skips the update of neurons\
+        at rest with no input
+    """
+    return description.variant(
+        "skip_idle", [(None, "-DNEURON_SKIP_IDLE")],
+        neuron_model="lif_skip_idle")
+
+
+def delay_bits(description, n_delay_bits):
+    """ Get the variant of a static build with fewer delay bits
+    """
+    return description.variant(
+        "delay_bits_{}".format(n_delay_bits),
+        [("Ring buffers of only {} timesteps of delays, for populations whose"
+          " incoming delays are all shorter; see"
+          " spynnaker_extra_pynn_models/neuron/delay_bits.py".format(
+              1 << n_delay_bits),
+          "-DSYNAPSE_DELAY_BITS={}".format(n_delay_bits))])
+
+
+_IF_COND_EXP_STOC = BuildDescription(
+    "IF_cond_exp_stoc", input_type="conductance",
+    threshold_type="maass_stochastic",
+    features=_PROVENANCE_FEATURES + _POPULATION_FEATURES)
+_IF_CURR_DELTA = BuildDescription(
+    "IF_curr_delta", synapse_type="delta",
+    features=(_PROVENANCE_FEATURES + _POPULATION_FEATURES +
+              _ROW_FORMAT_FEATURES))
+_IF_CURR_EXP_CA2_ADAPTIVE = BuildDescription(
+    "IF_curr_exp_ca2_adaptive", additional_input="ca2_adaptive",
+    features=_PROVENANCE_FEATURES + _POPULATION_FEATURES)
+
+# The builds of the component models, in the order of MODELS
+BUILDS = (
+    [_IF_COND_EXP_STOC,
+     BuildDescription(
+         "IF_curr_exp", synapse_dynamics="stdp",
+         timing_dependence="recurrent_pre_stochastic",
+         weight_dependence="multiplicative", cflags=[_MATRIX_RESET],
+         features=_PLASTIC_FEATURES),
+     BuildDescription(
+         "IF_curr_exp", synapse_dynamics="stdp_mad",
+         timing_dependence="recurrent_dual_fsm",
+         weight_dependence="multiplicative", cflags=[_MATRIX_RESET],
+         features=_PLASTIC_FEATURES),
+     BuildDescription(
+         "IF_curr_exp", synapse_dynamics="stdp_mad",
+         timing_dependence="vogels_2011", weight_dependence="additive",
+         cflags=[_MATRIX_RESET], features=_PLASTIC_FEATURES),
+     _IF_CURR_DELTA,
+     _IF_CURR_EXP_CA2_ADAPTIVE,
+     skip_idle(_IF_CURR_DELTA),
+     skip_idle(_IF_CURR_EXP_CA2_ADAPTIVE)] +
+    [delay_bits(description, n_delay_bits)
+     for description in (
+         _IF_CURR_DELTA, _IF_COND_EXP_STOC, _IF_CURR_EXP_CA2_ADAPTIVE)
+     for n_delay_bits in DELAY_BITS_VARIANTS])
+
+# Builds of the target population, which predates the component models and
+# keeps its hand-written Makefiles; they enable the features of
+# FixedRowFormatsVertex, BackgroundNoiseVertex and TurboVertex by hand
+HAND_WRITTEN_BUILDS = (
+    "IF_curr_exp_target_stdp_mad_pair_additive",
+    "IF_curr_exp_target_stdp_mad_pair_kernel_additive")
+
+
+def get_build_names():
+    """ Get the names of every build, in the order they are made
+    """
+    names = [description.name for description in BUILDS]
+    return names[:6] + list(HAND_WRITTEN_BUILDS) + names[6:]
+
+
+def get_description(binary):
+    """ Get the description of the build of a binary, or None if it has none
+    """
+    for description in BUILDS:
+        if description.binary == binary:
+            return description
+    return None
@@ -9,9 +9,20 @@ from spynnaker.pyNN.models.neuron.input_types.input_type_conductance \
     import InputTypeConductance
 from spynnaker_extra_pynn_models.neuron.threshold_types\
     .threshold_type_maass_stochastic import ThresholdTypeMaassStochastic
+from spynnaker_extra_pynn_models.neuron.cpu_cost_model \
+    import CpuCostModelVertex
+from spynnaker_extra_pynn_models.neuron.delay_bits import DelayBitsVertex
+from spynnaker_extra_pynn_models.neuron.synapse_provenance \
+    import SynapseProvenanceVertex
+from spynnaker_extra_pynn_models.neuron.background_noise \
+    import BackgroundNoiseVertex
+from spynnaker_extra_pynn_models.neuron.turbo import TurboVertex
 
 
-class IFCondExpStoc(AbstractPopulationVertex):
+class IFCondExpStoc(
+        DelayBitsVertex, CpuCostModelVertex, SynapseProvenanceVertex,
+        BackgroundNoiseVertex, TurboVertex,
+        AbstractPopulationVertex):
 
     _model_based_max_atoms_per_core = 255
 
@@ -36,7 +47,10 @@ class IFCondExpStoc(AbstractPopulationVertex):
             e_rev_E=default_parameters['e_rev_E'],
             e_rev_I=default_parameters['e_rev_I'],
             du_th=default_parameters['du_th'],
-            tau_th=default_parameters['tau_th'], v_init=None):
+            tau_th=default_parameters['tau_th'], v_init=None,
+            record_row_costs=False,
+            background_noise_rate=None, background_noise_weight=0.0,
+            background_noise_synapse_type=0, background_noise_seed=None):
 
         neuron_model = NeuronModelLeakyIntegrateAndFire(
             n_neurons, machine_time_step, v_init, v_rest, tau_m, cm, i_offset,
@@ -47,6 +61,17 @@ class IFCondExpStoc(AbstractPopulationVertex):
         threshold_type = ThresholdTypeMaassStochastic(
             n_neurons, du_th, tau_th, v_thresh)
 
+        DelayBitsVertex.__init__(self, "IF_cond_exp_stoc.aplx")
+        CpuCostModelVertex.__init__(
+            self, synapse_type.get_n_synapse_types(), machine_time_step)
+        SynapseProvenanceVertex.__init__(
+            self, record_row_costs, machine_time_step, timescale_factor)
+        BackgroundNoiseVertex.__init__(
+            self, n_neurons, machine_time_step,
+            synapse_type.get_n_synapse_types(), background_noise_rate,
+            background_noise_weight, background_noise_synapse_type,
+            background_noise_seed)
+        TurboVertex.__init__(self)
         AbstractPopulationVertex.__init__(
             self, n_neurons=n_neurons, binary="IF_cond_exp_stoc.aplx",
             label=label,
@@ -1,5 +1,7 @@
 from spynnaker.pyNN.models.neuron.abstract_population_vertex import \
     AbstractPopulationVertex
+from spynnaker.pyNN.utilities import utility_calls
+from spynnaker.pyNN.exceptions import ConfigurationException
 from spynnaker.pyNN.models.neuron.neuron_models\
     .neuron_model_leaky_integrate_and_fire \
     import NeuronModelLeakyIntegrateAndFire
@@ -9,9 +11,24 @@ from spynnaker.pyNN.models.neuron.threshold_types.threshold_type_static \
     import ThresholdTypeStatic
 from spynnaker_extra_pynn_models.neuron.synapse_types.synapse_type_delta \
     import SynapseTypeDelta
+from spynnaker_extra_pynn_models.neuron.fixed_row_formats \
+    import FixedRowFormatsVertex
+from spynnaker_extra_pynn_models.neuron.cpu_cost_model \
+    import CpuCostModelVertex
+from spynnaker_extra_pynn_models.neuron.delay_bits import DelayBitsVertex
+from spynnaker_extra_pynn_models.neuron.synapse_provenance \
+    import SynapseProvenanceVertex
+from spynnaker_extra_pynn_models.neuron.background_noise \
+    import BackgroundNoiseVertex
+from spynnaker_extra_pynn_models.neuron.turbo import TurboVertex
 
+import numpy
 
-class IFCurrDelta(AbstractPopulationVertex):
+
+class IFCurrDelta(
+        DelayBitsVertex, FixedRowFormatsVertex, CpuCostModelVertex,
+        SynapseProvenanceVertex, BackgroundNoiseVertex, TurboVertex,
+        AbstractPopulationVertex):
     """ Leaky integrate and fire neuron with an instantaneous \
         current input
     """
@@ -31,7 +48,11 @@ class IFCurrDelta(AbstractPopulationVertex):
             v_reset=default_parameters['v_reset'],
             v_thresh=default_parameters['v_thresh'],
             tau_refrac=default_parameters['tau_refrac'],
-            i_offset=default_parameters['i_offset'], v_init=None):
+            i_offset=default_parameters['i_offset'], v_init=None,
+            skip_idle_neurons=False, record_row_costs=False,
+            max_quantisation_error=0.0, delay_bucketed_rows=True,
+            background_noise_rate=None, background_noise_weight=0.0,
+            background_noise_synapse_type=0, background_noise_seed=None):
 
         neuron_model = NeuronModelLeakyIntegrateAndFire(
             n_neurons, machine_time_step, v_init, v_rest, tau_m, cm, i_offset,
@@ -40,8 +61,41 @@ class IFCurrDelta(AbstractPopulationVertex):
         input_type = InputTypeCurrent()
         threshold_type = ThresholdTypeStatic(n_neurons, v_thresh)
 
+        # Neurons with no input can only be skipped if they can't spike
+        # at rest or after a reset
+        binary = "IF_curr_delta.aplx"
+        if skip_idle_neurons:
+            v_rest_values = utility_calls.convert_param_to_numpy(
+                v_rest, n_neurons)
+            v_reset_values = utility_calls.convert_param_to_numpy(
+                v_reset, n_neurons)
+            v_thresh_values = utility_calls.convert_param_to_numpy(
+                v_thresh, n_neurons)
+            if numpy.any(numpy.greater_equal(
+                    numpy.maximum(v_rest_values, v_reset_values),
+                    v_thresh_values)):
+                raise ConfigurationException(
+                    "skip_idle_neurons requires v_rest and v_reset to be"
+                    " below v_thresh")
+            binary = "IF_curr_delta_skip_idle.aplx"
+
+        # The skip idle build has no variants with fewer delay bits
+        DelayBitsVertex.__init__(self, "IF_curr_delta.aplx")
+        FixedRowFormatsVertex.__init__(
+            self, (synapse_type.get_n_synapse_types() - 1).bit_length(),
+            max_quantisation_error, delay_bucketed_rows)
+        CpuCostModelVertex.__init__(
+            self, synapse_type.get_n_synapse_types(), machine_time_step)
+        SynapseProvenanceVertex.__init__(
+            self, record_row_costs, machine_time_step, timescale_factor)
+        BackgroundNoiseVertex.__init__(
+            self, n_neurons, machine_time_step,
+            synapse_type.get_n_synapse_types(), background_noise_rate,
+            background_noise_weight, background_noise_synapse_type,
+            background_noise_seed)
+        TurboVertex.__init__(self)
         AbstractPopulationVertex.__init__(
-            self, n_neurons=n_neurons, binary="IF_curr_delta.aplx",
+            self, n_neurons=n_neurons, binary=binary,
             label=label,
             max_atoms_per_core=IFCurrDelta._model_based_max_atoms_per_core,
             machine_time_step=machine_time_step,
@@ -1,5 +1,7 @@
 from spynnaker.pyNN.models.neuron.abstract_population_vertex import \
     AbstractPopulationVertex
+from spynnaker.pyNN.utilities import utility_calls
+from spynnaker.pyNN.exceptions import ConfigurationException
 from spynnaker.pyNN.models.neuron.neuron_models\
     .neuron_model_leaky_integrate_and_fire \
     import NeuronModelLeakyIntegrateAndFire
@@ -12,9 +14,22 @@ from spynnaker.pyNN.models.neuron.threshold_types.threshold_type_static \
 from spynnaker_extra_pynn_models.neuron\
     .additional_inputs.additional_input_ca2_adaptive \
     import AdditionalInputCa2Adaptive
+from spynnaker_extra_pynn_models.neuron.cpu_cost_model \
+    import CpuCostModelVertex
+from spynnaker_extra_pynn_models.neuron.delay_bits import DelayBitsVertex
+from spynnaker_extra_pynn_models.neuron.synapse_provenance \
+    import SynapseProvenanceVertex
+from spynnaker_extra_pynn_models.neuron.background_noise \
+    import BackgroundNoiseVertex
+from spynnaker_extra_pynn_models.neuron.turbo import TurboVertex
 
+import numpy
 
-class IFCurrExpCa2Adaptive(AbstractPopulationVertex):
+
+class IFCurrExpCa2Adaptive(
+        DelayBitsVertex, CpuCostModelVertex, SynapseProvenanceVertex,
+        BackgroundNoiseVertex, TurboVertex,
+        AbstractPopulationVertex):
     """ Model from Liu, Y. H., & Wang, X. J. (2001). Spike-frequency\
         adaptation of a generalized leaky integrate-and-fire model neuron. \
         Journal of Computational Neuroscience, 10(1), 25-45. \
@@ -43,7 +58,10 @@ class IFCurrExpCa2Adaptive(AbstractPopulationVertex):
             i_offset=default_parameters['i_offset'],
             tau_ca2=default_parameters["tau_ca2"],
             i_ca2=default_parameters["i_ca2"],
-            i_alpha=default_parameters["i_alpha"], v_init=None):
+            i_alpha=default_parameters["i_alpha"], v_init=None,
+            skip_idle_neurons=False, record_row_costs=False,
+            background_noise_rate=None, background_noise_weight=0.0,
+            background_noise_synapse_type=0, background_noise_seed=None):
 
         neuron_model = NeuronModelLeakyIntegrateAndFire(
             n_neurons, machine_time_step, v_init, v_rest, tau_m, cm, i_offset,
@@ -55,8 +73,38 @@ class IFCurrExpCa2Adaptive(AbstractPopulationVertex):
         additional_input = AdditionalInputCa2Adaptive(
             n_neurons, machine_time_step, tau_ca2, i_ca2, i_alpha)
 
+        # Neurons with no input can only be skipped if they can't spike
+        # at rest or after a reset
+        binary = "IF_curr_exp_ca2_adaptive.aplx"
+        if skip_idle_neurons:
+            v_rest_values = utility_calls.convert_param_to_numpy(
+                v_rest, n_neurons)
+            v_reset_values = utility_calls.convert_param_to_numpy(
+                v_reset, n_neurons)
+            v_thresh_values = utility_calls.convert_param_to_numpy(
+                v_thresh, n_neurons)
+            if numpy.any(numpy.greater_equal(
+                    numpy.maximum(v_rest_values, v_reset_values),
+                    v_thresh_values)):
+                raise ConfigurationException(
+                    "skip_idle_neurons requires v_rest and v_reset to be"
+                    " below v_thresh")
+            binary = "IF_curr_exp_ca2_adaptive_skip_idle.aplx"
+
+        # The skip idle build has no variants with fewer delay bits
+        DelayBitsVertex.__init__(self, "IF_curr_exp_ca2_adaptive.aplx")
+        CpuCostModelVertex.__init__(
+            self, synapse_type.get_n_synapse_types(), machine_time_step)
+        SynapseProvenanceVertex.__init__(
+            self, record_row_costs, machine_time_step, timescale_factor)
+        BackgroundNoiseVertex.__init__(
+            self, n_neurons, machine_time_step,
+            synapse_type.get_n_synapse_types(), background_noise_rate,
+            background_noise_weight, background_noise_synapse_type,
+            background_noise_seed)
+        TurboVertex.__init__(self)
         AbstractPopulationVertex.__init__(
-            self, n_neurons=n_neurons, binary="IF_curr_exp_ca2_adaptive.aplx",
+            self, n_neurons=n_neurons, binary=binary,
             label=label,
             max_atoms_per_core=
             IFCurrExpCa2Adaptive._model_based_max_atoms_per_core,
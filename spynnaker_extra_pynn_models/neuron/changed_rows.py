@@ -0,0 +1,238 @@
+""" Incremental read back of plastic weights.
+
+    Builds with SYNAPSE_CHANGED_ROWS keep a bitmap of the chunks of the\
+    synaptic matrix whose plastic weights have changed.  The host keeps a\
+    copy of each block of the matrix it has read, and on later reads only\
+    reads the chunks marked in the bitmap, merges them into the copy and\
+    clears their marks; reading the weights back after each training epoch\
+    then only costs the rows which learned.
+"""
+import struct
+
+import numpy
+
+from spynnaker.pyNN.utilities import constants
+
+from spynnaker_extra_pynn_models.neuron import extra_regions
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+from data_specification.enums.data_type import DataType
+
+# Bytes of the synaptic matrix covered by each bit; must match
+# CHANGED_ROWS_CHUNK_BYTES in neural_modelling/src/neuron/changed_rows.h
+CHANGED_ROWS_CHUNK_BYTES = 64
+
+# Chunks covered by the bitmap, i.e. 2MB of synaptic matrix per core; blocks
+# beyond this are read in full after any of their rows change
+CHANGED_ROWS_N_CHUNKS = 32768
+
+# The number of chunks and the overflow flag, followed by the bitmap
+_HEADER_BYTES = 8
+
+
+def get_changed_rows_size_bytes(n_chunks):
+    return _HEADER_BYTES + (4 * ((n_chunks + 31) // 32))
+
+
+def get_changed_ranges(bitmap_words, n_chunks):
+    """ Get the ranges of the synaptic matrix marked in a changed rows\
+        bitmap, merging adjacent chunks
+
+    :param bitmap_words: the bitmap, as a numpy array of uint32
+    :param n_chunks: the number of chunks the bitmap covers
+    :return: a list of (begin, end) byte offsets into the synaptic matrix
+    """
+    bits = (bitmap_words[:, numpy.newaxis] >>
+            numpy.arange(32, dtype="uint32")) & 1
+    chunks = numpy.flatnonzero(bits.ravel()[:n_chunks])
+    if len(chunks) == 0:
+        return []
+
+    # Runs of consecutive chunks start after each gap
+    breaks = numpy.flatnonzero(numpy.diff(chunks) != 1) + 1
+    begins = chunks[numpy.concatenate(([0], breaks))]
+    ends = chunks[numpy.concatenate((breaks - 1, [len(chunks) - 1]))] + 1
+    return [(int(begin) * CHANGED_ROWS_CHUNK_BYTES,
+             int(end) * CHANGED_ROWS_CHUNK_BYTES)
+            for begin, end in zip(begins, ends)]
+
+
+class SynapticMatrixCache(object):
+    """ Host copy of the blocks of the synaptic matrix of one core which\
+        have been read, kept up to date from its changed rows bitmap
+    """
+
+    def __init__(self, placement):
+        self._placement = placement
+        self._matrix_address = None
+        self._matrix_end = None
+        self._bitmap_address = None
+        self._n_chunks = None
+
+        # Copies of the blocks read, keyed by address and length
+        self._blocks = dict()
+
+    def _locate(self, transceiver):
+        if self._matrix_address is not None:
+            return
+        regions = extra_regions.get_region_addresses(
+            transceiver, self._placement)
+        self._matrix_address = regions[
+            constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value]
+        self._bitmap_address = regions[EXTRA_REGIONS.CHANGED_ROWS.value]
+
+        # The matrix ends where the next region starts
+        self._matrix_end = min([address for address in regions
+                                if address > self._matrix_address] +
+                               [0xFFFFFFFF])
+        self._n_chunks = struct.unpack_from("<I", str(
+            transceiver.read_memory(
+                self._placement.x, self._placement.y, self._bitmap_address,
+                4)))[0]
+
+    def contains(self, transceiver, address, length):
+        """ Determine if a read is of the synaptic matrix of this core
+        """
+        self._locate(transceiver)
+        return (self._matrix_address <= address and
+                (address + length) <= self._matrix_end)
+
+    def read(self, transceiver, address, length):
+        """ Read a block of the synaptic matrix, from the copy if it has\
+            been read before
+
+        :return: a bytearray, which the caller may modify
+        """
+        self._update(transceiver)
+        key = (address, length)
+        block = self._blocks.get(key)
+        if block is None:
+            block = bytearray(transceiver.read_memory(
+                self._placement.x, self._placement.y, address, length))
+            self._blocks[key] = block
+        return bytearray(block)
+
+    def _update(self, transceiver):
+        """ Read the changed chunks of each block into its copy, and clear\
+            the bitmap
+        """
+        self._locate(transceiver)
+        x, y = self._placement.x, self._placement.y
+        size = get_changed_rows_size_bytes(self._n_chunks)
+        words = numpy.asarray(
+            transceiver.read_memory(x, y, self._bitmap_address, size),
+            dtype="uint8").view("<u4")
+        overflow = words[1] != 0
+        if not overflow and not numpy.any(words[2:]):
+            return
+
+        ranges = get_changed_ranges(words[2:], self._n_chunks)
+        covered = self._n_chunks * CHANGED_ROWS_CHUNK_BYTES
+        for (address, length), block in list(self._blocks.items()):
+            begin = address - self._matrix_address
+            end = begin + length
+
+            # Blocks beyond the bitmap are read in full if anything changed
+            if overflow and end > covered:
+                del self._blocks[(address, length)]
+                continue
+
+            for range_begin, range_end in ranges:
+                read_begin = max(begin, range_begin)
+                read_end = min(end, range_end)
+                if read_begin < read_end:
+                    block[read_begin - begin:read_end - begin] = \
+                        transceiver.read_memory(
+                            x, y, self._matrix_address + read_begin,
+                            read_end - read_begin)
+
+        # Clear the overflow flag and the bitmap, leaving the size
+        transceiver.write_memory(
+            x, y, self._bitmap_address + 4, bytearray(size - 4))
+
+
+class _SynapticMatrixCacheTransceiver(object):
+    """ Transceiver which serves reads of the synaptic matrix of a core from\
+        its cache, and passes everything else on
+    """
+
+    def __init__(self, transceiver, cache):
+        self._transceiver = transceiver
+        self._cache = cache
+
+    def read_memory(self, x, y, base_address, length):
+        placement = self._cache._placement
+        if (x == placement.x and y == placement.y and
+                self._cache.contains(self._transceiver, base_address, length)):
+            return self._cache.read(self._transceiver, base_address, length)
+        return self._transceiver.read_memory(x, y, base_address, length)
+
+    def __getattr__(self, name):
+        return getattr(self._transceiver, name)
+
+
+class ChangedRowsVertex(object):
+    """ Population vertex mixin which, with incremental_weight_readback,\
+        reserves the changed rows bitmap and reads synaptic matrices back\
+        through a cache, so that only the rows whose weights changed since\
+        the last read are read again.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, incremental_weight_readback=False):
+        self._incremental_weight_readback = incremental_weight_readback
+
+        # A cache per core, keyed by its (x, y, p)
+        self._synaptic_matrix_caches = dict()
+
+    @property
+    def _changed_rows_size_bytes(self):
+        if self._incremental_weight_readback:
+            return get_changed_rows_size_bytes(CHANGED_ROWS_N_CHUNKS)
+        return 0
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return (super(ChangedRowsVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                self._changed_rows_size_bytes)
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(ChangedRowsVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+        if self._incremental_weight_readback:
+            spec.reserve_memory_region(
+                region=EXTRA_REGIONS.CHANGED_ROWS.value,
+                size=self._changed_rows_size_bytes, label="changedRows")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(ChangedRowsVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        if self._incremental_weight_readback:
+
+            # The matrices are about to be reloaded, so the copies are stale
+            self._synaptic_matrix_caches.clear()
+
+            # The core clears the bitmap itself when it starts
+            spec.switch_write_focus(region=EXTRA_REGIONS.CHANGED_ROWS.value)
+            spec.write_value(
+                data=CHANGED_ROWS_N_CHUNKS, data_type=DataType.UINT32)
+
+    def get_synaptic_list_from_machine(
+            self, placements, transceiver, pre_subvertex, pre_n_atoms,
+            post_subvertex, *args, **kwargs):
+        if self._incremental_weight_readback:
+            placement = placements.get_placement_of_subvertex(post_subvertex)
+            core = (placement.x, placement.y, placement.p)
+            if core not in self._synaptic_matrix_caches:
+                self._synaptic_matrix_caches[core] = \
+                    SynapticMatrixCache(placement)
+            transceiver = _SynapticMatrixCacheTransceiver(
+                transceiver, self._synaptic_matrix_caches[core])
+        return super(ChangedRowsVertex, self).get_synaptic_list_from_machine(
+            placements, transceiver, pre_subvertex, pre_n_atoms,
+            post_subvertex, *args, **kwargs)
+
+    @property
+    def incremental_weight_readback(self):
+        return self._incremental_weight_readback
@@ -0,0 +1,232 @@
+""" Checkpoint and restore of the plastic state of the target STDP builds,\
+    so that long training runs can be resumed.
+
+    At a chosen time each core copies its post-event histories and its\
+    synaptic matrix, which holds the plastic weights, accumulators and each\
+    row's pre-event history, into a checkpoint region; the matrix is copied\
+    in the background while spikes are processed, so the run must go on for\
+    a few timesteps after the checkpoint for the copy to complete.  The host\
+    reads the checkpoints back after the run and can save them to a file;\
+    a fresh run of the same network, partitioned in the same way, restores\
+    them before it starts and carries on training from the time of the\
+    checkpoint.\
+    Neuron state and input in flight are not restored.
+"""
+import cPickle
+import struct
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+
+from spynnaker_extra_pynn_models.neuron import dtcm_budget
+from spynnaker_extra_pynn_models.neuron import extra_regions
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+from data_specification.enums.data_type import DataType
+
+# The checkpoint_time of cores which don't take a checkpoint; must match
+# neural_modelling/src/neuron/checkpoint.h
+CHECKPOINT_NEVER = 0xFFFFFFFF
+
+# The time, restore flag and capacity written by the host, followed by the
+# time and the sizes of the dynamics state and matrix written by the core
+_HOST_HEADER_BYTES = 12
+_HEADER_BYTES = 24
+
+# The number of neurons and the time of the last target, followed by the
+# post-event histories
+_DYNAMICS_HEADER_BYTES = 8
+
+
+def get_checkpoint_size_bytes(n_neurons, post_trace_bytes, matrix_bytes):
+    """ Get the size of the checkpoint region of a core
+
+    :param post_trace_bytes: bytes of post_trace_t of the timing rule
+    :param matrix_bytes: the size of the synaptic matrix of the core
+    """
+    return (_HEADER_BYTES + _DYNAMICS_HEADER_BYTES +
+            (n_neurons *
+             dtcm_budget.get_post_event_history_bytes(post_trace_bytes)) +
+            matrix_bytes)
+
+
+def read_checkpoint(transceiver, placement):
+    """ Read the checkpoint taken by a core
+
+    :return: the checkpoint as the bytes from its time onwards, or None if\
+        the core didn't take one
+    """
+    address = extra_regions.get_region_address(
+        transceiver, placement, EXTRA_REGIONS.CHECKPOINT)
+    if address == 0:
+        return None
+    header = transceiver.read_memory(
+        placement.x, placement.y, address, _HEADER_BYTES)
+    dynamics_bytes, matrix_bytes = struct.unpack_from(
+        "<II", str(header), _HOST_HEADER_BYTES + 4)
+    if dynamics_bytes == 0:
+        return None
+    return bytearray(transceiver.read_memory(
+        placement.x, placement.y, address + _HOST_HEADER_BYTES,
+        (_HEADER_BYTES - _HOST_HEADER_BYTES) + dynamics_bytes +
+        matrix_bytes))
+
+
+def get_checkpoint_time(checkpoint, machine_time_step):
+    """ Get the time in ms since training started at which a core's\
+        checkpoint was taken
+    """
+    timestep = struct.unpack_from("<I", str(checkpoint))[0]
+    return timestep * (float(machine_time_step) / 1000.0)
+
+
+def save_checkpoint(population, filename):
+    """ Read the checkpoints taken by the cores of a population after a run\
+        and save them to a file, from which restore_checkpoint can restore\
+        them into a fresh run
+
+    :param population: a population created with checkpoint_time
+    """
+    spinnaker = population._spinnaker
+    checkpoints = population._vertex.get_checkpoints(
+        spinnaker.transceiver, spinnaker.placements, spinnaker.graph_mapper)
+    with open(filename, "wb") as f:
+        cPickle.dump(checkpoints, f, cPickle.HIGHEST_PROTOCOL)
+
+
+def load_checkpoint(filename):
+    """ Load checkpoints saved by save_checkpoint
+
+    :return: a dict of checkpoints keyed by the (lo_atom, hi_atom) of each\
+        core
+    """
+    with open(filename, "rb") as f:
+        return cPickle.load(f)
+
+
+class CheckpointVertex(object):
+    """ Population vertex mixin which reserves the checkpoint region when\
+        checkpoint_time (in ms) is given, and restores the checkpoints of an\
+        earlier run given as restore_checkpoint, either as a file saved by\
+        save_checkpoint or as loaded by load_checkpoint.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, checkpoint_time, restore_checkpoint, machine_time_step,
+                 post_trace_bytes):
+        self._checkpoint_time = checkpoint_time
+        self._checkpoint_machine_time_step = machine_time_step
+        self._checkpoint_post_trace_bytes = post_trace_bytes
+        if isinstance(restore_checkpoint, basestring):
+            restore_checkpoint = load_checkpoint(restore_checkpoint)
+        self._restore_checkpoint = restore_checkpoint
+
+        # The size of the synaptic matrix of each slice, found when the
+        # vertex is partitioned
+        self._checkpoint_matrix_bytes = dict()
+
+    @property
+    def _checkpoint_enabled(self):
+        return (self._checkpoint_time is not None or
+                self._restore_checkpoint is not None)
+
+    def _get_restore_checkpoint(self, vertex_slice):
+        key = (vertex_slice.lo_atom, vertex_slice.hi_atom)
+        if key not in self._restore_checkpoint:
+            raise ConfigurationException(
+                "No checkpoint of neurons {}:{}; the network must be"
+                " partitioned as it was when the checkpoint was taken".format(
+                    *key))
+        return self._restore_checkpoint[key]
+
+    def _get_checkpoint_size_bytes(self, vertex_slice):
+        if not self._checkpoint_enabled:
+            return 0
+        size = get_checkpoint_size_bytes(
+            (vertex_slice.hi_atom - vertex_slice.lo_atom) + 1,
+            self._checkpoint_post_trace_bytes,
+            self._checkpoint_matrix_bytes[
+                (vertex_slice.lo_atom, vertex_slice.hi_atom)])
+        if self._restore_checkpoint is not None:
+            size = max(size, _HOST_HEADER_BYTES + len(
+                self._get_restore_checkpoint(vertex_slice)))
+        return size
+
+    def _get_checkpoint_matrix_bytes(self, vertex_slice, graph):
+        """ Get the size of the synaptic matrix a slice checkpoints, or None\
+            if it doesn't take a checkpoint
+        """
+        if not self._checkpoint_enabled:
+            return None
+        matrix_bytes = self.get_synaptic_blocks_memory_size(
+            vertex_slice, graph.incoming_edges_to_vertex(self))
+        self._checkpoint_matrix_bytes[
+            (vertex_slice.lo_atom, vertex_slice.hi_atom)] = matrix_bytes
+        return matrix_bytes
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        self._get_checkpoint_matrix_bytes(vertex_slice, graph)
+        return (super(CheckpointVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                self._get_checkpoint_size_bytes(vertex_slice))
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(CheckpointVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+        if self._checkpoint_enabled:
+            spec.reserve_memory_region(
+                region=EXTRA_REGIONS.CHECKPOINT.value,
+                size=self._get_checkpoint_size_bytes(vertex_slice),
+                label="checkpoint")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(CheckpointVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        if not self._checkpoint_enabled:
+            return
+
+        checkpoint_timestep = CHECKPOINT_NEVER
+        if self._checkpoint_time is not None:
+            checkpoint_timestep = int(round(
+                float(self._checkpoint_time) *
+                (1000.0 / float(self._checkpoint_machine_time_step))))
+        size = self._get_checkpoint_size_bytes(vertex_slice)
+        spec.switch_write_focus(region=EXTRA_REGIONS.CHECKPOINT.value)
+        spec.write_value(data=checkpoint_timestep, data_type=DataType.UINT32)
+        spec.write_value(
+            data=int(self._restore_checkpoint is not None),
+            data_type=DataType.UINT32)
+        spec.write_value(
+            data=size - _HEADER_BYTES, data_type=DataType.UINT32)
+
+        # The core copies the matrix of the checkpoint over the matrix
+        # written from the projections
+        if self._restore_checkpoint is not None:
+            checkpoint = self._get_restore_checkpoint(vertex_slice)
+            spec.write_array(list(struct.unpack_from(
+                "<{}I".format(len(checkpoint) // 4), str(checkpoint))))
+        else:
+            spec.write_array([0, 0, 0])
+
+    def get_checkpoints(self, transceiver, placements, graph_mapper):
+        """ Read the checkpoint of each core of this vertex
+
+        :return: a dict of checkpoints keyed by the (lo_atom, hi_atom) of\
+            each core
+        """
+        checkpoints = dict()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(self):
+            placement = placements.get_placement_of_subvertex(subvertex)
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+            checkpoint = read_checkpoint(transceiver, placement)
+            if checkpoint is None:
+                raise ConfigurationException(
+                    "Neurons {}:{} have not taken a checkpoint".format(
+                        vertex_slice.lo_atom, vertex_slice.hi_atom))
+            checkpoints[(vertex_slice.lo_atom, vertex_slice.hi_atom)] = \
+                checkpoint
+        return checkpoints
+
+    @property
+    def checkpoint_time(self):
+        return self._checkpoint_time
@@ -0,0 +1,204 @@
+""" Fixed synaptic rows with a codebook of weights.
+
+    A static row usually has only a few distinct weights, so builds with\
+    SYNAPSE_CODEBOOK_ROWS accept a fixed region which holds its synapses as\
+    16-bit half-words: the ring buffer offset (delay, type and index) of the\
+    synapse below the index of its weight in a codebook at the start of the\
+    region.  This halves the SDRAM and the DMA of the row.  The first word of\
+    such a region is (number of synapses << 16) | 0xFFFF; a 32-bit synaptic\
+    word never has all of its offset bits set, so the core tells the formats\
+    apart from this word.
+
+    A row is written with a codebook when it is shorter that way and its\
+    weights fit the codebook: exactly, or for a row of one synapse type,\
+    rounded to evenly spaced levels with an error of at most the\
+    max_quantisation_error of the post-synaptic vertex, as a fraction of the\
+    largest weight of the row.  See fixed_row_formats.py for how the rows of\
+    a vertex are written.
+"""
+import numpy
+
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
+    fixed_synapse_row_io import FixedSynapseRowIO
+
+from spynnaker_extra_pynn_models.neuron.delay_bits \
+    import MAX_SYNAPSE_DELAY_BITS
+
+# Synaptic row bit fields of the builds; the type and delay bits vary by build
+_SYNAPSE_INDEX_BITS = 8
+
+# The low half-word of the first word of a codebook row
+CODEBOOK_ROW_MARKER = 0xFFFF
+
+
+def _get_offset_bits(n_synapse_type_bits, n_synapse_delay_bits):
+    return n_synapse_delay_bits + n_synapse_type_bits + _SYNAPSE_INDEX_BITS
+
+
+def get_n_codes(n_synapse_type_bits,
+                n_synapse_delay_bits=MAX_SYNAPSE_DELAY_BITS):
+    """ Get the size of the codebook of rows for the synapse type and\
+        delay bits of a build; the codes take the bits of a half-word left\
+        by the offset
+    """
+    return 1 << (16 - _get_offset_bits(
+        n_synapse_type_bits, n_synapse_delay_bits))
+
+
+def get_codebook_row_words(n_synapses, n_codes):
+    """ Get the words of the fixed synapses of a codebook row
+    """
+    return 1 + ((n_codes + 1) // 2) + ((n_synapses + 1) // 2)
+
+
+def get_slice_mask(synapse_row, lo_atom=None, hi_atom=None):
+    """ Get which synapses of a row go to the neurons of a slice
+    """
+    target_indices = numpy.asarray(synapse_row.target_indices)
+    in_slice = numpy.ones(len(target_indices), dtype="bool")
+    if lo_atom is not None:
+        in_slice &= target_indices >= lo_atom
+    if hi_atom is not None:
+        in_slice &= target_indices <= hi_atom
+    return in_slice
+
+
+def choose_codebook(weights, synapse_types, n_codes, max_error):
+    """ Choose the codebook of the weights of a row
+
+    :param weights: the weights of the synapses
+    :param synapse_types: the synapse types of the synapses
+    :param n_codes: the size of the codebook
+    :param max_error: the largest error allowed when rounding the weights\
+        to levels, as a fraction of the largest weight, or 0 to only\
+        allow a codebook of the weights themselves
+    :return: the code of each synapse, the (synapse type, weight) of each\
+        code and whether the codes are the weights themselves, or None if\
+        the weights don't fit a codebook
+    """
+    magnitudes = numpy.abs(numpy.asarray(weights, dtype="float64"))
+    synapse_types = numpy.asarray(synapse_types)
+    keys = list(zip(synapse_types.tolist(), magnitudes.tolist()))
+    levels = sorted(set(keys))
+    if len(levels) <= n_codes:
+        code_of_level = dict((level, code)
+                             for code, level in enumerate(levels))
+        return (numpy.array([code_of_level[key] for key in keys],
+                            dtype="uint32"), levels, True)
+
+    # Rounding to levels can't share a code between synapse types
+    if max_error <= 0 or len(set(synapse_types.tolist())) != 1:
+        return None
+    largest = numpy.amax(magnitudes)
+    level_weights = numpy.linspace(numpy.amin(magnitudes), largest, n_codes)
+    codes = numpy.argmin(numpy.abs(
+        magnitudes[:, numpy.newaxis] - level_weights[numpy.newaxis, :]),
+        axis=1)
+    error = numpy.amax(numpy.abs(magnitudes - level_weights[codes]))
+    if error > max_error * largest:
+        return None
+    synapse_type = int(synapse_types[0])
+    return (codes.astype("uint32"),
+            [(synapse_type, float(level)) for level in level_weights], False)
+
+
+class CodebookSynapseRowIO(FixedSynapseRowIO):
+    """ Row IO of static synapses which writes each row with a codebook of\
+        its weights when that is shorter, and reads rows in either format
+    """
+
+    def __init__(self, n_synapse_type_bits, max_quantisation_error=0.0,
+                 n_synapse_delay_bits=MAX_SYNAPSE_DELAY_BITS):
+        """
+
+        :param n_synapse_type_bits: the synapse type bits of the build
+        :param max_quantisation_error: the largest error of a rounded\
+            weight, as a fraction of the largest weight of its row, or None\
+            to never use a codebook
+        :param n_synapse_delay_bits: the synapse delay bits of the build
+        """
+        FixedSynapseRowIO.__init__(self)
+        self._n_codes = get_n_codes(n_synapse_type_bits, n_synapse_delay_bits)
+        self._offset_bits = _get_offset_bits(
+            n_synapse_type_bits, n_synapse_delay_bits)
+        self._max_quantisation_error = max_quantisation_error
+
+    def _get_codebook(self, weights, synapse_types):
+        """ Get the codebook of a row, or None to write it in full
+        """
+        if self._max_quantisation_error is None or \
+                get_codebook_row_words(len(weights), self._n_codes) >= \
+                len(weights):
+            return None
+        return choose_codebook(weights, synapse_types, self._n_codes,
+                               self._max_quantisation_error)
+
+    def get_n_words(self, synapse_row, lo_atom=None, hi_atom=None):
+        n_words = super(CodebookSynapseRowIO, self).get_n_words(
+            synapse_row, lo_atom, hi_atom)
+        in_slice = get_slice_mask(synapse_row, lo_atom, hi_atom)
+        codebook = self._get_codebook(
+            numpy.asarray(synapse_row.weights)[in_slice],
+            numpy.asarray(synapse_row.synapse_types)[in_slice])
+        if codebook is None:
+            return n_words
+        return get_codebook_row_words(numpy.count_nonzero(in_slice),
+                                      self._n_codes)
+
+    def get_packed_fixed_fixed_region(
+            self, synapse_row, weight_scales, n_synapse_type_bits):
+        words = super(CodebookSynapseRowIO, self) \
+            .get_packed_fixed_fixed_region(
+                synapse_row, weight_scales, n_synapse_type_bits)
+        codebook = self._get_codebook(
+            synapse_row.weights, synapse_row.synapse_types)
+        if codebook is None:
+            return words
+        codes, levels, exact = codebook
+
+        # A codebook of the weights themselves takes them from the words, so
+        # that they are scaled exactly as a full row would have them
+        code_weights = numpy.zeros(self._n_codes, dtype="uint32")
+        if exact:
+            code_weights[codes] = words >> 16
+        else:
+            for code, (synapse_type, weight) in enumerate(levels):
+                code_weights[code] = min(int(numpy.rint(
+                    weight * weight_scales[synapse_type])), 0xFFFF)
+
+        offset_bits = self._offset_bits
+        half_words = numpy.zeros(
+            2 * (get_codebook_row_words(len(words), self._n_codes) - 1),
+            dtype="<u2")
+        half_words[:self._n_codes] = code_weights
+        half_words[self._n_codes:self._n_codes + len(words)] = \
+            (codes << offset_bits) | (words & ((1 << offset_bits) - 1))
+        header = numpy.array(
+            [(len(words) << 16) | CODEBOOK_ROW_MARKER], dtype="<u4")
+        return numpy.concatenate((header, half_words.view("<u4"))) \
+            .astype("uint32")
+
+    def create_row_info_from_elements(
+            self, p_p_entries, f_f_entries, f_p_entries,
+            bits_reserved_for_type, weight_scale):
+        f_f_entries = numpy.asarray(f_f_entries, dtype="uint32")
+        if len(f_f_entries) > 0 and \
+                (f_f_entries[0] & 0xFFFF) == CODEBOOK_ROW_MARKER:
+            f_f_entries = _decode_codebook_row(
+                f_f_entries, self._n_codes, self._offset_bits)
+        return super(CodebookSynapseRowIO, self) \
+            .create_row_info_from_elements(
+                p_p_entries, f_f_entries, f_p_entries,
+                bits_reserved_for_type, weight_scale)
+
+
+def _decode_codebook_row(f_f_entries, n_codes, offset_bits):
+    """ Get the synaptic words of the fixed synapses of a codebook row
+    """
+    n_synapses = int(f_f_entries[0]) >> 16
+    half_words = f_f_entries[1:].astype("<u4").view("<u2").astype("uint32")
+    code_weights = half_words[:n_codes]
+    synapses = half_words[n_codes:n_codes + n_synapses]
+    return ((code_weights[synapses >> offset_bits] << 16) |
+            (synapses & ((1 << offset_bits) - 1))).astype("uint32")
+
@@ -0,0 +1,158 @@
+""" CPU cost model of the synaptic processing of the builds in\
+    neural_modelling/src/neuron/builds, in cycles per timestep, used by the\
+    model classes to tell the partitioner how many neurons fit on a core.
+
+    Upstream only counts the neuron update, so the synaptic work of each\
+    timestep (the ring buffer drain and the processing of each incoming\
+    synaptic event) is added here, using the plasticity rule compiled into\
+    the binary and an expected rate of synaptic events per neuron.  The\
+    neuron components keep their own counts.
+
+    The cycle counts below are uncalibrated estimates, read off the inner\
+    loops of the kernels; none has been measured on a board.  So that they\
+    don't change how existing models are partitioned, the synaptic work is\
+    only counted once set_expected_synaptic_event_rate has been called;\
+    until then the estimates are upstream's.  Check the counts for a\
+    network with the synapse provenance region, which reports the cycles\
+    each phase of a timestep actually takes, and overrun_calibration.py,\
+    which scales the estimates of each model class by how far its cores\
+    overran them.
+"""
+import math
+
+# Cycles per neuron and synapse type to move a ring buffer entry into the
+# input buffers at the start of each timestep
+RING_BUFFER_DRAIN_CYCLES_PER_TYPE = 12
+
+# Cycles per neuron with background noise to draw its spikes each timestep,
+# and per background spike drawn; see background_noise.py
+BACKGROUND_NOISE_CYCLES_PER_NEURON = 30
+BACKGROUND_NOISE_CYCLES_PER_EVENT = 25
+
+# Cycles to fetch and start processing one synaptic row, and the mean number
+# of synapses per row over which this is shared
+ROW_CYCLES = 350
+MEAN_ROW_LENGTH = 32
+
+# Cycles per synapse processed, keyed by the timing dependence suffix of the
+# binary; None is a static synapse
+SYNAPSE_CYCLES = {
+    None: 15,
+    "pair": 150,
+    "pair_kernel": 130,
+    "vogels_2011": 160,
+    "recurrent_pre_stochastic": 180,
+    "recurrent_dual_fsm": 200}
+
+# The default expected synaptic events per neuron per second, e.g. 1000.0
+# for 100 inputs firing at 10Hz, or None to not count the synaptic work
+_expected_synaptic_event_rate = None
+
+# The factor by which the estimates of each model class are scaled, by the
+# name of the class; 1.0 for those not calibrated
+_cpu_calibration = dict()
+
+
+def set_expected_synaptic_event_rate(new_value):
+    """ Set the synaptic events per neuron per second that the model classes\
+        assume when estimating CPU usage, which makes them count the\
+        synaptic work of their cores
+
+    :param new_value: events per neuron per second, or None to not count\
+        the synaptic work, as by default
+    """
+    global _expected_synaptic_event_rate
+    _expected_synaptic_event_rate = (
+        None if new_value is None else float(new_value))
+
+
+def set_cpu_calibration(model_name, factor):
+    """ Set the factor by which the CPU estimates of a model class are\
+        scaled, so that fewer of its neurons are placed on each core
+
+    :param model_name: the name of the class, e.g. IFCurrDelta
+    :param factor: the factor, or None to not scale its estimates
+    """
+    if factor is None:
+        _cpu_calibration.pop(model_name, None)
+    else:
+        _cpu_calibration[model_name] = float(factor)
+
+
+def get_cpu_calibration(model_name):
+    """ Get the factor by which the CPU estimates of a model class are\
+        scaled
+    """
+    return _cpu_calibration.get(model_name, 1.0)
+
+
+def get_plasticity_rule(binary_name):
+    """ Get the timing dependence compiled into a binary from its name
+
+    :param binary_name: the name of the binary, e.g.\
+        IF_curr_exp_stdp_mad_vogels_2011_additive.aplx
+    :return: a key of SYNAPSE_CYCLES
+    """
+    if binary_name is None or "_stdp_" not in binary_name:
+        return None
+
+    # The longest suffix that matches, as pair is part of pair_kernel
+    rule = None
+    for candidate in SYNAPSE_CYCLES:
+        if (candidate is not None and
+                "_{}_".format(candidate) in binary_name and
+                (rule is None or len(candidate) > len(rule))):
+            rule = candidate
+    return rule
+
+
+def get_synaptic_cycles_per_timestep(
+        n_neurons, n_synapse_types, machine_time_step, plasticity_rule=None,
+        synaptic_event_rate=None):
+    """ Get the cycles used each timestep by the synaptic processing of a\
+        core
+
+    :param n_neurons: the number of neurons on the core
+    :param n_synapse_types: the number of synapse types of the model
+    :param machine_time_step: the machine time step in us
+    :param plasticity_rule: a key of SYNAPSE_CYCLES
+    :param synaptic_event_rate: expected synaptic events per neuron per\
+        second, or None for the default
+    :return: cycles per timestep, or 0 if no rate is set
+    """
+    if synaptic_event_rate is None:
+        synaptic_event_rate = _expected_synaptic_event_rate
+    if synaptic_event_rate is None:
+        return 0
+    events_per_timestep = (
+        n_neurons * synaptic_event_rate *
+        (float(machine_time_step) / 1000000.0))
+
+    drain_cycles = n_neurons * n_synapse_types * (
+        RING_BUFFER_DRAIN_CYCLES_PER_TYPE)
+    event_cycles = events_per_timestep * (
+        SYNAPSE_CYCLES[plasticity_rule] +
+        (float(ROW_CYCLES) / float(MEAN_ROW_LENGTH)))
+    return drain_cycles + int(event_cycles)
+
+
+class CpuCostModelVertex(object):
+    """ Population vertex mixin which adds the synaptic processing of the\
+        cost model to the neuron update counted by AbstractPopulationVertex,\
+        and scales the total by the calibration of the model class.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, n_synapse_types, machine_time_step):
+        self._cost_model_n_synapse_types = n_synapse_types
+        self._cost_model_machine_time_step = machine_time_step
+
+    def get_cpu_usage_for_atoms(self, vertex_slice, graph):
+        cycles = (super(CpuCostModelVertex, self)
+                  .get_cpu_usage_for_atoms(vertex_slice, graph) +
+                  get_synaptic_cycles_per_timestep(
+                      vertex_slice.n_atoms, self._cost_model_n_synapse_types,
+                      self._cost_model_machine_time_step,
+                      get_plasticity_rule(self.get_binary_file_name())))
+        return int(math.ceil(
+            cycles * get_cpu_calibration(type(self).__name__)))
@@ -0,0 +1,95 @@
+""" Choice of the SYNAPSE_DELAY_BITS of the build of a population.
+
+    The ring buffers of a core have an entry per neuron and synapse type for\
+    each timestep of delay that the delay bits of the build can address, so\
+    a population whose incoming delays are all short only needs a fraction\
+    of them.  The static builds have variants with fewer delay bits (those\
+    in neural_modelling/src/neuron/builds named *_delay_bits_<bits>); the\
+    delay field of a synaptic word stays where it is, so the rows are the\
+    same, with the unused delay bits clear.
+"""
+import os
+
+from spynnaker_extra_pynn_models.neuron.build_descriptions \
+    import MAX_SYNAPSE_DELAY_BITS, DELAY_BITS_VARIANTS
+from spynnaker_extra_pynn_models.neuron.turbo import TurboSyncEdge
+
+
+def get_max_incoming_delay(graph, vertex):
+    """ Get the longest delay of the synapses of the projections to a vertex
+
+    :return: the delay in timesteps, or None if it can't be told from the\
+        edges
+    """
+    max_delay = 0
+    for edge in graph.incoming_edges_to_vertex(vertex):
+        if isinstance(edge, TurboSyncEdge):
+            continue
+        synapse_list = getattr(edge, "synapse_list", None)
+        if synapse_list is None:
+            return None
+        max_delay = max(max_delay, synapse_list.get_max_delay())
+    return max_delay
+
+
+def get_synapse_delay_bits(max_delay, variants=DELAY_BITS_VARIANTS):
+    """ Get the fewest delay bits of a variant which covers a delay
+
+    :param max_delay: the longest delay in timesteps, or None if unknown
+    :return: the delay bits, MAX_SYNAPSE_DELAY_BITS if no variant covers it
+    """
+    if max_delay is not None:
+        for delay_bits in sorted(variants):
+            if max_delay < (1 << delay_bits):
+                return delay_bits
+    return MAX_SYNAPSE_DELAY_BITS
+
+
+def get_delay_bits_binary(binary, delay_bits):
+    """ Get the name of the variant of a binary with fewer delay bits
+    """
+    if delay_bits == MAX_SYNAPSE_DELAY_BITS:
+        return binary
+    title, extension = os.path.splitext(binary)
+    return "{}_delay_bits_{}{}".format(title, delay_bits, extension)
+
+
+class DelayBitsVertex(object):
+    """ Population vertex mixin which runs the variant of its binary with\
+        the fewest delay bits that covers the delays of its incoming\
+        projections.\
+        Must come before FixedRowFormatsVertex, if used, and\
+        AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, variant_binary):
+        """
+
+        :param variant_binary: the binary which has variants, or None if\
+            the vertex runs one which doesn't
+        """
+        self._variant_binary = variant_binary
+        self._synapse_delay_bits = MAX_SYNAPSE_DELAY_BITS
+
+    def _get_synapse_delay_bits(self, graph):
+        if self._variant_binary is not None:
+            self._synapse_delay_bits = get_synapse_delay_bits(
+                get_max_incoming_delay(graph, self))
+        return self._synapse_delay_bits
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+
+        # The projections are all made by the time the graph is partitioned
+        self._get_synapse_delay_bits(graph)
+        return super(DelayBitsVertex, self).get_sdram_usage_for_atoms(
+            vertex_slice, graph)
+
+    def get_binary_file_name(self):
+        binary = super(DelayBitsVertex, self).get_binary_file_name()
+        if binary != self._variant_binary:
+            return binary
+        return get_delay_bits_binary(binary, self._synapse_delay_bits)
+
+    @property
+    def synapse_delay_bits(self):
+        return self._synapse_delay_bits
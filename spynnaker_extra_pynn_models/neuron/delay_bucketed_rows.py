@@ -0,0 +1,147 @@
+""" Fixed synaptic rows grouped by delay.
+
+    The synapses of a row each have their own delay, so the ring buffer\
+    entry of each is found separately.  Builds with\
+    SYNAPSE_DELAY_BUCKETED_ROWS also accept a fixed region whose synapses\
+    are in groups of the same delay and type: a word of the ring buffer\
+    offset of the group (delay and type, in their bits of a synaptic word)\
+    above the number of synapses in the group, then the weight and index of\
+    each synapse.  The core finds the entries of each group once, and adds\
+    only the index of each synapse to them.  The first word of such a region\
+    is (number of groups << 16) | 0xFFFE, which no synaptic word is.
+
+    A row is written in groups when it has at least MIN_GROUP_SYNAPSES\
+    synapses per group, so that the group words add little to its DMA, and\
+    it is not written with a codebook.  The delay and type bits of the\
+    synapse words are left clear, so the index of a synapse could take them\
+    in a build which only accepts grouped rows.
+"""
+import numpy
+
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
+    fixed_synapse_row_io import FixedSynapseRowIO
+
+from spynnaker_extra_pynn_models.neuron.codebook_rows \
+    import CodebookSynapseRowIO
+from spynnaker_extra_pynn_models.neuron.codebook_rows import get_slice_mask
+from spynnaker_extra_pynn_models.neuron.delay_bits \
+    import MAX_SYNAPSE_DELAY_BITS
+
+# Synaptic row bit fields of the builds; the type bits vary by build
+_SYNAPSE_INDEX_BITS = 8
+
+# The low half-word of the first word of a delay-bucketed row
+DELAY_BUCKETED_ROW_MARKER = 0xFFFE
+
+# The mean synapses per group a row needs to be written in groups
+MIN_GROUP_SYNAPSES = 8
+
+
+def get_n_delay_groups(delays, synapse_types):
+    """ Get the number of groups of the synapses of a row
+    """
+    return len(set(zip(numpy.asarray(delays).tolist(),
+                       numpy.asarray(synapse_types).tolist())))
+
+
+def get_delay_bucketed_row_words(n_synapses, n_groups):
+    """ Get the words of the fixed synapses of a delay-bucketed row
+    """
+    return 1 + n_groups + n_synapses
+
+
+class DelayBucketedSynapseRowIO(CodebookSynapseRowIO):
+    """ Row IO of static synapses which writes each row with a codebook of\
+        its weights when it can, or else in groups of the same delay and\
+        type when they are large enough, and reads rows in any format
+    """
+
+    def __init__(self, n_synapse_type_bits, max_quantisation_error=0.0,
+                 delay_bucketed_rows=True,
+                 n_synapse_delay_bits=MAX_SYNAPSE_DELAY_BITS):
+        CodebookSynapseRowIO.__init__(
+            self, n_synapse_type_bits, max_quantisation_error,
+            n_synapse_delay_bits)
+        self._delay_bucketed_rows = delay_bucketed_rows
+
+    def _is_delay_bucketed(self, weights, delays, synapse_types):
+        """ Determine if a row is written in groups
+        """
+        if not self._delay_bucketed_rows or len(weights) == 0:
+            return False
+        if self._get_codebook(weights, synapse_types) is not None:
+            return False
+        n_groups = get_n_delay_groups(delays, synapse_types)
+        return n_groups * MIN_GROUP_SYNAPSES <= len(weights)
+
+    def get_n_words(self, synapse_row, lo_atom=None, hi_atom=None):
+        in_slice = get_slice_mask(synapse_row, lo_atom, hi_atom)
+        delays = numpy.asarray(synapse_row.delays)[in_slice]
+        synapse_types = numpy.asarray(synapse_row.synapse_types)[in_slice]
+        if self._is_delay_bucketed(
+                numpy.asarray(synapse_row.weights)[in_slice], delays,
+                synapse_types):
+            return get_delay_bucketed_row_words(
+                len(delays), get_n_delay_groups(delays, synapse_types))
+        return super(DelayBucketedSynapseRowIO, self).get_n_words(
+            synapse_row, lo_atom, hi_atom)
+
+    def get_packed_fixed_fixed_region(
+            self, synapse_row, weight_scales, n_synapse_type_bits):
+        if not self._is_delay_bucketed(
+                synapse_row.weights, synapse_row.delays,
+                synapse_row.synapse_types):
+            return super(DelayBucketedSynapseRowIO, self) \
+                .get_packed_fixed_fixed_region(
+                    synapse_row, weight_scales, n_synapse_type_bits)
+        words = FixedSynapseRowIO.get_packed_fixed_fixed_region(
+            self, synapse_row, weight_scales, n_synapse_type_bits)
+
+        # The delay and type of each synapse, in their bits of its word
+        offsets = (words & 0xFFFF) >> _SYNAPSE_INDEX_BITS
+        order = numpy.argsort(offsets, kind="mergesort")
+        group_offsets, group_starts, group_sizes = numpy.unique(
+            offsets[order], return_index=True, return_counts=True)
+        synapse_words = words[order] & (
+            0xFFFF0000 | ((1 << _SYNAPSE_INDEX_BITS) - 1))
+
+        region = [numpy.array(
+            [(len(group_offsets) << 16) | DELAY_BUCKETED_ROW_MARKER],
+            dtype="uint32")]
+        for group_offset, start, size in zip(
+                group_offsets, group_starts, group_sizes):
+            region.append(numpy.array(
+                [(int(size) << 16) | (int(group_offset) <<
+                                      _SYNAPSE_INDEX_BITS)],
+                dtype="uint32"))
+            region.append(synapse_words[start:start + size])
+        return numpy.concatenate(region).astype("uint32")
+
+    def create_row_info_from_elements(
+            self, p_p_entries, f_f_entries, f_p_entries,
+            bits_reserved_for_type, weight_scale):
+        f_f_entries = numpy.asarray(f_f_entries, dtype="uint32")
+        if len(f_f_entries) > 0 and \
+                (f_f_entries[0] & 0xFFFF) == DELAY_BUCKETED_ROW_MARKER:
+            f_f_entries = _decode_delay_bucketed_row(f_f_entries)
+        return super(DelayBucketedSynapseRowIO, self) \
+            .create_row_info_from_elements(
+                p_p_entries, f_f_entries, f_p_entries,
+                bits_reserved_for_type, weight_scale)
+
+
+def _decode_delay_bucketed_row(f_f_entries):
+    """ Get the synaptic words of the fixed synapses of a delay-bucketed row
+    """
+    n_groups = int(f_f_entries[0]) >> 16
+    words = list()
+    position = 1
+    for _ in range(n_groups):
+        group = int(f_f_entries[position])
+        n_synapses = group >> 16
+        synapse_words = f_f_entries[position + 1:position + 1 + n_synapses]
+        words.append(synapse_words | (group & 0xFFFF))
+        position += 1 + n_synapses
+    if len(words) == 0:
+        return numpy.zeros(0, dtype="uint32")
+    return numpy.concatenate(words).astype("uint32")
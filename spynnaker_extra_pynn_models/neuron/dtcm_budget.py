@@ -0,0 +1,135 @@
+""" DTCM budget of a core running one of the builds in\
+    neural_modelling/src/neuron/builds, used to choose how many neurons fit\
+    on a core rather than fixing a maximum per model.
+
+    The ring and input buffers are statically sized by the synaptic row bit\
+    fields, so only the per-neuron state grows with the slice.  With 8 index\
+    bits, as all of the builds have, the budget can at most lift the limit\
+    of 255 neurons per core to the 256 the index bits can address, and the\
+    target builds, with 16 delay slots and their features, fit 255; 9 bits\
+    would double the ring and input buffers and fit none.
+"""
+
+# DTCM of a SpiNNaker core
+DTCM_BYTES = 64 * 1024
+
+# Stack and the runtime's own state
+_RESERVED_BYTES = 1024
+
+# Two DMA buffers of synaptic rows, as allocated by spike processing for
+# rows of up to 256 words
+_ROW_BUFFER_BYTES = 2 * 256 * 4
+
+# A 16-bit weight per ring buffer entry and an input_t per input buffer entry
+_RING_BUFFER_ENTRY_BYTES = 2
+_INPUT_BUFFER_ENTRY_BYTES = 4
+
+# The post-event history of each neuron: the count, and the time and trace
+# of each of MAX_POST_SYNAPTIC_EVENTS events
+_MAX_POST_SYNAPTIC_EVENTS = 4
+_POST_EVENT_TIME_BYTES = 4
+
+# The queue of rows being fetched, kept by the builds with any feature which
+# follows the fetched rows: FETCHED_ROWS_SIZE rows of key, address and
+# number of spikes, and its input and output
+_FETCHED_ROWS_BYTES = (4 * 3 * 4) + (2 * 4)
+
+# The set of plastic rows of the target consolidation, CONSOLIDATION_ROWS
+# addresses, and the rows whose writeback may be in flight
+_CONSOLIDATION_BYTES = ((1 << 9) * 4) + (2 * 4)
+
+# The bitmap of the chunks of CHECKPOINT_CHUNK_BYTES of the synaptic matrix
+# which the background copy of a checkpoint has copied
+_CHECKPOINT_CHUNK_BYTES = 1 << 7
+
+# The address and last recorded weight of each recorded synapse
+_WEIGHT_RECORDING_SYNAPSE_BYTES = 4 + 2
+
+
+def get_post_event_history_bytes(post_trace_bytes):
+    """ Get the size of the post-event history of a neuron
+
+    :param post_trace_bytes: bytes of post_trace_t
+    """
+    return 4 + (_MAX_POST_SYNAPTIC_EVENTS * (
+        _POST_EVENT_TIME_BYTES + post_trace_bytes))
+
+
+def get_checkpoint_chunks_bytes(matrix_bytes):
+    """ Get the size of the bitmap of the chunks of a synaptic matrix which\
+        have been copied into a checkpoint
+
+    :param matrix_bytes: the size of the synaptic matrix of the core
+    """
+    n_chunks = (matrix_bytes + (_CHECKPOINT_CHUNK_BYTES - 1)) // \
+        _CHECKPOINT_CHUNK_BYTES
+    return ((n_chunks + 31) // 32) * 4
+
+
+def get_weight_recording_bytes(max_synapses):
+    """ Get the DTCM used to record the weights of max_synapses synapses
+    """
+    return max_synapses * _WEIGHT_RECORDING_SYNAPSE_BYTES
+
+
+def get_dtcm_usage(
+        n_neurons, synapse_index_bits, synapse_type_bits, synapse_delay_bits,
+        neuron_params_bytes, synapse_params_bytes, plasticity_params_bytes=0,
+        post_trace_bytes=None, fetched_rows=False, consolidation=False,
+        checkpoint_matrix_bytes=None, weight_recording_synapses=0):
+    """ Get the DTCM used by a core simulating n_neurons neurons
+
+    :param synapse_index_bits: SYNAPSE_INDEX_BITS of the build
+    :param synapse_type_bits: SYNAPSE_TYPE_BITS of the build
+    :param synapse_delay_bits: SYNAPSE_DELAY_BITS of the build
+    :param neuron_params_bytes: bytes of neuron_t per neuron
+    :param synapse_params_bytes: bytes of synapse_param_t of all synapse\
+        types per neuron
+    :param plasticity_params_bytes: bytes of the plasticity region copied\
+        into DTCM, i.e. the LUTs
+    :param post_trace_bytes: bytes of post_trace_t, or None if the build is\
+        not plastic
+    :param fetched_rows: whether the build queues the rows being fetched\
+        (FETCHED_ROWS in synapses.c)
+    :param consolidation: whether the build consolidates the target rule's\
+        updates (TARGET_CONSOLIDATION)
+    :param checkpoint_matrix_bytes: the size of the synaptic matrix the core\
+        checkpoints, or None if it doesn't take a checkpoint
+    :param weight_recording_synapses: the number of synapses whose weights\
+        the core records
+    :return: bytes of DTCM
+    """
+    ring_buffer_bytes = _RING_BUFFER_ENTRY_BYTES * (
+        1 << (synapse_delay_bits + synapse_type_bits + synapse_index_bits))
+    input_buffer_bytes = _INPUT_BUFFER_ENTRY_BYTES * (
+        1 << (synapse_type_bits + synapse_index_bits))
+    per_neuron_bytes = neuron_params_bytes + synapse_params_bytes
+    if post_trace_bytes is not None:
+        per_neuron_bytes += get_post_event_history_bytes(post_trace_bytes)
+
+    feature_bytes = get_weight_recording_bytes(weight_recording_synapses)
+    if fetched_rows:
+        feature_bytes += _FETCHED_ROWS_BYTES
+    if consolidation:
+        feature_bytes += _CONSOLIDATION_BYTES
+    if checkpoint_matrix_bytes is not None:
+        feature_bytes += get_checkpoint_chunks_bytes(checkpoint_matrix_bytes)
+
+    return (_RESERVED_BYTES + _ROW_BUFFER_BYTES + ring_buffer_bytes +
+            input_buffer_bytes + plasticity_params_bytes + feature_bytes +
+            (n_neurons * per_neuron_bytes))
+
+
+def get_max_atoms_per_core(synapse_index_bits, **kwargs):
+    """ Get the most neurons that fit in DTCM and can be addressed by the\
+        synapse index bits of a build
+
+    :param synapse_index_bits: SYNAPSE_INDEX_BITS of the build
+    :param kwargs: the other arguments of get_dtcm_usage
+    :return: the maximum number of neurons per core
+    """
+    fixed_bytes = get_dtcm_usage(0, synapse_index_bits, **kwargs)
+    per_neuron_bytes = (
+        get_dtcm_usage(1, synapse_index_bits, **kwargs) - fixed_bytes)
+    n_neurons = (DTCM_BYTES - fixed_bytes) // per_neuron_bytes
+    return max(0, min(n_neurons, 1 << synapse_index_bits))
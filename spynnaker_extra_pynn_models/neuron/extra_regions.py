@@ -0,0 +1,59 @@
+import struct
+
+from enum import Enum
+
+# Data specification regions used by the extra models on top of
+# constants.POPULATION_BASED_REGIONS; must match extra_regions_e in
+# neural_modelling/src/neuron/extra_regions.h
+EXTRA_REGIONS = Enum(
+    value="EXTRA_REGIONS",
+    names=[('SYNAPSE_PROVENANCE', 10),
+           ('TURBO', 11),
+           ('TARGET_SCHEDULE', 12),
+           ('CHANGED_ROWS', 13),
+           ('CHECKPOINT', 14),
+           ('BACKGROUND_NOISE', 15)])
+
+# Size of the data specification header (magic number and version) which
+# precedes the region table
+_DATA_SPECIFICATION_HEADER_BYTES = 8
+
+# Entries in the region table
+_MAX_REGIONS = 16
+
+
+def get_region_address(transceiver, placement, region):
+    """ Get the SDRAM address of a region of a placed core, as written into\
+        its region table when the data specification was executed
+
+    :param transceiver: the transceiver of the machine
+    :param placement: the placement of the subvertex
+    :param region: the region to find
+    :type region: EXTRA_REGIONS
+    :return: the address, or 0 if the region was not reserved
+    """
+    data_address = transceiver.get_cpu_information_from_core(
+        placement.x, placement.y, placement.p).user[0]
+    region_table_entry = transceiver.read_memory(
+        placement.x, placement.y,
+        data_address + _DATA_SPECIFICATION_HEADER_BYTES + (4 * region.value),
+        4)
+    return struct.unpack_from("<I", str(region_table_entry))[0]
+
+
+def get_region_addresses(transceiver, placement):
+    """ Get the SDRAM address of every region of a placed core, as written\
+        into its region table when the data specification was executed
+
+    :param transceiver: the transceiver of the machine
+    :param placement: the placement of the subvertex
+    :return: a list of addresses indexed by region, with 0 for regions which\
+        were not reserved
+    """
+    data_address = transceiver.get_cpu_information_from_core(
+        placement.x, placement.y, placement.p).user[0]
+    region_table = transceiver.read_memory(
+        placement.x, placement.y,
+        data_address + _DATA_SPECIFICATION_HEADER_BYTES, 4 * _MAX_REGIONS)
+    return list(struct.unpack_from(
+        "<{}I".format(_MAX_REGIONS), str(region_table)))
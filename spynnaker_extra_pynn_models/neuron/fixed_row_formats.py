@@ -0,0 +1,70 @@
+""" Choice of the formats of the fixed synaptic rows of a vertex.
+
+    The rows of static projections can be written with a codebook of their\
+    weights (see codebook_rows.py) or in groups of the same delay (see\
+    delay_bucketed_rows.py), which the builds tell apart from the first word\
+    of the fixed region; a row which suits neither is written in full.
+"""
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics.\
+    fixed_synapse_row_io import FixedSynapseRowIO
+
+from spynnaker_extra_pynn_models.neuron.delay_bits \
+    import MAX_SYNAPSE_DELAY_BITS
+from spynnaker_extra_pynn_models.neuron.delay_bucketed_rows \
+    import DelayBucketedSynapseRowIO
+
+
+class FixedRowFormatsVertex(object):
+    """ Population vertex mixin which writes the rows of the static\
+        projections to the vertex in the shortest or fastest format that\
+        suits each row.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, n_synapse_type_bits, max_quantisation_error=0.0,
+                 delay_bucketed_rows=True):
+        """
+
+        :param n_synapse_type_bits: the synapse type bits of the build
+        :param max_quantisation_error: the largest error of a rounded\
+            weight of a codebook row, as a fraction of the largest weight of\
+            its row, or None to not use codebooks
+        :param delay_bucketed_rows: whether rows may be grouped by delay
+        """
+        self._row_formats_n_synapse_type_bits = n_synapse_type_bits
+        self._max_quantisation_error = max_quantisation_error
+        self._delay_bucketed_rows = delay_bucketed_rows
+
+    def _get_synapse_delay_bits(self, graph):
+        """ Get the synapse delay bits of the build; DelayBitsVertex\
+            overrides this with those of the variant it chooses
+        """
+        return MAX_SYNAPSE_DELAY_BITS
+
+    def _use_fixed_row_formats(self, graph):
+        if (self._max_quantisation_error is None and
+                not self._delay_bucketed_rows):
+            return
+        n_synapse_delay_bits = self._get_synapse_delay_bits(graph)
+        for edge in graph.incoming_edges_to_vertex(self):
+            if type(getattr(edge, "synapse_row_io", None)) is \
+                    FixedSynapseRowIO:
+                edge._synapse_row_io = DelayBucketedSynapseRowIO(
+                    self._row_formats_n_synapse_type_bits,
+                    self._max_quantisation_error, self._delay_bucketed_rows,
+                    n_synapse_delay_bits)
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+
+        # The rows are sized, and later written, by the row IO of each edge
+        self._use_fixed_row_formats(graph)
+        return super(FixedRowFormatsVertex, self).get_sdram_usage_for_atoms(
+            vertex_slice, graph)
+
+    @property
+    def max_quantisation_error(self):
+        return self._max_quantisation_error
+
+    @property
+    def delay_bucketed_rows(self):
+        return self._delay_bucketed_rows
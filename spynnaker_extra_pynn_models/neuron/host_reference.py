@@ -0,0 +1,165 @@
+""" Running a network on the host with the host reference simulator.
+
+    The host builds of the neuron applications (make in\
+    neural_modelling/host_reference) run the same code as on SpiNNaker, one\
+    process per core.  A network is mapped and its data specifications\
+    executed as usual (e.g. on a virtual machine); write_configuration then\
+    lists each core with its host binary and the memory image its data\
+    specification was executed into, and the routes of spikes between\
+    cores.  After host_reference has run the configuration, what the cores\
+    wrote, such as recordings and plastic weights, is in the images, and\
+    HostReferenceTransceiver reads it as the transceiver would read it from\
+    the machine.
+
+    Only the neuron applications of the extra models have host builds; a\
+    network with other vertices, such as spike sources, can't be run.  Nor\
+    can one in turbo mode, as the host routes don't carry payloads; the\
+    host reference already runs each timestep as fast as it can.
+"""
+import glob
+import os
+import struct
+import subprocess
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+
+# The region table follows the magic number and version, and the regions
+# follow the region table
+_DATA_SPECIFICATION_HEADER_BYTES = 8
+_REGION_TABLE_BYTES = 64
+
+
+def get_image_filename(app_data_folder, placement):
+    """ Find the memory image into which the data specification of a core\
+        was executed
+    """
+    filenames = glob.glob(os.path.join(
+        app_data_folder, "*_{}_{}_{}.dat".format(
+            placement.x, placement.y, placement.p)))
+    if len(filenames) != 1:
+        raise ConfigurationException(
+            "No memory image of core {},{},{} in {}".format(
+                placement.x, placement.y, placement.p, app_data_folder))
+    return filenames[0]
+
+
+def write_configuration(spinnaker, app_data_folder, filename):
+    """ Write the configuration of host_reference for a mapped network
+
+    :param spinnaker: the Spinnaker of the network, after mapping and\
+        executing the data specifications
+    :param app_data_folder: the folder of the executed memory images
+    :param filename: the configuration file to write
+    :return: the index of each placement in the configuration, by the\
+        (x, y, p) of its core
+    """
+    graph_mapper = spinnaker.graph_mapper
+    placements = spinnaker.placements
+    cores = dict()
+    with open(filename, "w") as f:
+        for placement in placements.placements:
+            vertex = graph_mapper.get_vertex_from_subvertex(
+                placement.subvertex)
+            if getattr(vertex, "turbo_watchdog_ticks", None) is not None:
+                raise ConfigurationException(
+                    "{} is in turbo mode".format(vertex.label))
+            binary = spinnaker._executable_finder.get_executable_path(
+                vertex.get_binary_file_name())
+            host_binary = os.path.splitext(binary)[0] + ".host"
+            if not os.path.exists(host_binary):
+                raise ConfigurationException(
+                    "{} has no host build".format(
+                        vertex.get_binary_file_name()))
+            f.write("core {} {} {} {} {}\n".format(
+                placement.x, placement.y, placement.p, host_binary,
+                get_image_filename(app_data_folder, placement)))
+            cores[(placement.x, placement.y, placement.p)] = len(cores)
+
+        # Spikes of a core go to every core it has a subedge to, once
+        routes = set()
+        for subedge in spinnaker.partitioned_graph.subedges:
+            pre = placements.get_placement_of_subvertex(
+                subedge.pre_subvertex)
+            post = placements.get_placement_of_subvertex(
+                subedge.post_subvertex)
+            routes.add((cores[(pre.x, pre.y, pre.p)],
+                        cores[(post.x, post.y, post.p)]))
+        for source, destination in sorted(routes):
+            f.write("route {} {}\n".format(source, destination))
+    return cores
+
+
+def run(configuration, cpus=None, executable=None):
+    """ Run a configuration with host_reference
+
+    :param cpus: the number of CPUs to run on, or None for all of them;\
+        1 is the single-threaded baseline
+    :param executable: the driver, by default the one built in\
+        neural_modelling/host_reference
+    :return: what host_reference reported of the run
+    """
+    if executable is None:
+        executable = os.path.join(
+            os.path.dirname(__file__), "..", "..", "neural_modelling",
+            "host_reference", "host_reference")
+    command = [executable]
+    if cpus is not None:
+        command += ["--cpus", str(cpus)]
+    return subprocess.check_output(command + [configuration])
+
+
+class _CpuInformation(object):
+
+    def __init__(self, user_0):
+        self._user = [user_0, 0, 0, 0]
+
+    @property
+    def user(self):
+        return self._user
+
+
+class HostReferenceTransceiver(object):
+    """ Reads and writes the memory images of the cores of a host reference\
+        run in place of the SDRAM of the machine, for the functions which\
+        read results back from a transceiver
+    """
+
+    def __init__(self, spinnaker, app_data_folder):
+        self._images = dict()
+        for placement in spinnaker.placements.placements:
+            filename = get_image_filename(app_data_folder, placement)
+            with open(filename, "rb") as f:
+                header = f.read(
+                    _DATA_SPECIFICATION_HEADER_BYTES + _REGION_TABLE_BYTES)
+            regions = [address for address in struct.unpack_from(
+                "<{}I".format(_REGION_TABLE_BYTES // 4), header,
+                _DATA_SPECIFICATION_HEADER_BYTES) if address != 0]
+            base = min(regions) - len(header)
+            self._images[(placement.x, placement.y, placement.p)] = (
+                filename, base, os.path.getsize(filename))
+
+    def get_cpu_information_from_core(self, x, y, p):
+        return _CpuInformation(self._images[(x, y, p)][1])
+
+    def _locate(self, x, y, base_address, length):
+        for (image_x, image_y, _), (filename, base, size) in \
+                self._images.iteritems():
+            if (image_x == x and image_y == y and
+                    base <= base_address and
+                    base_address + length <= base + size):
+                return filename, base_address - base
+        raise ConfigurationException(
+            "No memory image of chip {},{} holds {} bytes at 0x{:08x}".format(
+                x, y, length, base_address))
+
+    def read_memory(self, x, y, base_address, length):
+        filename, offset = self._locate(x, y, base_address, length)
+        with open(filename, "rb") as f:
+            f.seek(offset)
+            return bytearray(f.read(length))
+
+    def write_memory(self, x, y, base_address, data):
+        filename, offset = self._locate(x, y, base_address, len(data))
+        with open(filename, "r+b") as f:
+            f.seek(offset)
+            f.write(data)
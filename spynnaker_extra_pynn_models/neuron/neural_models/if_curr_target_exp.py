@@ -8,14 +8,83 @@ from spynnaker.pyNN.models.abstract_models.abstract_model_components.\
 from spynnaker.pyNN.models.neural_properties.neural_parameter \
     import NeuronParameter
 
+from spynnaker_extra_pynn_models.neuron import cpu_cost_model
+from spynnaker_extra_pynn_models.neuron.changed_rows import ChangedRowsVertex
+from spynnaker_extra_pynn_models.neuron.checkpoint import CheckpointVertex
+from spynnaker_extra_pynn_models.neuron import dtcm_budget
+from spynnaker_extra_pynn_models.neuron.fixed_row_formats \
+    import FixedRowFormatsVertex
+from spynnaker_extra_pynn_models.neuron.target_schedule \
+    import TargetScheduleVertex
+from spynnaker_extra_pynn_models.neuron.background_noise \
+    import BackgroundNoiseVertex
+from spynnaker_extra_pynn_models.neuron.turbo import TurboVertex
+
 from data_specification.enums.data_type import DataType
 
 
-class IFCurrentTargetExponentialPopulation(AbstractTargetExponentialVertex,
-                                         AbstractIntegrateAndFireProperties,
-                                         AbstractPopulationVertex):
+class IFCurrentTargetExponentialPopulation(FixedRowFormatsVertex,
+                                           CheckpointVertex,
+                                           ChangedRowsVertex,
+                                           TargetScheduleVertex,
+                                           BackgroundNoiseVertex,
+                                           TurboVertex,
+                                           AbstractTargetExponentialVertex,
+                                           AbstractIntegrateAndFireProperties,
+                                           AbstractPopulationVertex):
+    """ Leaky integrate and fire neuron with exponential current inputs and\
+        a target synapse type for supervised plasticity.
+
+        Target spikes can come from teacher populations through "target"\
+        synapses, or be given as target_spike_times (a list of times in ms\
+        for every neuron, or a list of such lists, one per neuron), which\
+        the core applies directly without teacher cores or packets.
+
+        With incremental_weight_readback, reading the plastic weights back\
+        only reads the rows whose weights changed since the last read.
+
+        With checkpoint_time (in ms), each core checkpoints its plastic\
+        state at that time, which save_checkpoint can save after the run;\
+        restore_checkpoint restores such a checkpoint into a fresh run of\
+        the same network, which carries on training from that time.
+
+        The rows of static projections, such as noise and inhibition, are\
+        written with a codebook of their weights where that is shorter and\
+        rounds no weight by more than max_quantisation_error of the largest\
+        weight of its row (None to not use codebooks), or otherwise with\
+        delay_bucketed_rows in groups of the same delay where the groups\
+        are large enough.
+
+        Background input can be drawn on the core instead of coming from a\
+        noise population: each neuron with a background_noise_rate (in Hz)\
+        receives Poisson spikes of background_noise_weight through\
+        background_noise_synapse_type (0 excitatory, 1 inhibitory).
+
+        Populations put in turbo mode by enable_turbo start each timestep\
+        as soon as the populations they exchange spikes with have finished\
+        the last, for offline training faster than real time.
+    """
+
+    # None to choose the maximum from the DTCM budget
+    _model_based_max_atoms_per_core = None
+
+    # Excitatory, inhibitory and target; target synapses bypass the ring
+    # buffers, but the ring buffer drain still covers them
+    _N_SYNAPSE_TYPES = 3
+
+    # Synaptic row bit fields of the IF_curr_exp_target builds; these size
+    # the ring and input buffers
+    _SYNAPSE_INDEX_BITS = 8
+    _SYNAPSE_DELAY_BITS = 4
+
+    # neuron_t of neuron_model_lif_curr_impl.h, a decay and initial value per
+    # synapse type, the consolidation budget and the two-table pair rule LUTs
+    # and their time shifts, and post_trace_t of timing_target_pair_impl.h
+    _NEURON_PARAMS_BYTES = 9 * 4
+    _SYNAPSE_PARAMS_BYTES = _N_SYNAPSE_TYPES * 2 * 4
+    _PLASTICITY_PARAMS_BYTES = (3 * 4) + (2 * 256 * 2)
+    _POST_TRACE_BYTES = 2
 
-    _model_based_max_atoms_per_core = 255
     default_parameters = {
         'tau_m': 20.0, 'cm': 1.0, 'v_rest': -65.0, 'v_reset': -65.0,
         'v_thresh': -50.0, 'tau_syn_E': 5.0, 'tau_syn_E2': 5.0,
@@ -34,9 +103,31 @@ class IFCurrentTargetExponentialPopulation(AbstractTargetExponentialVertex,
                  tau_syn_I=default_parameters['tau_syn_I'],
                  tau_refrac=default_parameters['tau_refrac'],
                  i_offset=default_parameters['i_offset'],
-                 v_init=None):
+                 v_init=None, target_spike_times=None,
+                 incremental_weight_readback=False, checkpoint_time=None,
+                 restore_checkpoint=None, max_quantisation_error=0.0,
+                 delay_bucketed_rows=True, background_noise_rate=None,
+                 background_noise_weight=0.0, background_noise_synapse_type=0,
+                 background_noise_seed=None):
 
         # Instantiate the parent classes
+        FixedRowFormatsVertex.__init__(
+            self, IFCurrentTargetExponentialPopulation
+            .get_n_synapse_type_bits(), max_quantisation_error,
+            delay_bucketed_rows)
+        CheckpointVertex.__init__(
+            self, checkpoint_time, restore_checkpoint, machine_time_step,
+            IFCurrentTargetExponentialPopulation._POST_TRACE_BYTES)
+        ChangedRowsVertex.__init__(self, incremental_weight_readback)
+        TargetScheduleVertex.__init__(
+            self, target_spike_times, machine_time_step,
+            IFCurrentTargetExponentialPopulation._SYNAPSE_INDEX_BITS)
+        BackgroundNoiseVertex.__init__(
+            self, n_neurons, machine_time_step,
+            IFCurrentTargetExponentialPopulation._N_SYNAPSE_TYPES,
+            background_noise_rate, background_noise_weight,
+            background_noise_synapse_type, background_noise_seed)
+        TurboVertex.__init__(self)
         AbstractTargetExponentialVertex.__init__(
             self, n_neurons=n_neurons, tau_syn_E=tau_syn_E,
             tau_syn_E2=tau_syn_E2, tau_syn_I=tau_syn_I,
@@ -50,7 +141,7 @@ class IFCurrentTargetExponentialPopulation(AbstractTargetExponentialVertex,
             label=label,
             binary="IF_curr_exp_target.aplx", constraints=constraints,
             max_atoms_per_core=(IFCurrentTargetExponentialPopulation
-                                ._model_based_max_atoms_per_core),
+                                .get_model_max_atoms_per_core()),
             machine_time_step=machine_time_step,
             timescale_factor=timescale_factor,
             spikes_per_second=spikes_per_second,
@@ -62,14 +153,54 @@ class IFCurrentTargetExponentialPopulation(AbstractTargetExponentialVertex,
 
     @staticmethod
     def set_model_max_atoms_per_core(new_value):
-        IFCurrentDualExponentialPopulation.\
+        IFCurrentTargetExponentialPopulation.\
             _model_based_max_atoms_per_core = new_value
 
+    @staticmethod
+    def _get_dtcm_budget_parameters():
+        cls = IFCurrentTargetExponentialPopulation
+        return dict(
+            synapse_type_bits=cls.get_n_synapse_type_bits(),
+            synapse_delay_bits=cls._SYNAPSE_DELAY_BITS,
+            neuron_params_bytes=cls._NEURON_PARAMS_BYTES,
+            synapse_params_bytes=cls._SYNAPSE_PARAMS_BYTES,
+            plasticity_params_bytes=cls._PLASTICITY_PARAMS_BYTES,
+            post_trace_bytes=cls._POST_TRACE_BYTES,
+            fetched_rows=True, consolidation=True)
+
+    @staticmethod
+    def get_model_max_atoms_per_core():
+        """ Get the maximum atoms per core set by\
+            set_model_max_atoms_per_core, or by default the most that fit\
+            in DTCM
+        """
+        cls = IFCurrentTargetExponentialPopulation
+        if cls._model_based_max_atoms_per_core is not None:
+            return cls._model_based_max_atoms_per_core
+        return dtcm_budget.get_max_atoms_per_core(
+            cls._SYNAPSE_INDEX_BITS, **cls._get_dtcm_budget_parameters())
+
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
+        return dtcm_budget.get_dtcm_usage(
+            (vertex_slice.hi_atom - vertex_slice.lo_atom) + 1,
+            self._SYNAPSE_INDEX_BITS,
+            checkpoint_matrix_bytes=self._get_checkpoint_matrix_bytes(
+                vertex_slice, graph),
+            **self._get_dtcm_budget_parameters()) + \
+            self._get_background_noise_dtcm_bytes(vertex_slice) + \
+            self._get_turbo_dtcm_bytes()
+
     def get_cpu_usage_for_atoms(self, vertex_slice, graph):
         """
         Gets the CPU requirements for a range of atoms
         """
-        return 782 * ((vertex_slice.hi_atom - vertex_slice.lo_atom) + 1)
+        n_atoms = (vertex_slice.hi_atom - vertex_slice.lo_atom) + 1
+        return (782 * n_atoms) + \
+            cpu_cost_model.get_synaptic_cycles_per_timestep(
+                n_atoms, self._N_SYNAPSE_TYPES, self._machine_time_step,
+                cpu_cost_model.get_plasticity_rule(
+                    self.get_binary_file_name())) + \
+            self._get_background_noise_cycles(vertex_slice)
 
     def get_parameters(self):
         """
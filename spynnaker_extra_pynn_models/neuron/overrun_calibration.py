@@ -0,0 +1,145 @@
+""" Feedback of the timer overruns of a run into the partitioning of the\
+    next.
+
+    The cores of the models with the synapse provenance region count the\
+    timer ticks at which the work of the last timestep overran, and the most\
+    cycles a timestep was busy.  After a run, update_calibration compares\
+    the busiest timestep of each core with the estimate the partitioner\
+    placed it by, and sets the calibration of each model class (see\
+    cpu_cost_model.py) to the largest ratio over its cores, with some\
+    headroom, so that the next run places fewer neurons on each core of a\
+    model which overran.  The calibrations are kept in a file, from which\
+    load_calibration sets them before the next run, so that partitioning\
+    converges on the real workload over a few runs:
+
+        load_calibration("calibration.json")
+        ... make the network and run it ...
+        update_calibration(populations, "calibration.json")
+
+    The calibration of a model which overran never comes down; that of a\
+    model whose cores all had slack comes halfway down to its ratio each\
+    run, so that one quiet run doesn't undo it.
+"""
+from collections import namedtuple
+import json
+import os
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+
+from spynnaker_extra_pynn_models.neuron import cpu_cost_model
+from spynnaker_extra_pynn_models.neuron.synapse_provenance \
+    import SynapseProvenanceVertex
+
+# The cycles placed for above those of the busiest timestep seen
+DEFAULT_HEADROOM = 1.1
+
+OverrunSummary = namedtuple(
+    "OverrunSummary",
+    ["label", "n_timesteps", "n_overruns", "max_overrun_cycles",
+     "busy_ratio"])
+
+
+def load_calibration(filename):
+    """ Set the calibration of each model class from a file written by\
+        update_calibration; call before running, as the calibration is used\
+        when the populations are partitioned
+
+    :return: the calibration of each model class, by its name; empty if\
+        there is no file yet
+    """
+    if not os.path.exists(filename):
+        return dict()
+    with open(filename) as f:
+        calibration = json.load(f)
+    for model_name, model_calibration in calibration.items():
+        cpu_cost_model.set_cpu_calibration(
+            str(model_name), model_calibration["cpu_factor"])
+    return calibration
+
+
+def get_busy_ratio(vertex, provenance, graph):
+    """ Get the ratio of the cycles of the busiest timestep of a core to\
+        those it was estimated to use without calibration
+
+    :param provenance: the SynapseProvenance of the core
+    :return: the ratio, or None if nothing was estimated
+    """
+    busy_cycles = provenance.max_busy_cycles
+    if provenance.n_overruns > 0:
+        busy_cycles = max(
+            busy_cycles, vertex.provenance_timer_period_cycles +
+            provenance.max_overrun_cycles)
+    estimate = (
+        vertex.get_cpu_usage_for_atoms(provenance.vertex_slice, graph) /
+        cpu_cost_model.get_cpu_calibration(type(vertex).__name__))
+    if estimate <= 0:
+        return None
+    return busy_cycles / float(estimate)
+
+
+def update_calibration(populations, filename, headroom=DEFAULT_HEADROOM):
+    """ Read the overruns of the cores of populations after a run, and raise\
+        the calibration of the model classes which overran, in the file and\
+        for the next run in this script
+
+    :param populations: populations of models which record synapse\
+        provenance
+    :param filename: the calibration file, which is created if need be;\
+        models not in the populations keep their calibration
+    :param headroom: the factor of the cycles of the busiest timestep to\
+        place cores for
+    :return: an OverrunSummary for each population
+    """
+    spinnaker = populations[0]._spinnaker
+    graph = spinnaker.partitionable_graph
+    calibration = load_calibration(filename)
+
+    summaries = list()
+    ratios = dict()
+    overran = dict()
+    for population in populations:
+        vertex = population._vertex
+        if not isinstance(vertex, SynapseProvenanceVertex):
+            raise ConfigurationException(
+                "{} doesn't record synapse provenance".format(vertex.label))
+        model_name = type(vertex).__name__
+        provenance = vertex.get_synapse_provenance(
+            spinnaker.transceiver, spinnaker.placements,
+            spinnaker.graph_mapper)
+        if len(provenance) == 0:
+            continue
+
+        busy_ratio = None
+        for core_provenance in provenance:
+            ratio = get_busy_ratio(vertex, core_provenance, graph)
+            if ratio is not None and (busy_ratio is None or
+                                      ratio > busy_ratio):
+                busy_ratio = ratio
+        n_overruns = sum(p.n_overruns for p in provenance)
+        summaries.append(OverrunSummary(
+            label=vertex.label,
+            n_timesteps=max(p.n_timesteps for p in provenance),
+            n_overruns=n_overruns,
+            max_overrun_cycles=max(p.max_overrun_cycles for p in provenance),
+            busy_ratio=busy_ratio))
+        if busy_ratio is not None:
+            ratios[model_name] = max(
+                ratios.get(model_name, 0.0), busy_ratio)
+            overran[model_name] = (
+                overran.get(model_name, False) or n_overruns > 0)
+
+    for model_name, ratio in ratios.items():
+        factor = ratio * headroom
+        old_factor = cpu_cost_model.get_cpu_calibration(model_name)
+        if overran[model_name]:
+            factor = max(factor, old_factor)
+        else:
+            factor = min((factor + old_factor) / 2.0, old_factor)
+        cpu_cost_model.set_cpu_calibration(model_name, factor)
+        calibration[model_name] = {
+            "cpu_factor": factor, "busy_ratio": ratio,
+            "overran": overran[model_name]}
+
+    with open(filename, "w") as f:
+        json.dump(calibration, f, indent=4, sort_keys=True)
+    return summaries
@@ -0,0 +1,290 @@
+""" Sweeps of plasticity and neuron parameters which load the network once.
+
+    The first point of a sweep is run as usual.  For each later point only\
+    the plasticity region (the timing rule's parameters, which\
+    timing_initialise reads from its start) and the per-neuron parameters\
+    at the end of the neuron parameter region are rewritten in place, and\
+    the cores are restarted; the data specifications are not regenerated,\
+    and the synaptic matrices stay in SDRAM.  Builds with\
+    SYNAPSE_MATRIX_RESET (the Vogels 2011 and recurrent STDP builds) copy\
+    the matrix as first loaded back over the trained one when they restart,\
+    so that every point starts from the same weights.
+
+    A new point may only change parameters which don't change the size of\
+    the regions, i.e. not the number of recorded synapses of a rule.
+"""
+import logging
+import os
+import struct
+import time
+
+from spinnman.data.file_data_reader import FileDataReader
+from spinnman.messages.scp.scp_signal import SCPSignal
+from spinnman.model.core_subsets import CoreSubsets
+from spinnman.model.cpu_state import CPUState
+
+from spynnaker.pyNN.utilities import constants
+
+from spynnaker_extra_pynn_models.neuron import extra_regions
+
+from data_specification.enums.data_type import DataType
+
+logger = logging.getLogger(__name__)
+
+# How the data types written by the rules and neuron parameters are stored,
+# and the scale of the fixed point types
+_DATA_TYPE_ENCODINGS = {
+    DataType.UINT8: ("<B", 1), DataType.INT8: ("<b", 1),
+    DataType.UINT16: ("<H", 1), DataType.INT16: ("<h", 1),
+    DataType.UINT32: ("<I", 1), DataType.INT32: ("<i", 1),
+    DataType.S1615: ("<i", 1 << 15)}
+
+# Seconds between checks for the cores having finished
+_FINISHED_POLL_SECONDS = 0.1
+
+
+class _MemorySpec(object):
+    """ Collects what a rule writes into a data specification, so that it\
+        can be written straight into SDRAM
+    """
+
+    def __init__(self):
+        self._data = bytearray()
+
+    def write_value(self, data, data_type=DataType.UINT32):
+        encoding, scale = _DATA_TYPE_ENCODINGS[data_type]
+        if scale != 1:
+            data = int(round(float(data) * scale))
+        self._data += struct.pack(encoding, int(data))
+
+    def write_array(self, array_values):
+        for value in array_values:
+            self._data += struct.pack("<I", int(value) & 0xFFFFFFFF)
+
+    @property
+    def data(self):
+        return self._data
+
+
+class SweepPoint(object):
+    """ The result of running one point of a sweep
+    """
+
+    def __init__(self, parameters, result, reload_seconds,
+                 reload_seconds_saved):
+        self._parameters = parameters
+        self._result = result
+        self._reload_seconds = reload_seconds
+        self._reload_seconds_saved = reload_seconds_saved
+
+    @property
+    def parameters(self):
+        return self._parameters
+
+    @property
+    def result(self):
+        """ What the collect function returned after the run
+        """
+        return self._result
+
+    @property
+    def reload_seconds(self):
+        """ The time spent loading the point, up to starting the cores; for\
+            the first point, the time of the whole first run
+        """
+        return self._reload_seconds
+
+    @property
+    def reload_seconds_saved(self):
+        """ The loading time saved compared to the first point, which was\
+            loaded in full; the first run less the time this point ran for,\
+            less the time this point took to load
+        """
+        return self._reload_seconds_saved
+
+
+class ParameterSweep(object):
+    """ Runs a network at each of a series of parameter points, reloading\
+        only the parameters which change between points
+
+    Each point is a dict mapping a timing rule, added with add_rule, or a\
+    population, added with add_population, to a dict of its parameters and\
+    their values at that point; e.g.::
+
+        sweep = ParameterSweep(run_time=1000.0)
+        sweep.add_rule(post_population, vogels_rule)
+        sweep.add_population(post_population)
+        points = sweep.run(
+            [{vogels_rule: {"alpha": a, "tau": tau}} for a in alphas],
+            collect=lambda: post_population.getSpikes())
+    """
+
+    def __init__(self, run_time):
+        """
+
+        :param run_time: the time to run each point for, in ms
+        """
+        self._run_time = run_time
+
+        # Rules and the populations whose plastic synapses use them
+        self._rules = list()
+        self._populations = list()
+
+    def add_rule(self, post_population, rule):
+        """ Add a timing rule whose parameters are swept
+
+        :param post_population: the population which the plastic\
+            projections using the rule connect to
+        :param rule: the timing dependence of the projections, e.g. a\
+            Vogels2011Rule or RecurrentRule
+        """
+        self._rules.append((post_population, rule))
+
+    def add_population(self, population):
+        """ Add a population whose neuron parameters are swept
+        """
+        self._populations.append(population)
+
+    def run(self, points, collect=None):
+        """ Run each point of the sweep in turn
+
+        :param points: a list of dicts of the parameters of each point
+        :param collect: a function called after each run, whose return value\
+            is kept as the result of the point
+        :return: a SweepPoint for each point
+        """
+        results = list()
+        first_run_seconds = None
+        for point in points:
+            self._set_parameters(point)
+            if first_run_seconds is None:
+                start = time.time()
+                self._spinnaker.run(self._run_time)
+                first_run_seconds = time.time() - start
+                reload_seconds = first_run_seconds
+                saved = 0.0
+            else:
+
+                # Everything in the first run other than running is loading
+                reload_seconds, run_seconds = self._rerun()
+                saved = (first_run_seconds - run_seconds) - reload_seconds
+                logger.info(
+                    "Sweep point {} loaded in {:.3f}s, saving {:.3f}s".format(
+                        len(results), reload_seconds, saved))
+
+            result = collect() if collect is not None else None
+            results.append(SweepPoint(point, result, reload_seconds, saved))
+        return results
+
+    @property
+    def _spinnaker(self):
+        populations = self._populations + [p for p, _ in self._rules]
+        if len(populations) == 0:
+            raise ValueError("No rules or populations have been added")
+        return populations[0]._spinnaker
+
+    def _set_parameters(self, point):
+        for item, parameters in point.iteritems():
+            for name, value in parameters.iteritems():
+                if item in self._populations:
+                    item.set(name, value)
+                else:
+                    setattr(item, name, value)
+
+    def _rerun(self):
+        """ Rewrite the parameters of each core, restart the cores and wait\
+            for them to finish
+
+        :return: the time taken up to starting the cores, and the time from\
+            then until they finished
+        """
+        spinnaker = self._spinnaker
+        start = time.time()
+        for post_population, rule in self._rules:
+            self._write_plasticity_parameters(spinnaker, post_population, rule)
+        for population in self._populations:
+            self._write_neuron_parameters(spinnaker, population)
+        n_cores = self._restart_cores(spinnaker)
+        run_start = time.time()
+
+        transceiver = spinnaker.transceiver
+        time.sleep(self._run_time / 1000.0)
+        while (transceiver.get_core_state_count(
+                spinnaker._app_id, CPUState.FINISHED) < n_cores):
+            time.sleep(_FINISHED_POLL_SECONDS)
+        return run_start - start, time.time() - run_start
+
+    @staticmethod
+    def _placements_of(spinnaker, population):
+        graph_mapper = spinnaker.graph_mapper
+        for subvertex in graph_mapper.get_subvertices_from_vertex(
+                population._vertex):
+            yield (spinnaker.placements.get_placement_of_subvertex(subvertex),
+                   graph_mapper.get_subvertex_slice(subvertex))
+
+    def _write_plasticity_parameters(self, spinnaker, post_population, rule):
+        # The swept rules don't use the weight scales
+        spec = _MemorySpec()
+        rule.write_plastic_params(
+            spec, spinnaker.machine_time_step, None, None)
+        for placement, _ in self._placements_of(spinnaker, post_population):
+            address = extra_regions.get_region_address(
+                spinnaker.transceiver, placement,
+                constants.POPULATION_BASED_REGIONS.SYNAPSE_DYNAMICS)
+            spinnaker.transceiver.write_memory(
+                placement.x, placement.y, address, spec.data)
+
+    def _write_neuron_parameters(self, spinnaker, population):
+        vertex = population._vertex
+        parameters = vertex.get_parameters()
+        for placement, vertex_slice in self._placements_of(
+                spinnaker, population):
+            spec = _MemorySpec()
+            for atom in range(vertex_slice.lo_atom, vertex_slice.hi_atom + 1):
+                for parameter in parameters:
+                    value = parameter.get_value()
+                    if hasattr(value, "__len__"):
+                        value = value[atom] if len(value) > 1 else value[0]
+                    spec.write_value(
+                        data=value,
+                        data_type=parameter.get_dataspec_datatype())
+
+            # The parameters of each neuron end the region
+            regions = extra_regions.get_region_addresses(
+                spinnaker.transceiver, placement)
+            begin = regions[
+                constants.POPULATION_BASED_REGIONS.NEURON_PARAMS.value]
+            end = min(address for address in regions if address > begin)
+            spinnaker.transceiver.write_memory(
+                placement.x, placement.y, end - len(spec.data), spec.data)
+
+    @staticmethod
+    def _restart_cores(spinnaker):
+        """ Restart every core of the application with its binary, leaving\
+            SDRAM as it is, and start them together
+
+        :return: the number of cores
+        """
+        transceiver = spinnaker.transceiver
+        graph_mapper = spinnaker.graph_mapper
+        binaries = dict()
+        for placement in spinnaker.placements.placements:
+            vertex = graph_mapper.get_vertex_from_subvertex(
+                placement.subvertex)
+            binaries.setdefault(vertex.get_binary_file_name(), list()).append(
+                placement)
+
+        n_cores = 0
+        for binary, placements in binaries.iteritems():
+            path = spinnaker._executable_finder.get_executable_path(binary)
+            core_subsets = CoreSubsets()
+            for placement in placements:
+                core_subsets.add_processor(
+                    placement.x, placement.y, placement.p)
+            transceiver.execute_flood(
+                core_subsets=core_subsets, executable=FileDataReader(path),
+                app_id=spinnaker._app_id, n_bytes=os.stat(path).st_size)
+            n_cores += len(placements)
+
+        transceiver.send_signal(spinnaker._app_id, SCPSignal.SYNC0)
+        return n_cores
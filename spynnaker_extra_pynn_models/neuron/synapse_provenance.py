@@ -0,0 +1,272 @@
+from collections import namedtuple
+
+from data_specification.enums.data_type import DataType
+
+from spynnaker_extra_pynn_models.neuron import extra_regions
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+import numpy
+
+# The phases timed on the core, in the order of synapse_provenance_phase_e
+# in neural_modelling/src/neuron/synapse_provenance.h
+SYNAPSE_PROVENANCE_PHASES = [
+    "ring_buffer_drain", "plastic_rows", "fixed_rows", "post_events",
+    "writeback", "consolidation"]
+
+# Bucket b counts timesteps in which a phase used [2^(b - 1), 2^b) cycles,
+# or which left that many cycles of the tick, and the last bucket counts
+# everything larger
+SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS = 20
+
+# Total cycles (low and high words) and maximum, followed by the histogram
+_PHASE_WORDS = 3 + SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS
+
+# CPU cycles per microsecond, at which the core counts
+CYCLES_PER_US = 200
+
+# Whether the row costs follow and the cycles of a timer tick, written by the
+# host, then the number of timesteps, the number of overruns and the largest,
+# the most cycles a timestep was busy and the histogram of the slack of the
+# others, then each phase
+_HOST_WORDS = 2
+_HEADER_WORDS = _HOST_WORDS + 4 + SYNAPSE_PROVENANCE_HISTOGRAM_BUCKETS
+SYNAPSE_PROVENANCE_SIZE_BYTES = 4 * (
+    _HEADER_WORDS + (len(SYNAPSE_PROVENANCE_PHASES) * _PHASE_WORDS))
+
+# Row length and cycle buckets of the row cost histogram, each counting
+# values by their number of significant bits, and the number of most
+# expensive source keys tracked
+SYNAPSE_ROW_COSTS_LENGTH_BUCKETS = 10
+SYNAPSE_ROW_COSTS_CYCLE_BUCKETS = 16
+SYNAPSE_ROW_COSTS_HOT_ROWS = 16
+
+# Key, number of rows, total cycles, maximum cycles and error in the total
+_HOT_ROW_WORDS = 5
+
+# Histogram followed by the number of hot rows and the hot rows, after the
+# provenance in the same region
+SYNAPSE_ROW_COSTS_SIZE_BYTES = 4 * (
+    (SYNAPSE_ROW_COSTS_LENGTH_BUCKETS * SYNAPSE_ROW_COSTS_CYCLE_BUCKETS) + 1 +
+    (SYNAPSE_ROW_COSTS_HOT_ROWS * _HOT_ROW_WORDS))
+
+SynapseProvenance = namedtuple(
+    "SynapseProvenance",
+    ["vertex_slice", "n_timesteps", "n_overruns", "max_overrun_cycles",
+     "max_busy_cycles", "slack_histogram", "phases"])
+PhaseProvenance = namedtuple(
+    "PhaseProvenance",
+    ["total_cycles", "max_timestep_cycles", "timestep_histogram"])
+SynapseRowCosts = namedtuple(
+    "SynapseRowCosts", ["vertex_slice", "histogram", "hot_rows"])
+HotRow = namedtuple(
+    "HotRow", ["key", "n_rows", "total_cycles", "max_cycles", "error_cycles"])
+
+
+def _read_region_words(transceiver, placement, region, size, offset=0):
+    address = extra_regions.get_region_address(
+        transceiver, placement, region)
+    if address == 0:
+        return None
+    data = transceiver.read_memory(
+        placement.x, placement.y, address + offset, size)
+    return numpy.asarray(data, dtype="uint8").view("<u4")
+
+
+def read_synapse_provenance(transceiver, placement, vertex_slice):
+    """ Read the synapse provenance region of a placed subvertex
+
+    :return: the provenance, or None if the region was not reserved
+    :rtype: SynapseProvenance
+    """
+    words = _read_region_words(
+        transceiver, placement, EXTRA_REGIONS.SYNAPSE_PROVENANCE,
+        SYNAPSE_PROVENANCE_SIZE_BYTES)
+    if words is None:
+        return None
+
+    phases = dict()
+    for i, phase_name in enumerate(SYNAPSE_PROVENANCE_PHASES):
+        start = _HEADER_WORDS + (i * _PHASE_WORDS)
+        phase_words = words[start:start + _PHASE_WORDS]
+        phases[phase_name] = PhaseProvenance(
+            total_cycles=int(phase_words[0]) + (int(phase_words[1]) << 32),
+            max_timestep_cycles=int(phase_words[2]),
+            timestep_histogram=numpy.array(phase_words[3:], dtype="uint32"))
+    return SynapseProvenance(
+        vertex_slice=vertex_slice, n_timesteps=int(words[_HOST_WORDS]),
+        n_overruns=int(words[_HOST_WORDS + 1]),
+        max_overrun_cycles=int(words[_HOST_WORDS + 2]),
+        max_busy_cycles=int(words[_HOST_WORDS + 3]),
+        slack_histogram=numpy.array(
+            words[_HOST_WORDS + 4:_HEADER_WORDS], dtype="uint32"),
+        phases=phases)
+
+
+def read_synapse_row_costs(transceiver, placement, vertex_slice):
+    """ Read the row costs of a placed subvertex, which follow its synapse\
+        provenance
+
+    :return: the row costs, or None if they were not recorded
+    :rtype: SynapseRowCosts
+    """
+    words = _read_region_words(
+        transceiver, placement, EXTRA_REGIONS.SYNAPSE_PROVENANCE, 4)
+    if words is None or not words[0]:
+        return None
+    words = _read_region_words(
+        transceiver, placement, EXTRA_REGIONS.SYNAPSE_PROVENANCE,
+        SYNAPSE_ROW_COSTS_SIZE_BYTES, SYNAPSE_PROVENANCE_SIZE_BYTES)
+
+    histogram_words = (
+        SYNAPSE_ROW_COSTS_LENGTH_BUCKETS * SYNAPSE_ROW_COSTS_CYCLE_BUCKETS)
+    histogram = numpy.array(words[:histogram_words], dtype="uint32").reshape(
+        (SYNAPSE_ROW_COSTS_LENGTH_BUCKETS, SYNAPSE_ROW_COSTS_CYCLE_BUCKETS))
+    n_hot_rows = int(words[histogram_words])
+    hot_row_words = words[histogram_words + 1:].reshape(
+        (SYNAPSE_ROW_COSTS_HOT_ROWS, _HOT_ROW_WORDS))
+    hot_rows = [HotRow(*[int(word) for word in hot_row_words[i]])
+                for i in range(n_hot_rows)]
+    hot_rows.sort(key=lambda hot_row: hot_row.total_cycles, reverse=True)
+    return SynapseRowCosts(
+        vertex_slice=vertex_slice, histogram=histogram, hot_rows=hot_rows)
+
+
+def get_synapse_provenance(population):
+    """ Read the synapse provenance of each core of a population after a run
+
+    :param population: a population of a model which records provenance
+    :return: a SynapseProvenance for each core
+    """
+    spinnaker = population._spinnaker
+    return population._vertex.get_synapse_provenance(
+        spinnaker.transceiver, spinnaker.placements, spinnaker.graph_mapper)
+
+
+def get_synapse_row_costs(population):
+    """ Read the row costs of each core of a population after a run
+
+    :param population: a population created with record_row_costs=True
+    :return: a SynapseRowCosts for each core
+    """
+    spinnaker = population._spinnaker
+    return population._vertex.get_synapse_row_costs(
+        spinnaker.transceiver, spinnaker.placements, spinnaker.graph_mapper)
+
+
+def write_synapse_row_cost_report(population, report_file):
+    """ Write the most expensive source keys and the row length against\
+        cycles histogram of each core of a population to a file after a run
+
+    :param population: a population created with record_row_costs=True
+    :param report_file: the name of the file to write
+    """
+    with open(report_file, "w") as f:
+        for row_costs in get_synapse_row_costs(population):
+            f.write("Neurons {}:{}\n".format(
+                row_costs.vertex_slice.lo_atom,
+                row_costs.vertex_slice.hi_atom))
+
+            f.write("{:>10} {:>8} {:>12} {:>10} {:>10} {:>12}\n".format(
+                "key", "rows", "cycles", "mean", "max", "error"))
+            for hot_row in row_costs.hot_rows:
+                f.write("0x{:08x} {:>8} {:>12} {:>10} {:>10} {:>12}\n".format(
+                    hot_row.key, hot_row.n_rows, hot_row.total_cycles,
+                    hot_row.total_cycles // max(hot_row.n_rows, 1),
+                    hot_row.max_cycles, hot_row.error_cycles))
+
+            # Bucket b of each axis holds values in [2^(b - 1), 2^b)
+            f.write("Row length bucket against cycle bucket:\n")
+            for length_bucket, counts in enumerate(row_costs.histogram):
+                if numpy.any(counts):
+                    f.write("{:>2}: {}\n".format(
+                        length_bucket, " ".join(str(c) for c in counts)))
+            f.write("\n")
+
+
+class SynapseProvenanceVertex(object):
+    """ Population vertex mixin, which reserves the region in which the core\
+        records the cycles used by each synapse and plasticity phase in\
+        each timestep, so that timer overruns can be attributed to a phase,\
+        and counts the timer overruns and the slack of the other timesteps.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+
+        With record_row_costs, the cost of each synaptic row is also\
+        recorded, as a histogram of row length against cycles and the\
+        source keys with the most expensive rows.
+    """
+
+    def __init__(self, record_row_costs, machine_time_step, timescale_factor):
+        self._record_row_costs = record_row_costs
+        self._provenance_timer_period_cycles = int(
+            machine_time_step * timescale_factor * CYCLES_PER_US)
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return (super(SynapseProvenanceVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                SYNAPSE_PROVENANCE_SIZE_BYTES + self._row_costs_size_bytes)
+
+    @property
+    def _row_costs_size_bytes(self):
+        if self._record_row_costs:
+            return SYNAPSE_ROW_COSTS_SIZE_BYTES
+        return 0
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(SynapseProvenanceVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+
+        # Cleared by the core when it starts, apart from the host's words
+        spec.reserve_memory_region(
+            region=EXTRA_REGIONS.SYNAPSE_PROVENANCE.value,
+            size=SYNAPSE_PROVENANCE_SIZE_BYTES + self._row_costs_size_bytes,
+            label="synapseProvenance")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(SynapseProvenanceVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        spec.switch_write_focus(
+            region=EXTRA_REGIONS.SYNAPSE_PROVENANCE.value)
+        spec.write_value(
+            data=1 if self._record_row_costs else 0,
+            data_type=DataType.UINT32)
+
+        # Timesteps in turbo mode don't keep to the timer
+        timer_period_cycles = self._provenance_timer_period_cycles
+        if getattr(self, "turbo_watchdog_ticks", None) is not None:
+            timer_period_cycles = 0
+        spec.write_value(data=timer_period_cycles, data_type=DataType.UINT32)
+
+    @property
+    def provenance_timer_period_cycles(self):
+        return self._provenance_timer_period_cycles
+
+    def get_synapse_provenance(self, transceiver, placements, graph_mapper):
+        """ Read the synapse provenance of each core of this vertex
+
+        :return: a SynapseProvenance for each core
+        """
+        provenance = list()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(self):
+            placement = placements.get_placement_of_subvertex(subvertex)
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+            subvertex_provenance = read_synapse_provenance(
+                transceiver, placement, vertex_slice)
+            if subvertex_provenance is not None:
+                provenance.append(subvertex_provenance)
+        return provenance
+
+    def get_synapse_row_costs(self, transceiver, placements, graph_mapper):
+        """ Read the row costs of each core of this vertex
+
+        :return: a SynapseRowCosts for each core
+        """
+        row_costs = list()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(self):
+            placement = placements.get_placement_of_subvertex(subvertex)
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+            subvertex_row_costs = read_synapse_row_costs(
+                transceiver, placement, vertex_slice)
+            if subvertex_row_costs is not None:
+                row_costs.append(subvertex_row_costs)
+        return row_costs
@@ -0,0 +1,108 @@
+from spynnaker.pyNN.exceptions import ConfigurationException
+
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+from data_specification.enums.data_type import DataType
+
+import numpy
+
+
+def get_target_schedule(
+        target_spike_times, vertex_slice, machine_time_step,
+        synapse_index_bits):
+    """ Encode the target spikes of a slice of neurons as the core reads\
+        them: (timestep << synapse_index_bits) | neuron index, sorted
+
+    :param target_spike_times: a list of times in ms for every neuron, or a\
+        list of such lists, one per neuron
+    :param vertex_slice: the neurons of the core
+    :param machine_time_step: the machine time step in us
+    :param synapse_index_bits: SYNAPSE_INDEX_BITS of the binary
+    :return: a numpy array of uint32
+    """
+    per_neuron = (len(target_spike_times) > 0 and
+                  hasattr(target_spike_times[0], "__iter__"))
+    timesteps = list()
+    indices = list()
+    for neuron_index in range(vertex_slice.lo_atom, vertex_slice.hi_atom + 1):
+        times = (target_spike_times[neuron_index] if per_neuron
+                 else target_spike_times)
+        neuron_timesteps = numpy.round(
+            numpy.asarray(times, dtype="float64") *
+            (1000.0 / float(machine_time_step))).astype("uint64")
+        timesteps.append(neuron_timesteps)
+        indices.append(numpy.repeat(
+            neuron_index - vertex_slice.lo_atom, len(neuron_timesteps)))
+
+    timesteps = numpy.concatenate(timesteps)
+    indices = numpy.concatenate(indices).astype("uint64")
+    if len(timesteps) > 0 and \
+            timesteps.max() >= (1 << (32 - synapse_index_bits)):
+        raise ConfigurationException(
+            "Target spike times must be less than {} timesteps".format(
+                1 << (32 - synapse_index_bits)))
+
+    order = numpy.lexsort((indices, timesteps))
+    return ((timesteps[order] << synapse_index_bits) |
+            indices[order]).astype("uint32")
+
+
+class TargetScheduleVertex(object):
+    """ Population vertex mixin which writes target spikes into a region\
+        that the target STDP builds apply directly, instead of receiving\
+        them from a teacher population through "target" synapses.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self, target_spike_times, machine_time_step,
+                 synapse_index_bits):
+        self._target_spike_times = target_spike_times
+        self._target_schedule_machine_time_step = machine_time_step
+        self._target_schedule_synapse_index_bits = synapse_index_bits
+        self._target_schedules = dict()
+
+    def _get_target_schedule(self, vertex_slice):
+        key = (vertex_slice.lo_atom, vertex_slice.hi_atom)
+        if key not in self._target_schedules:
+            self._target_schedules[key] = get_target_schedule(
+                self._target_spike_times, vertex_slice,
+                self._target_schedule_machine_time_step,
+                self._target_schedule_synapse_index_bits)
+        return self._target_schedules[key]
+
+    def _get_target_schedule_size_bytes(self, vertex_slice):
+        if self._target_spike_times is None:
+            return 0
+
+        # The number of events followed by the events
+        return 4 * (1 + len(self._get_target_schedule(vertex_slice)))
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return (super(TargetScheduleVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                self._get_target_schedule_size_bytes(vertex_slice))
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(TargetScheduleVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+        if self._target_spike_times is not None:
+            spec.reserve_memory_region(
+                region=EXTRA_REGIONS.TARGET_SCHEDULE.value,
+                size=self._get_target_schedule_size_bytes(vertex_slice),
+                label="targetSchedule")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(TargetScheduleVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        if self._target_spike_times is not None:
+            target_schedule = self._get_target_schedule(vertex_slice)
+            spec.switch_write_focus(region=EXTRA_REGIONS.TARGET_SCHEDULE.value)
+            spec.write_value(
+                data=len(target_schedule), data_type=DataType.UINT32)
+            if len(target_schedule) > 0:
+                spec.write_array(target_schedule)
+
+    @property
+    def target_spike_times(self):
+        return self._target_spike_times
@@ -0,0 +1,213 @@
+""" Turbo mode, in which the cores of populations start each timestep as\
+    soon as the cores they exchange spikes with have finished the last one,\
+    rather than on the timer tick.
+
+    Offline runs, such as training or parameter sweeps, don't need to keep\
+    to real time, and a lightly loaded network spends most of each tick\
+    waiting for the next.  enable_turbo marks a set of populations, which\
+    must only receive spikes from each other, to run in turbo mode; see\
+    neural_modelling/src/neuron/turbo.h for how the cores keep in step.\
+    Each core must hear when each of its neighbours has finished, so a\
+    TurboSyncEdge is added back from each population to those which send it\
+    spikes; spikes sent along it find no rows, and cost a population table\
+    search on the core.
+
+    Results are the same as in real time, provided no done packet is\
+    dropped; a core whose neighbours are silent for the watchdog ticks\
+    starts its next timestep anyway, and counts it.
+"""
+from collections import namedtuple
+import struct
+
+from data_specification.enums.data_type import DataType
+
+from pacman.model.partitionable_graph.multi_cast_partitionable_edge \
+    import MultiCastPartitionableEdge
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+
+from spynnaker_extra_pynn_models.neuron import extra_regions
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+# The words written by the host, followed by those written by the core; must
+# match turbo_t in neural_modelling/src/neuron/turbo.h
+_HOST_WORDS = 4
+TURBO_SIZE_BYTES = 4 * (_HOST_WORDS + 4)
+
+# DTCM of the spikes of the next timestep held on the core
+_EARLY_SPIKE_DTCM_BYTES = 4 * 256
+
+TurboProvenance = namedtuple(
+    "TurboProvenance",
+    ["vertex_slice", "n_timesteps", "n_watchdog_timesteps",
+     "n_dropped_spikes", "max_early_spikes"])
+
+
+class TurboSyncEdge(MultiCastPartitionableEdge):
+    """ An edge added by enable_turbo back to a population from one it sends\
+        spikes to, which carries no synapses, only done packets
+    """
+
+    def __init__(self, pre_vertex, post_vertex):
+        MultiCastPartitionableEdge.__init__(
+            self, pre_vertex, post_vertex,
+            label="turbo sync {} to {}".format(
+                pre_vertex.label, post_vertex.label))
+
+
+def enable_turbo(populations, watchdog_ticks=10):
+    """ Run populations in turbo mode; call after making their projections\
+        and before running
+
+    :param populations: the populations, which must only receive spikes\
+        from each other, with no delay extensions
+    :param watchdog_ticks: the timer ticks a core waits for its neighbours\
+        before it starts its next timestep anyway, or 0 to wait for as long\
+        as it takes
+    """
+    vertices = [population._vertex for population in populations]
+    for vertex in vertices:
+        if not isinstance(vertex, TurboVertex):
+            raise ConfigurationException(
+                "{} has no turbo mode".format(vertex.label))
+    spinnaker = populations[0]._spinnaker
+    graph = spinnaker.partitionable_graph
+    for vertex in vertices:
+        for edge in graph.incoming_edges_to_vertex(vertex):
+            if edge.pre_vertex not in vertices:
+                raise ConfigurationException(
+                    "{} receives spikes from {}, which is not in turbo"
+                    " mode".format(vertex.label, edge.pre_vertex.label))
+
+    # Each vertex must also hear from those it sends spikes to
+    for vertex in vertices:
+        pre_vertices = set(
+            edge.pre_vertex
+            for edge in graph.incoming_edges_to_vertex(vertex))
+        for edge in list(graph.outgoing_edges_from_vertex(vertex)):
+            if edge.post_vertex not in pre_vertices:
+                spinnaker.add_edge(TurboSyncEdge(edge.post_vertex, vertex))
+                pre_vertices.add(edge.post_vertex)
+    for vertex in vertices:
+        vertex._turbo_watchdog_ticks = watchdog_ticks
+
+
+def read_turbo_provenance(transceiver, placement, vertex_slice):
+    """ Read the turbo region of a placed subvertex
+
+    :return: the provenance, or None if the region was not reserved
+    :rtype: TurboProvenance
+    """
+    address = extra_regions.get_region_address(
+        transceiver, placement, EXTRA_REGIONS.TURBO)
+    if address == 0:
+        return None
+    data = transceiver.read_memory(
+        placement.x, placement.y, address + (4 * _HOST_WORDS),
+        TURBO_SIZE_BYTES - (4 * _HOST_WORDS))
+    return TurboProvenance(
+        vertex_slice, *struct.unpack_from("<4I", str(data)))
+
+
+def get_turbo_provenance(population):
+    """ Read how each core of a population in turbo mode kept in step after\
+        a run
+
+    :return: a TurboProvenance for each core
+    """
+    spinnaker = population._spinnaker
+    return population._vertex.get_turbo_provenance(
+        spinnaker.transceiver, spinnaker.placements, spinnaker.graph_mapper)
+
+
+class TurboVertex(object):
+    """ Population vertex mixin which reserves the turbo region when the\
+        vertex is put in turbo mode by enable_turbo.\
+        Must come before AbstractPopulationVertex in the bases of the vertex.
+    """
+
+    def __init__(self):
+        self._turbo_watchdog_ticks = None
+
+        # The number of cores which send packets to the subvertex whose data
+        # specification is being generated
+        self._turbo_n_neighbours = 0
+
+    @property
+    def _turbo_enabled(self):
+        return self._turbo_watchdog_ticks is not None
+
+    def _get_turbo_size_bytes(self):
+        if self._turbo_enabled:
+            return TURBO_SIZE_BYTES
+        return 0
+
+    def _get_turbo_dtcm_bytes(self):
+        if self._turbo_enabled:
+            return _EARLY_SPIKE_DTCM_BYTES
+        return 0
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return (super(TurboVertex, self)
+                .get_sdram_usage_for_atoms(vertex_slice, graph) +
+                self._get_turbo_size_bytes())
+
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
+        return (super(TurboVertex, self)
+                .get_dtcm_usage_for_atoms(vertex_slice, graph) +
+                self._get_turbo_dtcm_bytes())
+
+    def generate_data_spec(self, subvertex, placement, subgraph, *args,
+                           **kwargs):
+        self._turbo_n_neighbours = len(set(
+            subedge.pre_subvertex
+            for subedge in subgraph.incoming_subedges_from_subvertex(
+                subvertex)))
+        return super(TurboVertex, self).generate_data_spec(
+            subvertex, placement, subgraph, *args, **kwargs)
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        super(TurboVertex, self)._reserve_memory_regions(
+            spec, vertex_slice, *args, **kwargs)
+        if self._turbo_enabled:
+            spec.reserve_memory_region(
+                region=EXTRA_REGIONS.TURBO.value,
+                size=TURBO_SIZE_BYTES, label="turbo")
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        super(TurboVertex, self)._write_neuron_parameters(
+            spec, key, vertex_slice, *args, **kwargs)
+        if not self._turbo_enabled:
+            return
+
+        # A core with no outgoing subedges has no key, and so no neighbours
+        # waiting for it
+        spec.switch_write_focus(region=EXTRA_REGIONS.TURBO.value)
+        spec.write_value(data=0 if key is None else 1,
+                         data_type=DataType.UINT32)
+        spec.write_value(data=0 if key is None else key,
+                         data_type=DataType.UINT32)
+        spec.write_value(data=self._turbo_n_neighbours,
+                         data_type=DataType.UINT32)
+        spec.write_value(data=self._turbo_watchdog_ticks,
+                         data_type=DataType.UINT32)
+
+    def get_turbo_provenance(self, transceiver, placements, graph_mapper):
+        """ Read the turbo provenance of each core of this vertex
+
+        :return: a TurboProvenance for each core
+        """
+        provenance = list()
+        for subvertex in graph_mapper.get_subvertices_from_vertex(self):
+            placement = placements.get_placement_of_subvertex(subvertex)
+            vertex_slice = graph_mapper.get_subvertex_slice(subvertex)
+            subvertex_provenance = read_turbo_provenance(
+                transceiver, placement, vertex_slice)
+            if subvertex_provenance is not None:
+                provenance.append(subvertex_provenance)
+        return provenance
+
+    @property
+    def turbo_watchdog_ticks(self):
+        return self._turbo_watchdog_ticks
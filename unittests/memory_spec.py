@@ -0,0 +1,121 @@
+""" A data specification which writes into memory, and a transceiver\
+    reading from an SDRAM image laid out as the data specification executor\
+    lays it out, for testing what the models write against what the cores\
+    read
+"""
+import struct
+
+import numpy
+
+from data_specification.enums.data_type import DataType
+
+# Struct encodings of the data types the models write
+_ENCODINGS = {
+    DataType.UINT8: "<B", DataType.INT8: "<b",
+    DataType.UINT16: "<H", DataType.INT16: "<h",
+    DataType.UINT32: "<I", DataType.INT32: "<i",
+    DataType.UINT64: "<Q", DataType.INT64: "<q"}
+
+# Magic number and version, followed by the region table
+_HEADER_BYTES = 8
+_MAX_REGIONS = 16
+
+# Where the image of the core is placed in the simulated SDRAM
+SDRAM_BASE_ADDRESS = 0x60000000
+
+
+def _to_bytes(words):
+    return bytearray(numpy.ascontiguousarray(
+        numpy.asarray(words).astype("<u4")).data)
+
+
+class MemorySpec(object):
+    """ Collects what is written to each region of a data specification
+    """
+
+    def __init__(self):
+        self._sizes = dict()
+        self._regions = dict()
+        self._region = None
+
+    def reserve_memory_region(self, region, size, label=None, empty=False):
+        self._sizes[region] = size
+        self._regions[region] = bytearray()
+
+    def switch_write_focus(self, region):
+        self._region = region
+
+    def write_value(self, data, data_type=DataType.UINT32):
+        self._regions[self._region] += struct.pack(
+            _ENCODINGS[data_type], int(data))
+
+    def write_array(self, array_values):
+        self._regions[self._region] += _to_bytes(array_values)
+
+    def get_region_data(self, region):
+        return self._regions[region]
+
+    def get_region_size(self, region):
+        return self._sizes[region]
+
+
+class _CpuInfo(object):
+    def __init__(self, data_address):
+        self.user = [data_address, 0, 0, 0]
+
+
+class SimulatedTransceiver(object):
+    """ The SDRAM of one core into which a MemorySpec has been executed:\
+        the header, the region table, then each reserved region in turn
+    """
+
+    def __init__(self, spec):
+        table = [0] * _MAX_REGIONS
+        address = SDRAM_BASE_ADDRESS + _HEADER_BYTES + (4 * _MAX_REGIONS)
+        regions = bytearray()
+        for region in sorted(spec._sizes):
+            table[region] = address
+            data = spec.get_region_data(region)
+            size = spec.get_region_size(region)
+            if len(data) > size:
+                raise Exception(
+                    "Region {} overflowed: {} of {} bytes written".format(
+                        region, len(data), size))
+            regions += data + bytearray(size - len(data))
+            address += size
+        self._sdram = bytearray(_HEADER_BYTES) + bytearray(struct.pack(
+            "<{}I".format(_MAX_REGIONS), *table)) + regions
+        self._region_table = table
+
+    def get_region_address(self, region):
+        return self._region_table[region]
+
+    def get_cpu_information_from_core(self, x, y, p):
+        return _CpuInfo(SDRAM_BASE_ADDRESS)
+
+    def read_memory(self, x, y, base_address, length):
+        offset = base_address - SDRAM_BASE_ADDRESS
+        if offset < 0 or offset + length > len(self._sdram):
+            raise Exception("Read outside the image")
+        return bytearray(self._sdram[offset:offset + length])
+
+    def write_memory(self, x, y, base_address, data):
+        offset = base_address - SDRAM_BASE_ADDRESS
+        if isinstance(data, (int, long)):
+            data = struct.pack("<I", data)
+        data = bytearray(data)
+        if offset < 0 or offset + len(data) > len(self._sdram):
+            raise Exception("Write outside the image")
+        self._sdram[offset:offset + len(data)] = data
+
+    def get_words(self, base_address, n_words):
+        """ Read words of the image as the core would
+        """
+        return numpy.asarray(
+            self.read_memory(0, 0, base_address, 4 * n_words),
+            dtype="uint8").view("<u4")
+
+    def set_words(self, base_address, words):
+        """ Write words into the image as the core would
+        """
+        self.write_memory(0, 0, base_address, _to_bytes(words))
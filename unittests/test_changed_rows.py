@@ -0,0 +1,209 @@
+""" Tests that the changed rows region written by ChangedRowsVertex, marked\
+    as _changed_rows_end in synapses.c marks it, brings the host's copy of\
+    the synaptic matrix up to date by reading only the changed chunks
+"""
+from collections import namedtuple
+import unittest
+
+import numpy
+
+from spynnaker.pyNN.utilities import constants
+
+from spynnaker_extra_pynn_models.neuron import changed_rows
+from spynnaker_extra_pynn_models.neuron.changed_rows \
+    import ChangedRowsVertex, SynapticMatrixCache, get_changed_ranges
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+from unittests.memory_spec import MemorySpec, SimulatedTransceiver
+
+_SYNAPTIC_MATRIX = constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value
+_CHUNK_BYTES = changed_rows.CHANGED_ROWS_CHUNK_BYTES
+
+_Placement = namedtuple("_Placement", ["x", "y", "p"])
+
+
+class _PopulationVertex(object):
+    """ The regions of AbstractPopulationVertex which the mixin needs
+    """
+
+    def __init__(self, matrix_bytes):
+        self._matrix_bytes = matrix_bytes
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        spec.reserve_memory_region(
+            region=_SYNAPTIC_MATRIX, size=self._matrix_bytes)
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        pass
+
+
+class _Vertex(ChangedRowsVertex, _PopulationVertex):
+
+    def __init__(self, matrix_bytes):
+        ChangedRowsVertex.__init__(self, incremental_weight_readback=True)
+        _PopulationVertex.__init__(self, matrix_bytes)
+
+
+class _Core(object):
+    """ The changed rows bitmap of synapses.c, kept in a simulated SDRAM
+    """
+
+    def __init__(self, transceiver):
+        self._transceiver = transceiver
+        self._region = transceiver.get_region_address(
+            EXTRA_REGIONS.CHANGED_ROWS.value)
+        self._matrix = transceiver.get_region_address(_SYNAPTIC_MATRIX)
+        self._n_chunks = int(transceiver.get_words(self._region, 1)[0])
+        self._n_words = (self._n_chunks + 31) >> 5
+
+        # _changed_rows_initialise
+        transceiver.set_words(
+            self._region + 4, numpy.zeros(1 + self._n_words, "uint32"))
+
+    def update_row(self, begin, n_plastic_words, rng):
+        """ Change the weights of a row whose plastic region starts at byte\
+            begin of the matrix, and mark them as _changed_rows_end does
+        """
+        end = begin + (4 * n_plastic_words)
+        self._transceiver.write_memory(
+            0, 0, self._matrix + begin,
+            bytearray(rng.randint(0, 256, end - begin).astype("uint8")))
+
+        words = self._transceiver.get_words(self._region, 2 + self._n_words)
+        for chunk in range(begin // _CHUNK_BYTES,
+                           ((end - 1) // _CHUNK_BYTES) + 1):
+            if chunk >= self._n_chunks:
+                words[1] = 1
+                break
+            words[2 + (chunk >> 5)] |= numpy.uint32(1 << (chunk & 0x1F))
+        self._transceiver.set_words(self._region, words)
+
+
+class _CountingTransceiver(object):
+    """ Counts the bytes of the synaptic matrix read
+    """
+
+    def __init__(self, transceiver):
+        self._transceiver = transceiver
+        self.bytes_read = 0
+
+    def read_memory(self, x, y, base_address, length):
+        matrix = self._transceiver.get_region_address(_SYNAPTIC_MATRIX)
+        if matrix <= base_address < self._transceiver.get_region_address(
+                EXTRA_REGIONS.CHANGED_ROWS.value):
+            self.bytes_read += length
+        return self._transceiver.read_memory(x, y, base_address, length)
+
+    def __getattr__(self, name):
+        return getattr(self._transceiver, name)
+
+
+class TestChangedRows(unittest.TestCase):
+
+    def _load(self, matrix_bytes):
+        vertex = _Vertex(matrix_bytes)
+        spec = MemorySpec()
+        vertex._reserve_memory_regions(spec, None)
+        vertex._write_neuron_parameters(spec, None, None)
+        spec.switch_write_focus(_SYNAPTIC_MATRIX)
+        rng = numpy.random.RandomState(7)
+        spec.write_array(rng.randint(0, 1 << 31, matrix_bytes // 4))
+        transceiver = _CountingTransceiver(SimulatedTransceiver(spec))
+        return transceiver, _Core(transceiver._transceiver), rng
+
+    def _matrix(self, transceiver, address, length):
+        return transceiver._transceiver.read_memory(0, 0, address, length)
+
+    def test_region_layout(self):
+        transceiver, core, _ = self._load(4096)
+        region = transceiver.get_region_address(
+            EXTRA_REGIONS.CHANGED_ROWS.value)
+        n_words = (changed_rows.CHANGED_ROWS_N_CHUNKS + 31) // 32
+        words = transceiver.get_words(region, 2 + n_words)
+        self.assertEqual(words[0], changed_rows.CHANGED_ROWS_N_CHUNKS)
+        self.assertFalse(numpy.any(words[1:]))
+        self.assertEqual(
+            changed_rows.get_changed_rows_size_bytes(
+                changed_rows.CHANGED_ROWS_N_CHUNKS), 4 * (2 + n_words))
+
+    def test_changed_ranges(self):
+        words = numpy.zeros(2, dtype="uint32")
+        for chunk in (0, 1, 2, 5, 31, 32, 40):
+            words[chunk >> 5] |= numpy.uint32(1 << (chunk & 0x1F))
+        self.assertEqual(
+            get_changed_ranges(words, 64),
+            [(0, 3 * _CHUNK_BYTES), (5 * _CHUNK_BYTES, 6 * _CHUNK_BYTES),
+             (31 * _CHUNK_BYTES, 33 * _CHUNK_BYTES),
+             (40 * _CHUNK_BYTES, 41 * _CHUNK_BYTES)])
+        self.assertEqual(get_changed_ranges(words, 32),
+                         [(0, 3 * _CHUNK_BYTES),
+                          (5 * _CHUNK_BYTES, 6 * _CHUNK_BYTES),
+                          (31 * _CHUNK_BYTES, 32 * _CHUNK_BYTES)])
+
+    def test_only_changed_rows_are_read_again(self):
+        matrix_bytes = 16384
+        transceiver, core, rng = self._load(matrix_bytes)
+        cache = SynapticMatrixCache(_Placement(0, 0, 1))
+        matrix = transceiver.get_region_address(_SYNAPTIC_MATRIX)
+
+        # Blocks of rows, as the population table points at them
+        blocks = [(matrix, 4096), (matrix + 4096, 8192),
+                  (matrix + 12288, 4096)]
+        for address, length in blocks:
+            self.assertTrue(cache.contains(transceiver, address, length))
+            self.assertEqual(cache.read(transceiver, address, length),
+                             self._matrix(transceiver, address, length))
+        self.assertEqual(transceiver.bytes_read, matrix_bytes)
+
+        for _ in range(3):
+            transceiver.bytes_read = 0
+            rows = [(int(begin) * 4, int(n_words)) for begin, n_words in zip(
+                rng.randint(0, (matrix_bytes // 4) - 64, 5),
+                rng.randint(1, 64, 5))]
+            for begin, n_words in rows:
+                core.update_row(begin, n_words, rng)
+            for address, length in blocks:
+                self.assertEqual(cache.read(transceiver, address, length),
+                                 self._matrix(transceiver, address, length))
+
+            # Only the chunks of the changed rows were read again
+            chunks = set()
+            for begin, n_words in rows:
+                chunks.update(range(
+                    begin // _CHUNK_BYTES,
+                    ((begin + (4 * n_words) - 1) // _CHUNK_BYTES) + 1))
+            self.assertEqual(transceiver.bytes_read,
+                             len(chunks) * _CHUNK_BYTES)
+
+        # With nothing changed nothing is read
+        transceiver.bytes_read = 0
+        for address, length in blocks:
+            cache.read(transceiver, address, length)
+        self.assertEqual(transceiver.bytes_read, 0)
+
+    def test_blocks_beyond_the_bitmap_are_read_in_full(self):
+        old_n_chunks = changed_rows.CHANGED_ROWS_N_CHUNKS
+        changed_rows.CHANGED_ROWS_N_CHUNKS = 64
+        try:
+            transceiver, core, rng = self._load(8192)
+        finally:
+            changed_rows.CHANGED_ROWS_N_CHUNKS = old_n_chunks
+        cache = SynapticMatrixCache(_Placement(0, 0, 1))
+        matrix = transceiver.get_region_address(_SYNAPTIC_MATRIX)
+        blocks = [(matrix, 4096), (matrix + 4096, 4096)]
+        for address, length in blocks:
+            cache.read(transceiver, address, length)
+
+        # A row in the uncovered block overflows, so that block is read in
+        # full, while the covered block is not read at all
+        transceiver.bytes_read = 0
+        core.update_row(6000, 8, rng)
+        for address, length in blocks:
+            self.assertEqual(cache.read(transceiver, address, length),
+                             self._matrix(transceiver, address, length))
+        self.assertEqual(transceiver.bytes_read, 4096)
+
+
+if __name__ == "__main__":
+    unittest.main()
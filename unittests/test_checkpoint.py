@@ -0,0 +1,258 @@
+""" Tests that a checkpoint taken into the region written by\
+    CheckpointVertex, as synapses.c takes it, is read back, saved, loaded\
+    and restored by checkpoint.py into the region of a fresh run, from which\
+    the core restores the same state
+"""
+from collections import namedtuple
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy
+
+from spynnaker.pyNN.exceptions import ConfigurationException
+from spynnaker.pyNN.utilities import constants
+
+from spynnaker_extra_pynn_models.neuron import checkpoint
+from spynnaker_extra_pynn_models.neuron import dtcm_budget
+from spynnaker_extra_pynn_models.neuron.checkpoint import CheckpointVertex
+from spynnaker_extra_pynn_models.neuron.extra_regions import EXTRA_REGIONS
+
+from unittests.memory_spec import MemorySpec, SimulatedTransceiver
+
+_SYNAPTIC_MATRIX = constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value
+_CHECKPOINT = EXTRA_REGIONS.CHECKPOINT.value
+
+# The post_trace_t of the target rule, and the timestep
+_POST_TRACE_BYTES = 4
+_MACHINE_TIME_STEP = 1000
+
+_Slice = namedtuple("_Slice", ["lo_atom", "hi_atom", "n_atoms"])
+_Placement = namedtuple("_Placement", ["x", "y", "p"])
+
+
+class _Graph(object):
+    def incoming_edges_to_vertex(self, vertex):
+        return []
+
+
+class _PopulationVertex(object):
+    """ The parts of AbstractPopulationVertex which the mixin needs
+    """
+
+    def __init__(self, matrix_bytes):
+        self._matrix_bytes = matrix_bytes
+
+    def get_synaptic_blocks_memory_size(self, vertex_slice, in_edges):
+        return self._matrix_bytes
+
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        return self._matrix_bytes
+
+    def _reserve_memory_regions(self, spec, vertex_slice, *args, **kwargs):
+        spec.reserve_memory_region(
+            region=_SYNAPTIC_MATRIX, size=self._matrix_bytes)
+
+    def _write_neuron_parameters(
+            self, spec, key, vertex_slice, *args, **kwargs):
+        pass
+
+
+class _Vertex(CheckpointVertex, _PopulationVertex):
+
+    def __init__(self, matrix_bytes, checkpoint_time=None,
+                 restore_checkpoint=None):
+        CheckpointVertex.__init__(
+            self, checkpoint_time, restore_checkpoint, _MACHINE_TIME_STEP,
+            _POST_TRACE_BYTES)
+        _PopulationVertex.__init__(self, matrix_bytes)
+
+
+class _GraphMapper(object):
+    def __init__(self, vertex_slice):
+        self._vertex_slice = vertex_slice
+
+    def get_subvertices_from_vertex(self, vertex):
+        return ["subvertex"]
+
+    def get_subvertex_slice(self, subvertex):
+        return self._vertex_slice
+
+
+class _Population(object):
+    """ The parts of a Population which save_checkpoint reads
+    """
+
+    def __init__(self, vertex, transceiver, graph_mapper):
+        self._vertex = vertex
+        self._spinnaker = namedtuple(
+            "_Spinnaker", ["transceiver", "placements", "graph_mapper"])(
+            transceiver, _Placements(), graph_mapper)
+
+
+class _Placements(object):
+    def get_placement_of_subvertex(self, subvertex):
+        return _Placement(0, 0, 1)
+
+
+def _load(vertex, vertex_slice, matrix):
+    """ Load a vertex onto a simulated core, with a synaptic matrix
+    """
+    vertex.get_sdram_usage_for_atoms(vertex_slice, _Graph())
+    spec = MemorySpec()
+    vertex._reserve_memory_regions(spec, vertex_slice)
+    vertex._write_neuron_parameters(spec, None, vertex_slice)
+    spec.switch_write_focus(_SYNAPTIC_MATRIX)
+    spec.write_array(matrix)
+    return SimulatedTransceiver(spec)
+
+
+class _Core(object):
+    """ The checkpoint of synapses.c and synapse_dynamics_stdp_target_impl.c
+    """
+
+    def __init__(self, transceiver, n_neurons, matrix_bytes):
+        self._transceiver = transceiver
+        self._n_neurons = n_neurons
+        self._region = transceiver.get_region_address(_CHECKPOINT)
+        self._matrix = transceiver.get_region_address(_SYNAPTIC_MATRIX)
+        self._matrix_bytes = matrix_bytes
+        (self.checkpoint_time, self.restore, self.capacity_bytes,
+         self.time, self.dynamics_bytes, self.matrix_bytes) = \
+            transceiver.get_words(self._region, 6)
+
+    def _dynamics_bytes(self):
+        return 8 + (self._n_neurons *
+                    dtcm_budget.get_post_event_history_bytes(
+                        _POST_TRACE_BYTES))
+
+    def save(self, time, last_target_time, histories):
+        """ Take the checkpoint, at the start of timestep time
+        """
+        assert time == self.checkpoint_time
+        dynamics_bytes = self._dynamics_bytes()
+        assert dynamics_bytes + self._matrix_bytes <= self.capacity_bytes
+        data = self._region + 24
+        self._transceiver.set_words(
+            data, [self._n_neurons, last_target_time])
+        self._transceiver.write_memory(0, 0, data + 8, histories)
+        self._transceiver.write_memory(
+            0, 0, data + dynamics_bytes, self._transceiver.read_memory(
+                0, 0, self._matrix, self._matrix_bytes))
+        self._transceiver.set_words(
+            self._region + 12, [time, dynamics_bytes, self._matrix_bytes])
+
+    def restore_state(self):
+        """ Restore the checkpoint as the core does when it starts
+
+        :return: the time base, the last target time, the histories and\
+            the matrix
+        """
+        assert self.restore == 1
+        assert self.dynamics_bytes == self._dynamics_bytes()
+        assert self.matrix_bytes == self._matrix_bytes
+        data = self._region + 24
+        n_neurons, last_target_time = self._transceiver.get_words(data, 2)
+        assert n_neurons == self._n_neurons
+        histories = self._transceiver.read_memory(
+            0, 0, data + 8, self.dynamics_bytes - 8)
+        matrix = self._transceiver.read_memory(
+            0, 0, data + self.dynamics_bytes, self.matrix_bytes)
+        self._transceiver.write_memory(0, 0, self._matrix, matrix)
+        return self.time, last_target_time, histories, matrix
+
+
+class TestCheckpoint(unittest.TestCase):
+
+    def setUp(self):
+        self._directory = tempfile.mkdtemp()
+        self._n_neurons = 10
+        self._slice = _Slice(0, self._n_neurons - 1, self._n_neurons)
+        rng = numpy.random.RandomState(3)
+        self._matrix = rng.randint(0, 1 << 31, 300)
+        self._histories = bytearray(rng.randint(0, 256, self._n_neurons * (
+            dtcm_budget.get_post_event_history_bytes(_POST_TRACE_BYTES)))
+            .astype("uint8"))
+
+    def tearDown(self):
+        shutil.rmtree(self._directory)
+
+    def _take_checkpoint(self, checkpoint_time_ms, time):
+        vertex = _Vertex(len(self._matrix) * 4, checkpoint_time_ms)
+        transceiver = _load(vertex, self._slice, self._matrix)
+        core = _Core(transceiver, self._n_neurons, len(self._matrix) * 4)
+        self.assertEqual(core.checkpoint_time, time)
+        self.assertEqual(core.restore, 0)
+
+        # Not read back until it is complete
+        self.assertIsNone(checkpoint.read_checkpoint(
+            transceiver, _Placement(0, 0, 1)))
+        core.save(time, time - 5, self._histories)
+        return vertex, transceiver
+
+    def test_round_trip(self):
+        vertex, transceiver = self._take_checkpoint(250.0, 250)
+        checkpoints = vertex.get_checkpoints(
+            transceiver, _Placements(), _GraphMapper(self._slice))
+        self.assertEqual(list(checkpoints.keys()), [(0, 9)])
+        self.assertEqual(checkpoint.get_checkpoint_time(
+            checkpoints[(0, 9)], _MACHINE_TIME_STEP), 250.0)
+
+        # Save to a file, and restore from it into a fresh run
+        filename = os.path.join(self._directory, "checkpoint")
+        checkpoint.save_checkpoint(
+            _Population(vertex, transceiver, _GraphMapper(self._slice)),
+            filename)
+
+        # The fresh run is loaded with the matrix the projections give
+        restored = _Vertex(len(self._matrix) * 4, restore_checkpoint=filename)
+        restored_transceiver = _load(
+            restored, self._slice, numpy.zeros(len(self._matrix)))
+        core = _Core(
+            restored_transceiver, self._n_neurons, len(self._matrix) * 4)
+        self.assertEqual(core.checkpoint_time, checkpoint.CHECKPOINT_NEVER)
+        time_base, last_target_time, histories, matrix = \
+            core.restore_state()
+        self.assertEqual(time_base, 250)
+        self.assertEqual(last_target_time, 245)
+        self.assertEqual(histories, self._histories)
+        self.assertTrue(numpy.array_equal(
+            numpy.asarray(matrix, dtype="uint8").view("<u4"), self._matrix))
+
+    def test_checkpoint_again_after_restore(self):
+        vertex, transceiver = self._take_checkpoint(100.0, 100)
+        checkpoints = vertex.get_checkpoints(
+            transceiver, _Placements(), _GraphMapper(self._slice))
+
+        # A restored run taking a checkpoint of its own
+        restored = _Vertex(len(self._matrix) * 4, 50.0, checkpoints)
+        restored_transceiver = _load(
+            restored, self._slice, numpy.zeros(len(self._matrix)))
+        core = _Core(
+            restored_transceiver, self._n_neurons, len(self._matrix) * 4)
+        self.assertEqual(core.checkpoint_time, 50)
+        self.assertEqual(core.restore_state()[0], 100)
+
+    def test_restore_needs_the_same_partitioning(self):
+        vertex, transceiver = self._take_checkpoint(100.0, 100)
+        checkpoints = vertex.get_checkpoints(
+            transceiver, _Placements(), _GraphMapper(self._slice))
+        restored = _Vertex(len(self._matrix) * 4, None, checkpoints)
+        with self.assertRaises(ConfigurationException):
+            restored.get_sdram_usage_for_atoms(
+                _Slice(0, 4, 5), _Graph())
+
+    def test_header_layout(self):
+        vertex = _Vertex(len(self._matrix) * 4, 1.0)
+        transceiver = _load(vertex, self._slice, self._matrix)
+        region = transceiver.get_region_address(_CHECKPOINT)
+        size = checkpoint.get_checkpoint_size_bytes(
+            self._n_neurons, _POST_TRACE_BYTES, len(self._matrix) * 4)
+        self.assertEqual(
+            list(transceiver.get_words(region, 6)),
+            [1, 0, size - 24, 0, 0, 0])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,129 @@
+""" Tests that the numpy plasticity LUTs match those which were built and\
+    written an entry at a time, and times both; run as a script to print\
+    the timings
+"""
+import math
+import timeit
+import unittest
+
+from data_specification.enums.data_type import DataType
+
+from spynnaker.pyNN.models.neural_properties.synapse_dynamics\
+    import plasticity_helpers
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics\
+    import plasticity_lut_helpers
+
+from unittests.memory_spec import MemorySpec
+
+# Time constant (ms), timestep (us), size and time shift of exponential LUTs
+# of the rules
+_EXP_LUTS = [(20.0, 1000, 256, 0), (5.0, 1000, 256, 0),
+             (100.0, 1000, 256, 2), (20.0, 100, 256, 3)]
+
+# Mean timesteps of the exponential distribution LUTs of the recurrent rule
+_EXP_DIST_MEANS = [20.0, 45.5, 100.0]
+
+
+def _round(value):
+    """ round as Python 2 rounds, halves away from zero
+    """
+    return math.copysign(math.floor(abs(value) + 0.5), value)
+
+
+def _write_exp_lut_per_entry(spec, time_constant, machine_time_step, size,
+                             shift):
+    """ The exponential LUT as it was built before numpy
+    """
+    tau_timesteps = float(time_constant) * (1000.0 / float(machine_time_step))
+    for i in range(size):
+        value = int(_round(math.exp(-float(i << shift) / tau_timesteps) *
+                           plasticity_helpers.STDP_FIXED_POINT_ONE))
+        spec.write_value(data=value, data_type=DataType.INT16)
+
+
+def _write_exp_dist_lut_per_entry(spec, mean):
+    """ The exponential distribution LUT as it was built before numpy
+    """
+    for x in range(plasticity_helpers.STDP_FIXED_POINT_ONE):
+        x_float = float(x) / float(plasticity_helpers.STDP_FIXED_POINT_ONE)
+        p_float = math.log(1.0 - x_float) * -mean
+        spec.write_value(data=_round(p_float), data_type=DataType.UINT16)
+
+
+def _write_exp_dist_lut(spec, mean):
+    plasticity_lut_helpers.write_lut(
+        spec, plasticity_lut_helpers.get_exp_dist_lut(
+            mean, plasticity_helpers.STDP_FIXED_POINT_ONE),
+        DataType.UINT16)
+
+
+def _write(write, *args):
+    spec = MemorySpec()
+    spec.reserve_memory_region(0, 1 << 16)
+    spec.switch_write_focus(0)
+    write(spec, *args)
+    return spec.get_region_data(0)
+
+
+def _time(write, args_list, uncached):
+    """ The best time of writing each LUT of args_list, in seconds
+    """
+    def run():
+        if uncached:
+            plasticity_lut_helpers._lut_cache.clear()
+        for args in args_list:
+            _write(write, *args)
+    return min(timeit.repeat(run, number=10, repeat=5)) / 10.0
+
+
+def get_timings():
+    """ Get the time to write the LUTs the old way, the numpy way with an\
+        empty cache, as for the first vertex of a rule, and the numpy way\
+        from the cache, as for later vertices
+
+    :return: a dict of (old, numpy, cached) times in seconds, by LUT kind
+    """
+    exp_dist_args = [(mean,) for mean in _EXP_DIST_MEANS]
+    return {
+        "exp": (
+            _time(_write_exp_lut_per_entry, _EXP_LUTS, False),
+            _time(plasticity_lut_helpers.write_exp_lut, _EXP_LUTS, True),
+            _time(plasticity_lut_helpers.write_exp_lut, _EXP_LUTS, False)),
+        "exp_dist": (
+            _time(_write_exp_dist_lut_per_entry, exp_dist_args, False),
+            _time(_write_exp_dist_lut, exp_dist_args, True),
+            _time(_write_exp_dist_lut, exp_dist_args, False))}
+
+
+class TestPlasticityLuts(unittest.TestCase):
+
+    def test_exp_luts_unchanged(self):
+        for args in _EXP_LUTS:
+            self.assertEqual(
+                _write(plasticity_lut_helpers.write_exp_lut, *args),
+                _write(_write_exp_lut_per_entry, *args))
+
+    def test_exp_dist_luts_unchanged(self):
+        for mean in _EXP_DIST_MEANS:
+            self.assertEqual(
+                _write(_write_exp_dist_lut, mean),
+                _write(_write_exp_dist_lut_per_entry, mean))
+
+    def test_cached_luts_are_read_only(self):
+        lut = plasticity_lut_helpers.get_exp_lut(*_EXP_LUTS[0])
+        self.assertIs(lut, plasticity_lut_helpers.get_exp_lut(*_EXP_LUTS[0]))
+        with self.assertRaises(ValueError):
+            lut[0] = 0
+
+    def test_numpy_luts_are_faster(self):
+        for old, uncached, cached in get_timings().values():
+            self.assertLess(uncached, old)
+            self.assertLess(cached, old)
+
+
+if __name__ == "__main__":
+    for kind, (old, uncached, cached) in sorted(get_timings().items()):
+        print("{}: per entry {:.1f} us, numpy {:.1f} us ({:.1f}x),"
+              " cached {:.1f} us ({:.1f}x)".format(
+                  kind, old * 1e6, uncached * 1e6, old / uncached,
+                  cached * 1e6, old / cached))
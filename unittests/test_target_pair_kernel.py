@@ -0,0 +1,150 @@
+""" Tests that the combined PSP kernel LUT of the target pair rule gives the\
+    same PSPs, and so the same weights, as the tau_plus and tau_minus LUTs
+"""
+import unittest
+
+import numpy
+
+from spynnaker_extra_pynn_models.neural_properties.synapse_dynamics.\
+    dependences.target_pair_time_dependency import TargetPairRule
+
+from unittests.memory_spec import MemorySpec
+
+_LUT_SIZE = 256
+
+
+def _write_plastic_params(rule, machine_time_step):
+    spec = MemorySpec()
+    spec.reserve_memory_region(0, rule.get_params_size_bytes())
+    spec.switch_write_focus(0)
+    rule.write_plastic_params(spec, machine_time_step, [1.0], 1.0)
+    data = spec.get_region_data(0)
+    assert len(data) == rule.get_params_size_bytes()
+    return numpy.asarray(data, dtype="uint8").view("<u4")
+
+
+def _lut_decay(times, shift, lut):
+    """ maths_lut_exponential_decay, for an array of times
+    """
+    indices = times >> shift
+    in_lut = indices < len(lut)
+    return numpy.where(in_lut, lut[numpy.minimum(indices, len(lut) - 1)], 0)
+
+
+def _psps(words, combined_kernel, times):
+    """ The PSP the core looks up at each time since the last pre-synaptic\
+        spike, from the words read by timing_initialise after the\
+        consolidation word
+    """
+    words = words[1:]
+    if combined_kernel:
+        kernel = words[1:].view("<i2").astype("int32")
+        return _lut_decay(times, words[0], kernel)
+    luts = words[2:].view("<i2").astype("int32")
+    return (_lut_decay(times, words[0], luts[:_LUT_SIZE]) -
+            _lut_decay(times, words[1], luts[_LUT_SIZE:]))
+
+
+def _accumulate(psps, is_output):
+    """ The accumulator of timing_apply_post_spike after a train of target\
+        and output events, from which the weight is updated
+    """
+    return int(numpy.sum(numpy.where(is_output, -psps, psps)))
+
+
+class TestTargetPairKernel(unittest.TestCase):
+
+    # Time constants, in ms, and timesteps, in us, for which both formats
+    # choose the same LUT time shift for every table
+    PARAMETERS = [
+        (20.0, 5.0, 1000), (10.0, 2.0, 1000), (30.0, 10.0, 1000),
+        (5.0, 20.0, 1000), (50.0, 40.0, 1000), (60.0, 31.0, 1000),
+        (20.0, 5.0, 2000)]
+
+    def _check(self, tau_plus, tau_minus, machine_time_step):
+        two_tables = _write_plastic_params(
+            TargetPairRule(tau_plus, tau_minus, combined_kernel=False),
+            machine_time_step)
+        kernel = _write_plastic_params(
+            TargetPairRule(tau_plus, tau_minus, combined_kernel=True),
+            machine_time_step)
+        self.assertEqual(two_tables[1], two_tables[2])
+        self.assertEqual(kernel[1], two_tables[1])
+
+        # Every time difference up to beyond the end of the LUTs
+        times = numpy.arange(
+            1, (_LUT_SIZE + 8) << int(kernel[1]), dtype="uint32")
+        kernel_psps = _psps(kernel, True, times)
+        two_table_psps = _psps(two_tables, False, times)
+        self.assertTrue(numpy.array_equal(kernel_psps, two_table_psps))
+
+        # Random trains of events give the same weight change
+        rng = numpy.random.RandomState(42)
+        for _ in range(10):
+            event_times = rng.choice(times, 50)
+            is_output = rng.randint(0, 2, 50).astype("bool")
+            self.assertEqual(
+                _accumulate(_psps(kernel, True, event_times), is_output),
+                _accumulate(_psps(two_tables, False, event_times),
+                            is_output))
+
+    def test_kernel_matches_two_tables(self):
+        for tau_plus, tau_minus, machine_time_step in self.PARAMETERS:
+            self._check(tau_plus, tau_minus, machine_time_step)
+
+    def test_kernel_with_unequal_shifts(self):
+
+        # Time constants for which tau_plus and tau_minus get different LUT
+        # time shifts, and the kernel the shift of the slower of the two
+        for tau_plus, tau_minus, machine_time_step in [
+                (40.0, 5.0, 1000), (5.0, 60.0, 1000), (100.0, 3.0, 1000),
+                (80.0, 10.0, 500)]:
+            two_tables = _write_plastic_params(
+                TargetPairRule(tau_plus, tau_minus, combined_kernel=False),
+                machine_time_step)
+            kernel = _write_plastic_params(
+                TargetPairRule(tau_plus, tau_minus, combined_kernel=True),
+                machine_time_step)
+            tau_plus_shift, tau_minus_shift = two_tables[1], two_tables[2]
+            self.assertNotEqual(tau_plus_shift, tau_minus_shift)
+            kernel_shift = int(kernel[1])
+            self.assertEqual(
+                kernel_shift, max(tau_plus_shift, tau_minus_shift))
+
+            # Each kernel entry is the difference of the separate tables,
+            # each looked up with its own shift, at the time of the entry,
+            # across the whole window of the kernel
+            entries = kernel[2:].view("<i2").astype("int32")
+            self.assertEqual(len(entries), _LUT_SIZE)
+            times = numpy.arange(_LUT_SIZE, dtype="uint32") << kernel_shift
+            self.assertTrue(numpy.array_equal(
+                entries, _psps(two_tables, False, times)))
+
+            # Between the entries the kernel holds the value of the entry
+            # before, and it is zero beyond its window as the tables are
+            times = numpy.arange(
+                1, (_LUT_SIZE + 8) << kernel_shift, dtype="uint32")
+            self.assertTrue(numpy.array_equal(
+                _psps(kernel, True, times),
+                _psps(two_tables, False,
+                      (times >> kernel_shift) << kernel_shift)))
+
+    def test_default_is_two_tables(self):
+        rule = TargetPairRule()
+        self.assertFalse(rule.combined_kernel)
+        self.assertEqual(rule.vertex_executable_suffix, "pair")
+        self.assertEqual(
+            TargetPairRule(combined_kernel=True).vertex_executable_suffix,
+            "pair_kernel")
+
+    def test_kernel_is_smaller(self):
+        self.assertEqual(
+            TargetPairRule(combined_kernel=True).get_params_size_bytes(),
+            (4 * 2) + (2 * _LUT_SIZE))
+        self.assertEqual(
+            TargetPairRule().get_params_size_bytes(),
+            (4 * 3) + (2 * 2 * _LUT_SIZE))
+
+
+if __name__ == "__main__":
+    unittest.main()